@@ -62,9 +62,12 @@ export const BUILTIN_OBJECTS = new Set([
     { name: "setInterval", isConst: false },
     { name: "clearInterval", isConst: false },
     { name: "Array", isConst: false },
+    { name: "Map", isConst: false },
+    { name: "Set", isConst: false },
     { name: "Object", isConst: false },
     { name: "Boolean", isConst: false },
     { name: "Math", isConst: false },
+    { name: "JSON", isConst: false },
 ]);
 
 // Represents a single scope (e.g., a function body or a block statement)
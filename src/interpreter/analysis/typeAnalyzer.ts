@@ -65,6 +65,8 @@ export interface TypeInfo {
     isConst?: boolean;
     isBuiltin?: boolean;
     needsHeapAllocation?: boolean;
+    isNumeric?: boolean; // Proven to only ever hold numbers; emitted as a native `double`
+    isReassigned?: boolean; // Binding is written to after its declaration
     captures?: Map<string, TypeInfo>; // <name, typeInfo>
     structName?: string;
     properties?: Map<string, string>;
@@ -737,7 +739,7 @@ export class TypeAnalyzer {
                 // Builtin check
                 if (typeInfo.isBuiltin) {
                     if (
-                        ["console", "Math", "process", "global", "globalThis"]
+                        ["console", "Math", "JSON", "process", "global", "globalThis"]
                             .includes(node.text)
                     ) return "object";
                 }
@@ -788,6 +790,546 @@ export class TypeAnalyzer {
         return "any";
     }
 
+    /**
+     * Checks if an identifier reference writes to its binding, either
+     * directly (`x = 1`, `x += 1`, `x++`) or as a destructuring or
+     * `for...in`/`for...of` target.
+     */
+    private isWriteReference(node: ts.Identifier): boolean {
+        let current: ts.Node = node;
+        while (
+            ts.isParenthesizedExpression(current.parent) ||
+            ts.isNonNullExpression(current.parent) ||
+            ts.isAsExpression(current.parent) ||
+            ts.isSatisfiesExpression(current.parent) ||
+            ts.isTypeAssertionExpression(current.parent)
+        ) {
+            current = current.parent;
+        }
+        const parent = current.parent;
+        if (
+            (ts.isPrefixUnaryExpression(parent) ||
+                ts.isPostfixUnaryExpression(parent)) &&
+            (parent.operator === ts.SyntaxKind.PlusPlusToken ||
+                parent.operator === ts.SyntaxKind.MinusMinusToken)
+        ) {
+            return true;
+        }
+        // Climb out of destructuring patterns
+        for (;;) {
+            const p: ts.Node = current.parent;
+            if (
+                ts.isArrayLiteralExpression(p) ||
+                ts.isObjectLiteralExpression(p) ||
+                ts.isSpreadElement(p) ||
+                ts.isSpreadAssignment(p) ||
+                (ts.isShorthandPropertyAssignment(p) && p.name === current) ||
+                (ts.isPropertyAssignment(p) && p.initializer === current)
+            ) {
+                current = p;
+                continue;
+            }
+            break;
+        }
+        const target = current.parent;
+        if (
+            ts.isBinaryExpression(target) && target.left === current &&
+            target.operatorToken.kind >= ts.SyntaxKind.FirstAssignment &&
+            target.operatorToken.kind <= ts.SyntaxKind.LastAssignment
+        ) {
+            return true;
+        }
+        return (ts.isForInStatement(target) || ts.isForOfStatement(target)) &&
+            target.initializer === current;
+    }
+
+    /**
+     * Resolves identifier references against the final scope tree.
+     *
+     * Records every direct call to a function-like declaration in `callSites`
+     * (including calls that appear before the declaration, which the main
+     * traversal cannot resolve yet) and flags bindings that are written to
+     * after their declaration with `isReassigned`. Codegen only binds calls
+     * directly to a native lambda when the callee is never reassigned.
+     */
+    private resolveReferences(ast: Node) {
+        const visit = (node: ts.Node) => {
+            if (
+                ts.isIdentifier(node) &&
+                !(ts.isPropertyAccessExpression(node.parent) &&
+                    node.parent.name === node)
+            ) {
+                const typeInfo = this.scopeManager.lookupFromScope(
+                    node.text,
+                    this.resolveScope(node),
+                );
+                const decl = typeInfo?.declaration;
+                if (typeInfo && decl && !typeInfo.isBuiltin) {
+                    const parent = node.parent;
+                    if (
+                        ts.isCallExpression(parent) &&
+                        parent.expression === node &&
+                        ts.isFunctionLike(decl)
+                    ) {
+                        const sites = this.callSites.get(
+                            decl as ts.Declaration,
+                        );
+                        if (sites) sites.push(parent);
+                        else this.callSites.set(decl as ts.Declaration, [parent]);
+                    } else if (this.isWriteReference(node)) {
+                        typeInfo.isReassigned = true;
+                    }
+                }
+            }
+            ts.forEachChild(node, visit);
+        };
+        visit(ast);
+    }
+
+    /**
+     * Checks if an expression is guaranteed to evaluate to a number.
+     *
+     * Unlike `inferNodeReturnType`, this never guesses: it only returns true
+     * when every possible evaluation yields a number. Identifiers are numbers
+     * when their binding was proven numeric by `inferNumericBindings` (or is
+     * in the candidate set while that pass is still running).
+     */
+    public isNumericExpression(
+        node: ts.Expression,
+        candidates?: Map<TypeInfo, unknown>,
+    ): boolean {
+        if (
+            ts.isParenthesizedExpression(node) || ts.isAsExpression(node) ||
+            ts.isNonNullExpression(node) || ts.isSatisfiesExpression(node) ||
+            ts.isTypeAssertionExpression(node)
+        ) {
+            return this.isNumericExpression(node.expression, candidates);
+        }
+        if (ts.isNumericLiteral(node)) return true;
+        if (ts.isIdentifier(node)) {
+            const typeInfo = this.scopeManager.lookupFromScope(
+                node.text,
+                this.resolveScope(node),
+            );
+            if (!typeInfo) return false;
+            return candidates
+                ? candidates.has(typeInfo)
+                : !!typeInfo.isNumeric;
+        }
+        if (ts.isPrefixUnaryExpression(node)) {
+            return node.operator !== ts.SyntaxKind.ExclamationToken;
+        }
+        if (ts.isPostfixUnaryExpression(node)) return true;
+        if (ts.isBinaryExpression(node)) {
+            switch (node.operatorToken.kind) {
+                case ts.SyntaxKind.MinusToken:
+                case ts.SyntaxKind.AsteriskToken:
+                case ts.SyntaxKind.SlashToken:
+                case ts.SyntaxKind.PercentToken:
+                case ts.SyntaxKind.AsteriskAsteriskToken:
+                case ts.SyntaxKind.LessThanLessThanToken:
+                case ts.SyntaxKind.GreaterThanGreaterThanToken:
+                case ts.SyntaxKind.GreaterThanGreaterThanGreaterThanToken:
+                case ts.SyntaxKind.AmpersandToken:
+                case ts.SyntaxKind.BarToken:
+                case ts.SyntaxKind.CaretToken:
+                    return true;
+                case ts.SyntaxKind.PlusToken:
+                    return this.isNumericExpression(node.left, candidates) &&
+                        this.isNumericExpression(node.right, candidates);
+                case ts.SyntaxKind.EqualsToken:
+                    return this.isNumericExpression(node.right, candidates);
+            }
+            return false;
+        }
+        if (ts.isConditionalExpression(node)) {
+            return this.isNumericExpression(node.whenTrue, candidates) &&
+                this.isNumericExpression(node.whenFalse, candidates);
+        }
+        if (
+            ts.isCallExpression(node) &&
+            ts.isPropertyAccessExpression(node.expression) &&
+            ts.isIdentifier(node.expression.expression) &&
+            node.expression.expression.text === "Math"
+        ) {
+            const typeInfo = this.scopeManager.lookupFromScope(
+                "Math",
+                this.resolveScope(node),
+            );
+            return !!typeInfo?.isBuiltin;
+        }
+        return false;
+    }
+
+    /**
+     * Proves which `let`/`const` variables and function parameters only ever
+     * hold numbers, and marks them with `isNumeric` so the code generator can
+     * keep them in native `double`s.
+     *
+     * A binding qualifies when it is not captured, every value written to it
+     * is numeric and every read happens in a position where a native double
+     * is accepted (operators, call arguments, conditions, ...). Parameters
+     * additionally require a function declaration that is only ever called
+     * directly, with a numeric argument in that position at every call site.
+     * The proof is an optimistic fixpoint so loops like `i = i + 1` resolve.
+     */
+    private inferNumericBindings(ast: Node) {
+        type Candidate = {
+            requirements: ts.Expression[];
+            func?: ts.FunctionDeclaration;
+            paramIndex?: number;
+        };
+        const candidates = new Map<TypeInfo, Candidate>();
+        const disqualified = new Set<TypeInfo>();
+        const functionCalls = new Map<TypeInfo, ts.CallExpression[]>();
+        const sourceText = ast.getSourceFile().text;
+
+        const lookup = (node: ts.Identifier) =>
+            this.scopeManager.lookupFromScope(
+                node.text,
+                this.resolveScope(node),
+            );
+
+        const unwrap = (node: ts.Node): ts.Node => {
+            let current = node;
+            while (
+                current.parent &&
+                (ts.isParenthesizedExpression(current.parent) ||
+                    ts.isAsExpression(current.parent) ||
+                    ts.isNonNullExpression(current.parent) ||
+                    ts.isSatisfiesExpression(current.parent) ||
+                    ts.isTypeAssertionExpression(current.parent))
+            ) {
+                current = current.parent;
+            }
+            return current;
+        };
+
+        // Array/object literals on the left of `=` or in a for-in/of head are
+        // destructuring targets, not reads.
+        const isAssignmentPattern = (node: ts.Node): boolean => {
+            let current = node;
+            while (
+                current.parent &&
+                (ts.isArrayLiteralExpression(current.parent) ||
+                    ts.isObjectLiteralExpression(current.parent) ||
+                    ts.isPropertyAssignment(current.parent) ||
+                    ts.isShorthandPropertyAssignment(current.parent) ||
+                    ts.isSpreadElement(current.parent) ||
+                    ts.isSpreadAssignment(current.parent))
+            ) {
+                current = current.parent;
+            }
+            const parent = current.parent;
+            if (!parent || current === node) return false;
+            return (ts.isBinaryExpression(parent) &&
+                parent.operatorToken.kind === ts.SyntaxKind.EqualsToken &&
+                parent.left === current) ||
+                ((ts.isForOfStatement(parent) || ts.isForInStatement(parent)) &&
+                    parent.initializer === current);
+        };
+
+        const isNameSlot = (node: ts.Identifier): boolean => {
+            const parent = node.parent;
+            return ((ts.isPropertyAccessExpression(parent) ||
+                ts.isPropertyAssignment(parent) ||
+                ts.isMethodDeclaration(parent) ||
+                ts.isPropertyDeclaration(parent) ||
+                ts.isGetAccessor(parent) ||
+                ts.isSetAccessor(parent) ||
+                ts.isEnumMember(parent) ||
+                ts.isPropertySignature(parent) ||
+                ts.isMethodSignature(parent) ||
+                ts.isVariableDeclaration(parent) ||
+                ts.isParameter(parent) ||
+                ts.isFunctionDeclaration(parent) ||
+                ts.isFunctionExpression(parent) ||
+                ts.isClassDeclaration(parent) ||
+                ts.isClassExpression(parent)) &&
+                parent.name === node) ||
+                (ts.isBindingElement(parent) &&
+                    parent.propertyName === node) ||
+                ((ts.isLabeledStatement(parent) ||
+                    ts.isBreakStatement(parent) ||
+                    ts.isContinueStatement(parent)) &&
+                    parent.label === node) ||
+                ts.isTypeReferenceNode(parent) ||
+                ts.isQualifiedName(parent);
+        };
+
+        // Positions where a native double converts implicitly or is accepted
+        // by an overload.
+        const isNativeReadContext = (node: ts.Identifier): boolean => {
+            const outer = unwrap(node);
+            const parent = outer.parent;
+            if (!parent) return false;
+            if (ts.isBinaryExpression(parent)) {
+                const kind = parent.operatorToken.kind;
+                if (
+                    kind === ts.SyntaxKind.InKeyword ||
+                    kind === ts.SyntaxKind.InstanceOfKeyword ||
+                    kind === ts.SyntaxKind.CommaToken
+                ) return false;
+                if (
+                    kind >= ts.SyntaxKind.FirstAssignment &&
+                    kind <= ts.SyntaxKind.LastAssignment
+                ) {
+                    return parent.right === outer;
+                }
+                return true;
+            }
+            if (
+                ts.isPrefixUnaryExpression(parent) ||
+                ts.isPostfixUnaryExpression(parent)
+            ) {
+                return outer === node;
+            }
+            if (ts.isCallExpression(parent) || ts.isNewExpression(parent)) {
+                return !!parent.arguments?.includes(outer as ts.Expression);
+            }
+            if (ts.isArrayLiteralExpression(parent)) {
+                return !isAssignmentPattern(outer);
+            }
+            if (ts.isPropertyAssignment(parent)) {
+                return parent.initializer === outer &&
+                    !isAssignmentPattern(outer);
+            }
+            if (ts.isShorthandPropertyAssignment(parent)) {
+                return !isAssignmentPattern(outer);
+            }
+            if (ts.isVariableDeclaration(parent)) {
+                return parent.initializer === outer;
+            }
+            if (ts.isElementAccessExpression(parent)) {
+                return parent.argumentExpression === outer;
+            }
+            if (ts.isConditionalExpression(parent)) {
+                return parent.condition === outer;
+            }
+            if (ts.isForStatement(parent)) {
+                return parent.condition === outer;
+            }
+            return ts.isReturnStatement(parent) ||
+                ts.isTemplateSpan(parent) ||
+                ts.isIfStatement(parent) ||
+                ts.isWhileStatement(parent) ||
+                ts.isDoStatement(parent) ||
+                ts.isSwitchStatement(parent) ||
+                ts.isCaseClause(parent) ||
+                ts.isExpressionStatement(parent) ||
+                ts.isTypeOfExpression(parent) ||
+                ts.isVoidExpression(parent);
+        };
+
+        const addVariableCandidate = (decl: ts.VariableDeclaration) => {
+            if (!ts.isIdentifier(decl.name) || !decl.initializer) return;
+            const list = decl.parent;
+            if (
+                !ts.isVariableDeclarationList(list) ||
+                (list.flags & (ts.NodeFlags.Let | ts.NodeFlags.Const)) === 0
+            ) return;
+            const holder = list.parent;
+            if (ts.isForOfStatement(holder) || ts.isForInStatement(holder)) {
+                return;
+            }
+            if (ts.isForStatement(holder) && list.declarations[0] !== decl) {
+                return;
+            }
+            if (
+                ts.isVariableStatement(holder) &&
+                (shouldIgnoreStatement(holder) ||
+                    holder.modifiers?.some((m) =>
+                        m.kind === ts.SyntaxKind.ExportKeyword
+                    ))
+            ) return;
+            const typeInfo = lookup(decl.name);
+            if (
+                !typeInfo || typeInfo.declaration !== decl ||
+                typeInfo.needsHeapAllocation || typeInfo.isBuiltin
+            ) return;
+            candidates.set(typeInfo, { requirements: [decl.initializer] });
+        };
+
+        const addParameterCandidates = (func: ts.FunctionDeclaration) => {
+            if (!func.name || !func.body) return;
+            if (func.asteriskToken) return;
+            if (
+                (ts.getCombinedModifierFlags(func) & ts.ModifierFlags.Async) !==
+                    0
+            ) return;
+            if (
+                func.parameters.some((p) =>
+                    !ts.isIdentifier(p.name) || p.name.text === "this" ||
+                    !!p.initializer || !!p.dotDotDotToken
+                )
+            ) return;
+            const comments = ts.getLeadingCommentRanges(sourceText, func.pos);
+            if (
+                comments?.some((range) =>
+                    sourceText.substring(range.pos, range.end).includes(
+                        "@export",
+                    )
+                )
+            ) return;
+            let usesArguments = false;
+            const findArguments = (n: ts.Node) => {
+                if (usesArguments) return;
+                if (ts.isIdentifier(n) && n.text === "arguments") {
+                    usesArguments = true;
+                    return;
+                }
+                ts.forEachChild(n, findArguments);
+            };
+            findArguments(func.body);
+            if (usesArguments) return;
+
+            const funcScope = this.nodeToScope.get(func);
+            if (!funcScope) return;
+            func.parameters.forEach((p, i) => {
+                const typeInfo = this.scopeManager.lookupFromScope(
+                    (p.name as ts.Identifier).text,
+                    funcScope,
+                );
+                if (
+                    !typeInfo || typeInfo.declaration !== p ||
+                    typeInfo.needsHeapAllocation
+                ) return;
+                candidates.set(typeInfo, {
+                    requirements: [],
+                    func,
+                    paramIndex: i,
+                });
+            });
+        };
+
+        // 1. Collect candidate bindings
+        const collect = (node: ts.Node) => {
+            if (ts.isVariableDeclaration(node)) addVariableCandidate(node);
+            if (ts.isFunctionDeclaration(node)) addParameterCandidates(node);
+            ts.forEachChild(node, collect);
+        };
+        collect(ast);
+
+        // 2. Classify every reference as a numeric write, a native read or
+        //    something that requires a boxed value
+        const classify = (node: ts.Node) => {
+            if (ts.isIdentifier(node) && !isNameSlot(node)) {
+                const typeInfo = lookup(node);
+                if (typeInfo && candidates.has(typeInfo)) {
+                    const parent = node.parent;
+                    const declaration = typeInfo.declaration;
+                    if (
+                        declaration && ts.isVariableDeclaration(declaration) &&
+                        (node.pos < declaration.end ||
+                            ts.isCaseClause(declaration.parent.parent.parent) ||
+                            ts.isDefaultClause(declaration.parent.parent.parent))
+                    ) {
+                        // Reads inside the TDZ must keep their runtime check
+                        disqualified.add(typeInfo);
+                    } else if (
+                        ts.isBinaryExpression(parent) && parent.left === node &&
+                        parent.operatorToken.kind >=
+                            ts.SyntaxKind.FirstAssignment &&
+                        parent.operatorToken.kind <=
+                            ts.SyntaxKind.LastAssignment
+                    ) {
+                        const kind = parent.operatorToken.kind;
+                        if (
+                            kind === ts.SyntaxKind.AmpersandAmpersandEqualsToken ||
+                            kind === ts.SyntaxKind.BarBarEqualsToken ||
+                            kind === ts.SyntaxKind.QuestionQuestionEqualsToken ||
+                            typeInfo.isConst
+                        ) {
+                            disqualified.add(typeInfo);
+                        } else if (
+                            kind === ts.SyntaxKind.EqualsToken ||
+                            kind === ts.SyntaxKind.PlusEqualsToken
+                        ) {
+                            candidates.get(typeInfo)!.requirements.push(
+                                parent.right,
+                            );
+                        }
+                    } else if (
+                        (ts.isPrefixUnaryExpression(parent) ||
+                            ts.isPostfixUnaryExpression(parent)) &&
+                        (parent.operator === ts.SyntaxKind.PlusPlusToken ||
+                            parent.operator === ts.SyntaxKind.MinusMinusToken)
+                    ) {
+                        // Updates keep the value numeric
+                        if (typeInfo.isConst) disqualified.add(typeInfo);
+                    } else if (!isNativeReadContext(node)) {
+                        disqualified.add(typeInfo);
+                    }
+                } else if (
+                    typeInfo?.declaration &&
+                    ts.isFunctionDeclaration(typeInfo.declaration) &&
+                    typeInfo.declaration.name !== node
+                ) {
+                    // Parameters are only provable while every use of the
+                    // function is a plain direct call.
+                    const parent = node.parent;
+                    if (!functionCalls.has(typeInfo)) {
+                        functionCalls.set(typeInfo, []);
+                    }
+                    if (
+                        ts.isCallExpression(parent) &&
+                        parent.expression === node && !parent.questionDotToken
+                    ) {
+                        functionCalls.get(typeInfo)!.push(parent);
+                    } else {
+                        disqualified.add(typeInfo);
+                    }
+                }
+            }
+            ts.forEachChild(node, classify);
+        };
+        classify(ast);
+
+        for (const [typeInfo, candidate] of candidates) {
+            if (disqualified.has(typeInfo)) {
+                candidates.delete(typeInfo);
+                continue;
+            }
+            if (!candidate.func) continue;
+            const funcInfo = this.functionTypeInfo.get(candidate.func);
+            const calls = funcInfo ? functionCalls.get(funcInfo) : undefined;
+            if (
+                !funcInfo || disqualified.has(funcInfo) || !calls ||
+                calls.length === 0 ||
+                calls.some((call) =>
+                    call.arguments.length <= candidate.paramIndex! ||
+                    call.arguments.some((arg) => ts.isSpreadElement(arg))
+                )
+            ) {
+                candidates.delete(typeInfo);
+                continue;
+            }
+            candidate.requirements.push(
+                ...calls.map((call) => call.arguments[candidate.paramIndex!]!),
+            );
+        }
+
+        // 3. Drop candidates with a possibly non-numeric write until stable
+        let changed = true;
+        while (changed) {
+            changed = false;
+            for (const [typeInfo, candidate] of candidates) {
+                if (
+                    !candidate.requirements.every((expr) =>
+                        this.isNumericExpression(expr, candidates)
+                    )
+                ) {
+                    candidates.delete(typeInfo);
+                    changed = true;
+                }
+            }
+        }
+
+        for (const typeInfo of candidates.keys()) {
+            typeInfo.isNumeric = true;
+        }
+    }
+
     private defineParameter(
         nameNode: ts.BindingName,
         p: ts.ParameterDeclaration,
@@ -1431,28 +1973,6 @@ export class TypeAnalyzer {
                     }
                 },
             },
-            CallExpression: {
-                enter: (node) => {
-                    if (ts.isCallExpression(node)) {
-                        const callee = node.expression;
-                        if (ts.isIdentifier(callee)) {
-                            const name = callee.text;
-                            const typeInfo = this.scopeManager.lookup(name);
-                            if (
-                                typeInfo && typeInfo.declaration &&
-                                ts.isFunctionLike(typeInfo.declaration)
-                            ) {
-                                const decl = typeInfo
-                                    .declaration as ts.Declaration;
-                                if (!this.callSites.has(decl)) {
-                                    this.callSites.set(decl, []);
-                                }
-                                this.callSites.get(decl)!.push(node);
-                            }
-                        }
-                    }
-                },
-            },
             ReturnStatement: {
                 enter: (node) => {
                     if (ts.isReturnStatement(node) && node.expression) {
@@ -1495,5 +2015,7 @@ export class TypeAnalyzer {
         };
 
         this.traverser.traverse(ast, visitor);
+        this.resolveReferences(ast);
+        this.inferNumericBindings(ast);
     }
 }
@@ -80,17 +80,23 @@ export function visitClassDeclaration(
         }
     }
 
-    let code = `${this.indent()}*${className} = ${constructorLambda};\n`;
+    const classSlot = this.getHeapSlot(
+        this.typeAnalyzer.scopeManager.lookupFromScope(
+            className,
+            this.getScopeForNode(node),
+        ),
+    );
+    let code = `${this.indent()}${classSlot} = ${constructorLambda};\n`;
 
     // Set prototype of class (static inheritance) and prototype object (instance inheritance)
     if (parentName) {
         code +=
-            `${this.indent()}(*${className}).set_prototype(${parentName});\n`;
+            `${this.indent()}(${classSlot}).set_prototype(${parentName});\n`;
         code +=
-            `${this.indent()}(*${className}).get_own_property("prototype").set_prototype(${parentName}.get_own_property("prototype"));\n`;
+            `${this.indent()}(${classSlot}).get_own_property("prototype").set_prototype(${parentName}.get_own_property("prototype"));\n`;
     } else {
         code +=
-            `${this.indent()}(*${className}).get_own_property("prototype").set_prototype(::Object.get_own_property("prototype"));\n`;
+            `${this.indent()}(${classSlot}).get_own_property("prototype").set_prototype(::Object.get_own_property("prototype"));\n`;
     }
 
     // Members
@@ -113,10 +119,10 @@ export function visitClassDeclaration(
 
             if (isStatic) {
                 code +=
-                    `${this.indent()}(*${className}).set_own_property(${methodName}, ${methodLambda});\n`;
+                    `${this.indent()}(${classSlot}).set_own_property(${methodName}, ${methodLambda});\n`;
             } else {
                 code +=
-                    `${this.indent()}(*${className}).get_own_property("prototype").set_own_property(${methodName}, ${methodLambda});\n`;
+                    `${this.indent()}(${classSlot}).get_own_property("prototype").set_own_property(${methodName}, ${methodLambda});\n`;
             }
         } else if (ts.isGetAccessor(member)) {
             const methodName = visitObjectPropertyName.call(this, member.name, {
@@ -135,10 +141,10 @@ export function visitClassDeclaration(
 
             if (isStatic) {
                 code +=
-                    `${this.indent()}(*${className}).define_getter(${methodName}, ${lambda});\n`;
+                    `${this.indent()}(${classSlot}).define_getter(${methodName}, ${lambda});\n`;
             } else {
                 code +=
-                    `${this.indent()}(*${className}).get_own_property("prototype").define_getter(${methodName}, ${lambda});\n`;
+                    `${this.indent()}(${classSlot}).get_own_property("prototype").define_getter(${methodName}, ${lambda});\n`;
             }
         } else if (ts.isSetAccessor(member)) {
             const methodName = visitObjectPropertyName.call(this, member.name, {
@@ -157,10 +163,10 @@ export function visitClassDeclaration(
 
             if (isStatic) {
                 code +=
-                    `${this.indent()}(*${className}).define_setter(${methodName}, ${lambda});\n`;
+                    `${this.indent()}(${classSlot}).define_setter(${methodName}, ${lambda});\n`;
             } else {
                 code +=
-                    `${this.indent()}(*${className}).get_own_property("prototype").define_setter(${methodName}, ${lambda});\n`;
+                    `${this.indent()}(${classSlot}).get_own_property("prototype").define_setter(${methodName}, ${lambda});\n`;
             }
         }
     }
@@ -43,16 +43,17 @@ export function visitForStatement(
                 const decl = varDeclList.declarations[0];
                 if (decl) {
                     const name = decl.name.getText();
-                    const initValue = decl.initializer
-                        ? this.visit(decl.initializer, context)
-                        : "jspp::Constants::UNDEFINED";
-
                     const scope = this.getScopeForNode(decl);
                     const typeInfo = this.typeAnalyzer.scopeManager
                         .lookupFromScope(
                             name,
                             scope,
                         );
+                    const initValue = !decl.initializer
+                        ? "jspp::Constants::UNDEFINED"
+                        : typeInfo?.isNumeric
+                        ? this.getNativeNumberCode(decl.initializer, context)
+                        : this.visit(decl.initializer, context);
 
                     conditionContext.localScopeSymbols = new DeclaredSymbols();
 
@@ -71,8 +72,11 @@ export function visitForStatement(
                     });
 
                     if (typeInfo?.needsHeapAllocation) {
-                        initializerCode =
-                            `auto ${name} = std::make_shared<jspp::AnyValue>(${initValue})`;
+                        initializerCode = `${
+                            this.getHeapSlot(typeInfo)
+                        } = ${initValue}`;
+                    } else if (typeInfo?.isNumeric) {
+                        initializerCode = `double ${name} = ${initValue}`;
                     } else {
                         initializerCode =
                             `jspp::AnyValue ${name} = ${initValue}`;
@@ -89,6 +93,17 @@ export function visitForStatement(
         }
     }
 
+    // Captured loop bindings live in a record created before the loop. Before
+    // each increment the loop moves onto a copy if a closure kept the current
+    // one, so every iteration's closures see their own bindings.
+    const environment = this.environmentRecords.get(
+        this.getScopeForNode(node),
+    );
+    if (environment) {
+        code += `${this.indent()}{\n`;
+        code += this.getEnvironmentDeclaration(node);
+    }
+
     code += `${this.indent()}for (${initializerCode}; `;
     if (forStmt.condition) {
         code += `jspp::is_truthy(${
@@ -96,6 +111,10 @@ export function visitForStatement(
         })`;
     }
     code += "; ";
+    if (environment) {
+        code += `${environment.name}.unshare()`;
+        if (forStmt.incrementor) code += ", ";
+    }
     if (forStmt.incrementor) {
         code += this.visit(forStmt.incrementor, context);
     }
@@ -123,6 +142,10 @@ export function visitForStatement(
         code += `${this.indent()}}\n`;
     }
 
+    if (environment) {
+        code += `${this.indent()}}\n`;
+    }
+
     this.indentationLevel--; // Exit the scope for the for loop
 
     if (context.currentLabel) {
@@ -163,9 +186,8 @@ export function visitForInStatement(
                 scope,
             );
             if (typeInfo?.needsHeapAllocation) {
-                code +=
-                    `${this.indent()}auto ${varName} = std::make_shared<jspp::AnyValue>(jspp::Constants::UNDEFINED);\n`;
-                assignmentTarget = `*${varName}`;
+                // Each iteration gets a fresh record, declared in the loop body
+                assignmentTarget = this.getHeapSlot(typeInfo);
             } else {
                 code +=
                     `${this.indent()}jspp::AnyValue ${varName} = jspp::Constants::UNDEFINED;\n`;
@@ -180,7 +202,7 @@ export function visitForInStatement(
             scope,
         );
         assignmentTarget = typeInfo?.needsHeapAllocation
-            ? `*${varName}`
+            ? this.getHeapSlot(typeInfo)
             : varName;
     }
 
@@ -207,6 +229,7 @@ export function visitForInStatement(
         `${this.indent()}std::vector<jspp::AnyValue> ${keysVar} = jspp::Access::get_object_keys(${derefExpr});\n`;
     code += `${this.indent()}for (const auto& ${varName}_val : ${keysVar}) {\n`;
     this.indentationLevel++;
+    code += this.getEnvironmentDeclaration(node);
     code += `${this.indent()}${assignmentTarget} = ${varName}_val;\n`;
     code += this.visit(forIn.statement, {
         ...context,
@@ -259,9 +282,8 @@ export function visitForOfStatement(
                 scope,
             );
             if (typeInfo?.needsHeapAllocation) {
-                code +=
-                    `${this.indent()}auto ${elemName} = std::make_shared<jspp::AnyValue>(jspp::Constants::UNDEFINED);\n`;
-                assignmentTarget = `*${elemName}`;
+                // Each iteration gets a fresh record, declared in the loop body
+                assignmentTarget = this.getHeapSlot(typeInfo);
             } else {
                 code +=
                     `${this.indent()}jspp::AnyValue ${elemName} = jspp::Constants::UNDEFINED;\n`;
@@ -276,7 +298,7 @@ export function visitForOfStatement(
             scope,
         );
         assignmentTarget = typeInfo?.needsHeapAllocation
-            ? `*${elemName}`
+            ? this.getHeapSlot(typeInfo)
             : elemName;
     }
 
@@ -298,53 +320,66 @@ export function visitForOfStatement(
     }
 
     const declaredSymbols = this.getDeclaredSymbols(forOf.statement);
-    const iterableRef = this.generateUniqueName("__iter_ref", declaredSymbols);
     const iterator = this.generateUniqueName("__iter", declaredSymbols);
-    const nextFunc = this.generateUniqueName("__next_func", declaredSymbols);
-    const nextRes = this.generateUniqueName("__next_res", declaredSymbols);
-
     const isAwait = forOf.awaitModifier !== undefined;
-
     const varName = this.getJsVarName(forOf.expression as ts.Identifier);
-    code += `${this.indent()}auto ${iterableRef} = ${derefIterable};\n`;
-    if (isAwait) {
+
+    if (!isAwait) {
+        // The cursor walks arrays and strings by index and only falls back to the
+        // iterator protocol for everything else
         code +=
-            `${this.indent()}auto ${iterator} = jspp::Access::get_object_async_iterator(${iterableRef}, ${varName});\n`;
+            `${this.indent()}jspp::ForOfCursor ${iterator}(${derefIterable}, ${varName});\n`;
+        code += `${this.indent()}while (${iterator}.next()) {\n`;
+        this.indentationLevel++;
+        code += this.getEnvironmentDeclaration(node);
+        code += `${this.indent()}${assignmentTarget} = ${iterator}.value();\n`;
+        code += this.visit(forOf.statement, {
+            ...context,
+            currentLabel: undefined,
+            isFunctionBody: false,
+        });
+        if (context.currentLabel) {
+            code += `${this.indent()}${context.currentLabel}_continue:;\n`;
+        }
+        this.indentationLevel--;
+        code += `${this.indent()}}\n`;
     } else {
+        const iterableRef = this.generateUniqueName(
+            "__iter_ref",
+            declaredSymbols,
+        );
+        const nextFunc = this.generateUniqueName(
+            "__next_func",
+            declaredSymbols,
+        );
+        const nextRes = this.generateUniqueName("__next_res", declaredSymbols);
+
+        code += `${this.indent()}auto ${iterableRef} = ${derefIterable};\n`;
         code +=
-            `${this.indent()}auto ${iterator} = jspp::Access::get_object_iterator(${iterableRef}, ${varName});\n`;
-    }
-    code +=
-        `${this.indent()}auto ${nextFunc} = ${iterator}.get_own_property("next");\n`;
-    if (isAwait) {
+            `${this.indent()}auto ${iterator} = jspp::Access::get_object_async_iterator(${iterableRef}, ${varName});\n`;
+        code +=
+            `${this.indent()}auto ${nextFunc} = ${iterator}.get_own_property("next");\n`;
         code +=
             `${this.indent()}auto ${nextRes} = co_await ${nextFunc}.call(${iterator}, {}, "next");\n`;
-    } else {
         code +=
-            `${this.indent()}auto ${nextRes} = ${nextFunc}.call(${iterator}, {}, "next");\n`;
-    }
-    code +=
-        `${this.indent()}while (!jspp::is_truthy(${nextRes}.get_own_property("done"))) {\n`;
-    this.indentationLevel++;
-    code +=
-        `${this.indent()}${assignmentTarget} = ${nextRes}.get_own_property("value");\n`;
-    code += this.visit(forOf.statement, {
-        ...context,
-        currentLabel: undefined,
-        isFunctionBody: false,
-    });
-    if (context.currentLabel) {
-        code += `${this.indent()}${context.currentLabel}_continue:;\n`;
-    }
-    if (isAwait) {
+            `${this.indent()}while (!jspp::is_truthy(${nextRes}.get_own_property("done"))) {\n`;
+        this.indentationLevel++;
+        code += this.getEnvironmentDeclaration(node);
         code +=
-            `${this.indent()}${nextRes} = co_await ${nextFunc}.call(${iterator}, {}, "next");\n`;
-    } else {
+            `${this.indent()}${assignmentTarget} = ${nextRes}.get_own_property("value");\n`;
+        code += this.visit(forOf.statement, {
+            ...context,
+            currentLabel: undefined,
+            isFunctionBody: false,
+        });
+        if (context.currentLabel) {
+            code += `${this.indent()}${context.currentLabel}_continue:;\n`;
+        }
         code +=
-            `${this.indent()}${nextRes} = ${nextFunc}.call(${iterator}, {}, "next");\n`;
+            `${this.indent()}${nextRes} = co_await ${nextFunc}.call(${iterator}, {}, "next");\n`;
+        this.indentationLevel--;
+        code += `${this.indent()}}\n`;
     }
-    this.indentationLevel--;
-    code += `${this.indent()}}\n`;
     this.indentationLevel--; // Exit the scope for the for-of loop
     code += `${this.indent()}}\n`;
 
@@ -530,6 +565,9 @@ export function visitSwitchStatement(
 
     const hoistedSymbols = new DeclaredSymbols();
 
+    // Captured bindings of the case clauses live in the switch's environment record
+    code += this.getEnvironmentDeclaration(node);
+
     // 1. Hoist function declarations
     funcDecls.forEach((func) => {
         code += this.hoistDeclaration(func, hoistedSymbols, node);
@@ -606,7 +644,6 @@ export function visitSwitchStatement(
             {
                 isAssignment: true,
                 nativeName,
-                noTypeSignature: true,
             },
         );
 
@@ -620,7 +657,13 @@ export function visitSwitchStatement(
             this.isDeclarationUsedBeforeInitialization(funcName, node)
         ) {
             const wrappedLambda = this.generateWrappedLambda(lambdaComps);
-            code += `${this.indent()}*${funcName} = ${wrappedLambda};\n`;
+            const funcType = this.typeAnalyzer.scopeManager.lookupFromScope(
+                funcName,
+                this.getScopeForNode(node),
+            );
+            code += `${this.indent()}${
+                this.getHeapSlot(funcType)
+            } = ${wrappedLambda};\n`;
         }
     });
 
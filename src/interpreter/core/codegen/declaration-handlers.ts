@@ -56,9 +56,10 @@ export function visitVariableDeclaration(
 
     let nativeLambdaCode = "";
     let initializer = "";
-    let shouldSkipDeref = false;
 
-    if (varDecl.initializer) {
+    if (varDecl.initializer && typeInfo?.isNumeric) {
+        initializer = this.getNativeNumberCode(varDecl.initializer, context);
+    } else if (varDecl.initializer) {
         const initExpr = varDecl.initializer;
         let initText = ts.isNumericLiteral(initExpr)
             ? initExpr.getText()
@@ -71,19 +72,10 @@ export function visitVariableDeclaration(
             )!;
             const varName = this.getJsVarName(initExpr);
 
-            // Check if both target and initializer are heap allocated
-            if (
-                typeInfo?.needsHeapAllocation &&
-                initTypeInfo?.needsHeapAllocation
-            ) {
-                shouldSkipDeref = true;
-            }
-
             if (
                 initTypeInfo &&
                 !initTypeInfo.isParameter &&
-                !initTypeInfo.isBuiltin &&
-                !shouldSkipDeref
+                !initTypeInfo.isBuiltin
             ) {
                 initText = this.getDerefCode(
                     initText,
@@ -135,7 +127,6 @@ export function visitVariableDeclaration(
                 {
                     isAssignment: true,
                     nativeName,
-                    noTypeSignature: true,
                 },
             );
 
@@ -165,21 +156,17 @@ export function visitVariableDeclaration(
 
     let assignmentTarget = shouldDeref
         ? this.getDerefCode(name, name, context, typeInfo)
-        : (typeInfo?.needsHeapAllocation && !shouldSkipDeref
-            ? `*${name}`
+        : (typeInfo?.needsHeapAllocation
+            ? this.getHeapSlot(typeInfo)
             : name);
 
     const sym = context.localScopeSymbols.get(name) ||
         context.globalScopeSymbols.get(name);
-    if (sym?.checks.skippedHoisting) {
-        assignmentTarget = typeInfo?.needsHeapAllocation && !shouldSkipDeref
-            ? `auto ${name}`
-            : `jspp::AnyValue ${name}`;
-        if (initializer) {
-            initializer = typeInfo?.needsHeapAllocation && !shouldSkipDeref
-                ? `std::make_shared<jspp::AnyValue>(${initializer})`
-                : initializer;
-        }
+    if (sym?.checks.skippedHoisting && !typeInfo?.needsHeapAllocation) {
+        // The slot of a heap-allocated binding already exists in its record
+        assignmentTarget = `${
+            typeInfo?.isNumeric ? "double" : "jspp::AnyValue"
+        } ${name}`;
     }
 
     if (nativeLambdaCode) nativeLambdaCode += `;\n${this.indent()}`;
@@ -212,7 +199,7 @@ export function visitVariableDeclaration(
             ? initializer
             : "jspp::Constants::UNDEFINED";
         if (typeInfo?.needsHeapAllocation) {
-            return `auto ${name} = std::make_shared<jspp::AnyValue>(${initValue})`;
+            return `${this.getHeapSlot(typeInfo)} = ${initValue}`;
         } else {
             return `jspp::AnyValue ${name} = ${initValue}`;
         }
@@ -52,10 +52,9 @@ export function generateDestructuring(
                 context.localScopeSymbols,
             );
 
-            let target = this.visit(pattern, context);
-            if (typeInfo?.needsHeapAllocation) {
-                target = `(*${target})`;
-            }
+            const target = typeInfo?.needsHeapAllocation
+                ? this.getHeapSlot(typeInfo)
+                : this.visit(pattern, context);
             return `${this.indent()}${target} = ${valueCode};\n`;
         } else if (ts.isPropertyAccessExpression(pattern)) {
             const objCode = this.visit(pattern.expression, context);
@@ -88,22 +87,13 @@ export function generateDestructuring(
                 context.localScopeSymbols,
                 context.globalScopeSymbols,
             );
-            const nextVar = this.generateUniqueName(
-                "__destruct_next",
-                declaredSymbols,
-                context.localScopeSymbols,
-                context.globalScopeSymbols,
-            );
 
             innerCode +=
-                `${this.indent()}auto ${iterVar} = jspp::Access::get_object_iterator(${valueCode}, "destructuring");\n`;
-            innerCode +=
-                `${this.indent()}auto ${nextVar} = ${iterVar}.get_own_property("next");\n`;
+                `${this.indent()}jspp::ForOfCursor ${iterVar}(${valueCode}, "destructuring");\n`;
 
             elements.forEach((element) => {
                 if (ts.isOmittedExpression(element)) {
-                    innerCode +=
-                        `${this.indent()}${nextVar}.call(${iterVar}, {}, "next");\n`;
+                    innerCode += `${this.indent()}${iterVar}.next();\n`;
                     return;
                 }
 
@@ -131,60 +121,35 @@ export function generateDestructuring(
                     );
                     innerCode +=
                         `${this.indent()}std::vector<jspp::AnyValue> ${restVecVar};\n`;
-                    innerCode += `${this.indent()}while(true) {\n`;
-                    this.indentationLevel++;
-                    const resVar = this.generateUniqueName(
-                        "__res",
-                        declaredSymbols,
-                        context.localScopeSymbols,
-                        context.globalScopeSymbols,
-                    );
-                    innerCode +=
-                        `${this.indent()}auto ${resVar} = ${nextVar}.call(${iterVar}, {}, "next");\n`;
                     innerCode +=
-                        `${this.indent()}if (jspp::is_truthy(${resVar}.get_own_property("done"))) break;\n`;
-                    innerCode +=
-                        `${this.indent()}${restVecVar}.push_back(${resVar}.get_own_property("value"));\n`;
-                    this.indentationLevel--;
-                    innerCode += `${this.indent()}}\n`;
+                        `${this.indent()}while (${iterVar}.next()) ${restVecVar}.push_back(${iterVar}.value());\n`;
                     innerCode += genAssignment(
                         target,
                         `jspp::AnyValue::make_array(std::move(${restVecVar}))`,
                     );
                 } else {
-                    const resVar = this.generateUniqueName(
-                        "__res",
+                    // Read once: nested object patterns use the value per property
+                    const valVar = this.generateUniqueName(
+                        "__val",
                         declaredSymbols,
                         context.localScopeSymbols,
                         context.globalScopeSymbols,
                     );
                     innerCode +=
-                        `${this.indent()}auto ${resVar} = ${nextVar}.call(${iterVar}, {}, "next");\n`;
+                        `${this.indent()}jspp::AnyValue ${valVar} = ${iterVar}.next() ? ${iterVar}.value() : jspp::Constants::UNDEFINED;\n`;
 
-                    let elementValueCode: string;
+                    let elementValueCode = valVar;
                     if (initializer) {
-                        const valVar = this.generateUniqueName(
-                            "__val",
-                            declaredSymbols,
-                            context.localScopeSymbols,
-                            context.globalScopeSymbols,
-                        );
-                        innerCode +=
-                            `${this.indent()}auto ${valVar} = (jspp::is_truthy(${resVar}.get_own_property("done")) ? jspp::Constants::UNDEFINED : ${resVar}.get_own_property("value"));\n`;
                         const initCode = this.visit(initializer, context);
                         elementValueCode =
                             `(${valVar}.is_undefined() ? ${initCode} : ${valVar})`;
-                    } else {
-                        elementValueCode =
-                            `(jspp::is_truthy(${resVar}.get_own_property("done")) ? jspp::Constants::UNDEFINED : ${resVar}.get_own_property("value"))`;
                     }
                     innerCode += genAssignment(target, elementValueCode);
                 }
             });
 
-            // Call the return method to clean resources
-            innerCode +=
-                `${this.indent()}jspp::Access::call_optional_property_with_optional_call(${iterVar}, "return", {});\n`;
+            // Close the iterator if the pattern stopped before it finished
+            innerCode += `${this.indent()}${iterVar}.close();\n`;
 
             return innerCode;
         } else if (
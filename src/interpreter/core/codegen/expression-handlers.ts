@@ -393,7 +393,7 @@ export function visitPrefixUnaryExpression(
             if (context.derefBeforeAssignment) {
                 target = this.getDerefCode(operand, operand, context, typeInfo);
             } else if (typeInfo?.needsHeapAllocation) {
-                target = `*${operand}`;
+                target = this.getHeapSlot(typeInfo);
             }
         }
         return `${operator}(${target})`;
@@ -419,7 +419,7 @@ export function visitPrefixUnaryExpression(
             if (context.derefBeforeAssignment) {
                 target = this.getDerefCode(operand, operand, context, typeInfo);
             } else if (typeInfo?.needsHeapAllocation) {
-                target = `*${operand}`;
+                target = this.getHeapSlot(typeInfo);
             }
         }
         return `jspp::bitwise_not(${target})`;
@@ -468,7 +468,7 @@ export function visitPostfixUnaryExpression(
         if (context.derefBeforeAssignment) {
             target = this.getDerefCode(operand, operand, context, typeInfo);
         } else if (typeInfo?.needsHeapAllocation) {
-            target = `*${operand}`;
+            target = this.getHeapSlot(typeInfo);
         }
     }
     return `(${target})${operator}`;
@@ -545,7 +545,7 @@ export function visitPropertyAccessExpression(
         return `jspp::Access::get_optional_property(${finalExpr}, "${propName}")`;
     }
 
-    return `${finalExpr}.get_own_property("${propName}")`;
+    return `jspp::Access::get_property_cached(${finalExpr}, ${this.getPropertyKey(propName)}, ${this.nextPropertyCache()})`;
 }
 
 export function visitElementAccessExpression(
@@ -633,6 +633,21 @@ export function visitElementAccessExpression(
     return `${finalExpr}.get_own_property(${argText})`;
 }
 
+const NATIVE_COMPOUND_OPERATORS: Record<string, string> = {
+    "+": "add_native",
+    "-": "sub_native",
+    "*": "mul_native",
+    "/": "div_native",
+    "%": "mod_native",
+    "**": "pow_native",
+    "<<": "left_shift_native",
+    ">>": "right_shift_native",
+    ">>>": "unsigned_right_shift_native",
+    "&": "bitwise_and_native",
+    "|": "bitwise_or_native",
+    "^": "bitwise_xor_native",
+};
+
 export function visitBinaryExpression(
     this: CodeGenerator,
     node: ts.BinaryExpression,
@@ -663,6 +678,22 @@ export function visitBinaryExpression(
         ts.SyntaxKind.QuestionQuestionEqualsToken,
     ];
     if (assignmentOperators.includes(opToken.kind)) {
+        // Numeric bindings are updated with native operators in place
+        if (ts.isIdentifier(binExpr.left)) {
+            const scope = this.getScopeForNode(binExpr.left);
+            const typeInfo = this.typeAnalyzer.scopeManager.lookupFromScope(
+                binExpr.left.text,
+                scope,
+            );
+            const nativeOp = NATIVE_COMPOUND_OPERATORS[op.slice(0, -1)];
+            if (typeInfo?.isNumeric && nativeOp) {
+                const name = binExpr.left.text;
+                return `${name} = jspp::${nativeOp}(${name}, ${
+                    this.getNativeNumberCode(binExpr.right, visitContext)
+                })`;
+            }
+        }
+
         if (
             opToken.kind ===
                 ts.SyntaxKind.GreaterThanGreaterThanGreaterThanEqualsToken
@@ -676,7 +707,7 @@ export function visitBinaryExpression(
                     scope,
                 );
                 const target = typeInfo?.needsHeapAllocation
-                    ? `*${leftText}`
+                    ? this.getHeapSlot(typeInfo)
                     : leftText;
                 return `jspp::unsigned_right_shift_assign(${target}, ${rightText})`;
             } else if (ts.isPropertyAccessExpression(binExpr.left)) {
@@ -712,7 +743,7 @@ export function visitBinaryExpression(
                     scope,
                 );
                 const target = typeInfo?.needsHeapAllocation
-                    ? `*${leftText}`
+                    ? this.getHeapSlot(typeInfo)
                     : leftText;
 
                 if (
@@ -863,7 +894,7 @@ export function visitBinaryExpression(
                     typeInfo,
                 );
             } else if (typeInfo?.needsHeapAllocation) {
-                target = `*${leftText}`;
+                target = this.getHeapSlot(typeInfo);
             }
         }
         return `${target} ${op} ${rightText}`;
@@ -949,7 +980,7 @@ export function visitBinaryExpression(
                 }
             }
 
-            return `${finalObjExpr}.set_own_property("${propName}", ${finalRightText})`;
+            return `jspp::Access::set_property_cached(${finalObjExpr}, ${this.getPropertyKey(propName)}, ${finalRightText}, ${this.nextPropertyCache()})`;
         } else if (ts.isElementAccessExpression(binExpr.left)) {
             const elemAccess = binExpr.left;
             const objExprText = this.visit(elemAccess.expression, visitContext);
@@ -1061,9 +1092,14 @@ export function visitBinaryExpression(
         if (ts.isNumericLiteral(binExpr.right)) {
             rightText = binExpr.right.getText();
         }
+        if (typeInfo?.isNumeric) {
+            rightText = this.getNativeNumberCode(binExpr.right, visitContext);
+        }
         const target = context.derefBeforeAssignment
             ? this.getDerefCode(leftText, leftText, visitContext, typeInfo)
-            : (typeInfo?.needsHeapAllocation ? `*${leftText}` : leftText);
+            : (typeInfo?.needsHeapAllocation
+                ? this.getHeapSlot(typeInfo)
+                : leftText);
 
         // Update scope symbols on variable re-assignment
         // Reset features
@@ -1112,7 +1148,7 @@ export function visitBinaryExpression(
         }
         // Number optimizations
         const nodeType = this.typeAnalyzer.inferNodeReturnType(binExpr.left);
-        if (nodeType === "number") {
+        if (nodeType === "number" && !typeInfo?.isNumeric) {
             finalLeft = `${finalLeft}.as_double()`;
         }
     }
@@ -1143,7 +1179,7 @@ export function visitBinaryExpression(
         }
         // Number optimizations
         const nodeType = this.typeAnalyzer.inferNodeReturnType(binExpr.right);
-        if (nodeType === "number") {
+        if (nodeType === "number" && !typeInfo?.isNumeric) {
             finalRight = `${finalRight}.as_double()`;
         }
     }
@@ -1180,6 +1216,16 @@ export function visitBinaryExpression(
             ts.isConditionalExpression(node.parent))
     ) {
         supportsNativeValue = true;
+    } else if (
+        exprReturnType === "boolean" &&
+        (ts.isWhileStatement(node.parent) || ts.isDoStatement(node.parent) ||
+            (ts.isForStatement(node.parent) &&
+                node.parent.condition === node)) &&
+        this.typeAnalyzer.isNumericExpression(binExpr.left) &&
+        this.typeAnalyzer.isNumericExpression(binExpr.right)
+    ) {
+        // Loop conditions comparing numbers never need a boxed boolean
+        supportsNativeValue = true;
     } else if (
         exprReturnType === "number" &&
         context.isInsideNativeLambda &&
@@ -1519,7 +1565,7 @@ export function visitCallExpression(
                     this.escapeString(propName)
                 }")`;
             }
-            return `${derefObj}.call_own_property("${propName}", ${argsSpan})`;
+            return `jspp::Access::call_property_cached(${derefObj}, ${this.getPropertyKey(propName)}, ${argsSpan}, ${this.nextPropertyCache()})`;
         } else {
             const argsVar = this.generateUniqueName(
                 "__args_",
@@ -1538,7 +1584,7 @@ export function visitCallExpression(
                     }");\n`;
             } else {
                 code +=
-                    `${this.indent()}return ${derefObj}.call_own_property("${propName}", ${argsVar});\n`;
+                    `${this.indent()}return jspp::Access::call_property_cached(${derefObj}, ${this.getPropertyKey(propName)}, ${argsVar}, ${this.nextPropertyCache()});\n`;
             }
             this.indentationLevel--;
             code += `${this.indent()}})()`;
@@ -1673,7 +1719,8 @@ export function visitCallExpression(
 
     // Direct native lamda if available
     if (
-        ts.isIdentifier(callee) && calleeTypeInfo
+        ts.isIdentifier(callee) && calleeTypeInfo &&
+        !calleeTypeInfo.isReassigned
     ) {
         const name = callee.getText();
         const symbol = context.localScopeSymbols.get(name) ??
@@ -1690,8 +1737,20 @@ export function visitCallExpression(
                 let argsPart = "";
 
                 if (parameters) {
-                    const argsArray = flattened.map((arg) => {
+                    const argsArray = flattened.map((arg, i) => {
                         const expr = arg as ts.Expression;
+                        const param = parameters[i];
+                        if (param && ts.isIdentifier(param.name)) {
+                            const paramTypeInfo = this.typeAnalyzer
+                                .scopeManager.lookupFromScope(
+                                    param.name.text,
+                                    this.getScopeForNode(param),
+                                );
+                            // Numeric parameters take a native double
+                            if (paramTypeInfo?.isNumeric) {
+                                return this.getNativeNumberCode(expr, context);
+                            }
+                        }
                         let argText = this.visit(expr, context);
                         if (ts.isIdentifier(expr)) {
                             const scope = this.getScopeForNode(expr);
@@ -1869,11 +1928,12 @@ export function visitTemplateExpression(
 ): string {
     const templateExpr = node as ts.TemplateExpression;
 
-    let result = `jspp::AnyValue::make_string("${
-        this.escapeString(
-            templateExpr.head.text,
-        )
-    }")`;
+    // Literal chunks and substitutions in order; the runtime sizes one buffer for all
+    // of them instead of concatenating pairwise.
+    const parts: string[] = [];
+    if (templateExpr.head.text) {
+        parts.push(this.getStringLiteral(templateExpr.head.text));
+    }
 
     for (const span of templateExpr.templateSpans) {
         const expr = span.expression;
@@ -1906,17 +1966,15 @@ export function visitTemplateExpression(
             }
         }
 
-        result = `jspp::add(${result}, ${finalExpr})`;
+        parts.push(finalExpr);
 
         if (span.literal.text) {
-            result = `jspp::add(${result}, jspp::AnyValue::make_string("${
-                this.escapeString(
-                    span.literal.text,
-                )
-            }"))`;
+            parts.push(this.getStringLiteral(span.literal.text));
         }
     }
-    return result;
+    return `jspp::template_literal(std::span<const jspp::AnyValue>((const jspp::AnyValue[]){${
+        parts.join(", ")
+    }}, ${parts.length}))`;
 }
 
 export function visitNewExpression(
@@ -2150,7 +2208,7 @@ export function visitDeleteExpression(
     const expr = node.expression;
     if (ts.isPropertyAccessExpression(expr)) {
         const obj = this.visit(expr.expression, context);
-        const prop = `jspp::AnyValue::make_string("${expr.name.getText()}")`;
+        const prop = this.getStringLiteral(expr.name.getText());
         return `jspp::Access::delete_property(${obj}, ${prop})`;
     } else if (ts.isElementAccessExpression(expr)) {
         const obj = this.visit(expr.expression, context);
@@ -21,7 +21,6 @@ export function generateLambdaComponents(
         capture?: string;
         isClass?: boolean;
         nativeName?: string;
-        noTypeSignature?: boolean;
     },
 ) {
     const declaredSymbols = this.getDeclaredSymbols(node);
@@ -70,10 +69,11 @@ export function generateLambdaComponents(
     };
 
     // Lambda arguments: regular functions use std::span for performance.
-    // Generators and async functions use std::vector to ensure they are safely copied into the coroutine frame.
+    // Generators and async functions take jspp::CoroutineArgs, an owning copy that keeps
+    // a few arguments inline so they are stored in the coroutine frame itself.
     const paramThisType = "jspp::AnyValue";
     const paramArgsType = isInsideGeneratorFunction || isInsideAsyncFunction
-        ? "std::vector<jspp::AnyValue>"
+        ? "jspp::CoroutineArgs"
         : "std::span<const jspp::AnyValue>";
 
     const globalScopeSymbols = this.prepareScopeSymbolsForVisit(
@@ -126,12 +126,19 @@ export function generateLambdaComponents(
                 `${this.indent()}jspp::AnyValue ${this.globalThisVar} = ${finalThisParamName};\n`;
         }
         // Note: Arguments are now automatically copied into the coroutine frame because
-        // the lambda parameter is passed by value (std::vector).
+        // the lambda parameter is passed by value (jspp::CoroutineArgs).
         // We just need to define argsName as a reference to the parameter.
         preamble +=
             `${this.indent()}auto& ${argsName} = ${finalArgsParamName};\n`;
     }
 
+    // Captured parameters and `var`s live in the function scope's environment record
+    this.indentationLevel++;
+    const environmentDeclaration = this.getEnvironmentDeclaration(node);
+    this.indentationLevel--;
+    preamble += environmentDeclaration;
+    nativePreamble += environmentDeclaration;
+
     // Native function arguments for native lambda
     let nativeFuncArgs = "";
     let nativeParamsContent = "";
@@ -156,6 +163,12 @@ export function generateLambdaComponents(
                 name,
                 scope,
             );
+            if (typeInfo?.isNumeric) {
+                // Callers always pass a number; NaN (ToNumber(undefined)) is only a placeholder default
+                nativeFuncArgs +=
+                    `, double ${name} = std::numeric_limits<double>::quiet_NaN()`;
+                return;
+            }
             if (typeInfo?.needsHeapAllocation) {
                 needsTemp = true;
                 signatureName = this.generateUniqueName(
@@ -169,8 +182,12 @@ export function generateLambdaComponents(
 
         if (needsTemp) {
             if (isIdentifier) {
+                const typeInfo = this.typeAnalyzer.scopeManager.lookupFromScope(
+                    name,
+                    this.getScopeForNode(p),
+                );
                 nativeParamsContent +=
-                    `${this.indent()}auto ${name} = std::make_shared<jspp::AnyValue>(${signatureName});\n`;
+                    `${this.indent()}${this.getHeapSlot(typeInfo)} = ${signatureName};\n`;
             } else {
                 nativeParamsContent += this.generateDestructuring(
                     p.name,
@@ -210,7 +227,7 @@ export function generateLambdaComponents(
                         `jspp::AnyValue::make_array(${argsName}.subspan(${i}))`;
                     if (typeInfo?.needsHeapAllocation) {
                         paramsCode +=
-                            `${this.indent()}auto ${name} = std::make_shared<jspp::AnyValue>(${initValue});\n`;
+                            `${this.indent()}${this.getHeapSlot(typeInfo)} = ${initValue};\n`;
                     } else {
                         paramsCode +=
                             `${this.indent()}jspp::AnyValue ${name} = ${initValue};\n`;
@@ -221,9 +238,12 @@ export function generateLambdaComponents(
                 // Normal parameter
                 const initValue =
                     `${argsName}.size() > ${i} ? ${argsName}[${i}] : ${defaultValue}`;
-                if (typeInfo?.needsHeapAllocation) {
+                if (typeInfo?.isNumeric) {
                     paramsCode +=
-                        `${this.indent()}auto ${name} = std::make_shared<jspp::AnyValue>(${initValue});\n`;
+                        `${this.indent()}double ${name} = jspp::plus_native(${initValue});\n`;
+                } else if (typeInfo?.needsHeapAllocation) {
+                    paramsCode +=
+                        `${this.indent()}${this.getHeapSlot(typeInfo)} = ${initValue};\n`;
                 } else {
                     paramsCode +=
                         `${this.indent()}jspp::AnyValue ${name} = ${initValue};\n`;
@@ -440,54 +460,40 @@ export function generateWrappedLambda(
     const capture = options?.capture || "[=]";
     const isAssignment = options?.isAssignment || false;
     const funcReturnType = getFuncReturnType(false);
-    const noTypeSignature = options?.noTypeSignature || false;
+
+    // Environment records from enclosing scopes come in as leading parameters
+    // rather than captures, so the function can trace them
+    const environments = this.getCapturedEnvironments(node);
+    const environmentParams = environments.map((record) =>
+        `const jspp::EnvPtr<${record.typeName}> &${record.name}, `
+    ).join("");
 
     let lambda =
-        `${capture}(${thisArgParam}, ${funcArgs}) mutable -> ${funcReturnType} {\n`;
+        `${capture}(${environmentParams}${thisArgParam}, ${funcArgs}) mutable -> ${funcReturnType} {\n`;
     lambda += preamble;
     lambda += paramsContent;
     lambda += getBlockContentWithoutOpeningBrace(false);
 
-    let callable = lambda;
+    // The lambda is handed over as is, or in a jspp::Closure along with its
+    // records: JsFunctionCallable stores it directly and tells generators and
+    // async functions apart by their return type
+    const callable = environments.length > 0
+        ? `jspp::make_closure(${lambda}, ${
+            environments.map((record) => record.name).join(", ")
+        })`
+        : lambda;
     let method = "";
 
-    // Handle generator function
     if (isInsideGeneratorFunction) {
-        if (isInsideAsyncFunction) {
-            if (!noTypeSignature) {
-                const signature =
-                    "jspp::JsAsyncIterator<jspp::AnyValue>(jspp::AnyValue, std::vector<jspp::AnyValue>)";
-                callable = `std::function<${signature}>(${lambda})`;
-            }
-            method = `jspp::AnyValue::make_async_generator`;
-        } else {
-            if (!noTypeSignature) {
-                const signature =
-                    "jspp::JsIterator<jspp::AnyValue>(jspp::AnyValue, std::vector<jspp::AnyValue>)";
-                callable = `std::function<${signature}>(${lambda})`;
-            }
-            method = `jspp::AnyValue::make_generator`;
-        }
-    } // Handle async function
-    else if (isInsideAsyncFunction) {
-        if (!noTypeSignature) {
-            const signature =
-                "jspp::JsPromise(jspp::AnyValue, std::vector<jspp::AnyValue>)";
-            callable = `std::function<${signature}>(${lambda})`;
-        }
+        method = isInsideAsyncFunction
+            ? `jspp::AnyValue::make_async_generator`
+            : `jspp::AnyValue::make_generator`;
+    } else if (isInsideAsyncFunction) {
         method = `jspp::AnyValue::make_async_function`;
-    } // Handle normal function
-    else {
-        if (!noTypeSignature) {
-            const signature =
-                `jspp::AnyValue(jspp::AnyValue, std::span<const jspp::AnyValue>)`;
-            callable = `std::function<${signature}>(${lambda})`;
-        }
-        if (options?.isClass) {
-            method = `jspp::AnyValue::make_class`;
-        } else {
-            method = `jspp::AnyValue::make_function`;
-        }
+    } else if (options?.isClass) {
+        method = `jspp::AnyValue::make_class`;
+    } else {
+        method = `jspp::AnyValue::make_function`;
     }
 
     const funcName = context?.functionName || node.name?.getText();
@@ -505,7 +511,7 @@ export function generateWrappedLambda(
         if (hasName) {
             args += `, "${funcName}"`;
         } else if (!isConstructor) {
-            args += `, std::nullopt`;
+            args += `, nullptr`;
         }
 
         if (!isConstructor) {
@@ -580,8 +586,11 @@ export function visitFunctionExpression(
         const funcName = funcExpr.name.getText();
         let code = "([=]() -> jspp::AnyValue {\n";
         this.indentationLevel++;
-        code +=
-            `${this.indent()}auto ${funcName} = std::make_shared<jspp::AnyValue>();\n`;
+        // The function's own name is bound in a record of its own, outside the function
+        code += this.getEnvironmentDeclaration(funcExpr, true);
+        const slot = this.getHeapSlot(
+            this.typeAnalyzer.functionTypeInfo.get(funcExpr),
+        );
         const lambda = this.generateWrappedLambda(
             this.generateLambdaComponents(
                 funcExpr,
@@ -595,8 +604,8 @@ export function visitFunctionExpression(
                 },
             ),
         );
-        code += `${this.indent()}*${funcName} = ${lambda};\n`;
-        code += `${this.indent()}return *${funcName};\n`;
+        code += `${this.indent()}${slot} = ${lambda};\n`;
+        code += `${this.indent()}return ${slot};\n`;
         this.indentationLevel--;
         code += `${this.indent()}})()`;
         return code;
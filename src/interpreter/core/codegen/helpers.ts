@@ -143,6 +143,184 @@ export function getScopeForNode(this: CodeGenerator, node: ts.Node): Scope {
     return rootScope;
 }
 
+/**
+ * One scope's environment record: the C++ variable holding it, the struct
+ * describing its slots, and the names of the bindings it holds.
+ */
+export interface EnvironmentRecordInfo {
+    name: string;
+    typeName: string;
+    slots: string[];
+    node: ts.Node; // where the record is created: its scope's node, or the named function expression
+    isOwnName: boolean;
+}
+
+/**
+ * Groups the heap-allocated bindings of every scope into environment records.
+ *
+ * Each scope with bindings that closures capture gets one `jspp::Environment`
+ * holding all of them, so a closure keeps one handle per enclosing scope
+ * instead of one box per variable. A named function expression's own name is
+ * bound outside the function, so it gets a record of its own, keyed by the
+ * function expression node instead of its scope.
+ *
+ * @param ast The root node, whose declared names the record names must avoid.
+ */
+export function planEnvironmentRecords(this: CodeGenerator, ast: ts.Node) {
+    this.environmentRecords = new Map();
+    this.heapSlots = new Map();
+    const declaredSymbols = this.getDeclaredSymbols(ast);
+
+    // The first node mapped to a scope is the one that entered it
+    const scopeNodes = new Map<Scope, ts.Node>();
+    for (const [node, scope] of this.typeAnalyzer.nodeToScope) {
+        if (!scopeNodes.has(scope)) scopeNodes.set(scope, node);
+    }
+
+    for (const scope of this.typeAnalyzer.scopeManager.getAllScopes()) {
+        const scopeNode = scopeNodes.get(scope);
+        if (!scopeNode) continue;
+        for (const [name, typeInfo] of scope.symbols) {
+            if (
+                !typeInfo.needsHeapAllocation || typeInfo.isBuiltin ||
+                this.heapSlots.has(typeInfo)
+            ) continue;
+
+            const decl = typeInfo.declaration;
+            const ownNameOf = decl && ts.isFunctionExpression(decl) &&
+                    decl.name?.text === name &&
+                    this.typeAnalyzer.nodeToScope.get(decl) === scope
+                ? decl
+                : undefined;
+            const key = ownNameOf ?? scope;
+
+            let record = this.environmentRecords.get(key);
+            if (!record) {
+                const recordName = this.generateUniqueName(
+                    "__env_",
+                    declaredSymbols,
+                );
+                record = {
+                    name: recordName,
+                    typeName: `${recordName}_t`,
+                    slots: [],
+                    node: ownNameOf ?? scopeNode,
+                    isOwnName: !!ownNameOf,
+                };
+                this.environmentRecords.set(key, record);
+            }
+            record.slots.push(name);
+            this.heapSlots.set(typeInfo, {
+                record,
+                slot: `${record.name}->${name}`,
+            });
+        }
+    }
+}
+
+/**
+ * Returns the environment record slot that holds a heap-allocated binding.
+ *
+ * @param typeInfo Type information for the binding.
+ * @returns A C++ lvalue expression for the binding's value.
+ * @throws CompilerError if the binding was not assigned a record.
+ */
+export function getHeapSlot(
+    this: CodeGenerator,
+    typeInfo: TypeInfo | null | undefined,
+): string {
+    const slot = typeInfo ? this.heapSlots.get(typeInfo)?.slot : undefined;
+    if (!slot) {
+        const message = "Heap-allocated binding has no environment record.";
+        if (typeInfo?.declaration) {
+            throw new CompilerError(message, typeInfo.declaration, "CompilerBug");
+        }
+        throw new Error(`CompilerBug: ${message}`);
+    }
+    return slot;
+}
+
+/**
+ * Generates the C++ code that creates the environment record of a scope.
+ *
+ * Emitted once where the scope is entered, before any of its bindings is
+ * initialized. Scopes without heap-allocated bindings need no record.
+ *
+ * @param node The node owning the scope.
+ * @param ownName Declare the record for a named function expression's own name instead.
+ * @returns The struct definition and record allocation, or an empty string.
+ */
+export function getEnvironmentDeclaration(
+    this: CodeGenerator,
+    node: ts.Node,
+    ownName = false,
+): string {
+    const key = ownName ? node : this.typeAnalyzer.nodeToScope.get(node);
+    const record = key ? this.environmentRecords.get(key) : undefined;
+    if (!record) return "";
+    const members = record.slots.map((slot) =>
+        `&${record.typeName}::${slot}`
+    ).join(", ");
+    return `${this.indent()}struct ${record.typeName} { jspp::AnyValue ${
+        record.slots.join(", ")
+    }; };\n` +
+        `${this.indent()}auto ${record.name} = jspp::make_env<${record.typeName}, ${members}>();\n`;
+}
+
+/**
+ * Lists the environment records a function reads bindings from that are
+ * created outside of it, including those its nested functions read.
+ *
+ * The wrapped lambda takes these as leading parameters and is stored in a
+ * `jspp::Closure` holding them, so the cycle collector can trace them.
+ *
+ * @param node The function-like node.
+ * @returns The records, in the order they were planned.
+ */
+export function getCapturedEnvironments(
+    this: CodeGenerator,
+    node: ts.Node,
+): EnvironmentRecordInfo[] {
+    // A function's own scope record is created in its body, but the record
+    // for a named function expression's own name is created around it
+    const isCreatedInside = (record: EnvironmentRecordInfo) => {
+        if (record.node === node) return !record.isOwnName;
+        for (let n = record.node.parent; n; n = n.parent) {
+            if (n === node) return true;
+        }
+        return false;
+    };
+
+    const records = new Set<EnvironmentRecordInfo>();
+    const visitNode = (child: ts.Node) => {
+        if (
+            ts.isIdentifier(child) &&
+            !((ts.isPropertyAccessExpression(child.parent) ||
+                ts.isPropertyAssignment(child.parent) ||
+                ts.isMethodDeclaration(child.parent) ||
+                ts.isFunctionDeclaration(child.parent) ||
+                ts.isFunctionExpression(child.parent) ||
+                ts.isClassDeclaration(child.parent)) &&
+                child.parent.name === child)
+        ) {
+            const typeInfo = this.typeAnalyzer.scopeManager.lookupFromScope(
+                child.text,
+                this.getScopeForNode(child),
+            );
+            const binding = typeInfo && this.heapSlots.get(typeInfo);
+            if (binding && !isCreatedInside(binding.record)) {
+                records.add(binding.record);
+            }
+        }
+        ts.forEachChild(child, visitNode);
+    };
+    ts.forEachChild(node, visitNode);
+
+    return [...this.environmentRecords.values()].filter((record) =>
+        records.has(record)
+    );
+}
+
 /**
  * Returns a string of spaces representing the current indentation level.
  *
@@ -152,6 +330,53 @@ export function indent(this: CodeGenerator) {
     return "  ".repeat(this.indentationLevel);
 }
 
+/**
+ * Allocates a new per-site inline cache slot for a named property access.
+ *
+ * @returns A C++ lvalue expression referring to the site's `jspp::PropertyCache`.
+ */
+export function nextPropertyCache(this: CodeGenerator): string {
+    return `${this.propertyCacheVar}[${this.propertyCacheCount++}]`;
+}
+
+/**
+ * Interns a property name in the module-level atom table.
+ *
+ * Each distinct name becomes one `jspp::PropertyKey` at startup, so cached
+ * access sites hand the runtime a pre-hashed atom instead of a C string.
+ *
+ * @param name The property name, as written in the source.
+ * @returns A C++ expression referring to the interned `jspp::PropertyKey`.
+ */
+export function getPropertyKey(this: CodeGenerator, name: string): string {
+    const escaped = this.escapeString(name);
+    let index = this.propertyKeys.get(escaped);
+    if (index === undefined) {
+        index = this.propertyKeys.size;
+        this.propertyKeys.set(escaped, index);
+    }
+    return `${this.propertyKeysVar}[${index}]`;
+}
+
+/**
+ * Interns a string literal in the module-level literal table.
+ *
+ * Each distinct literal is allocated once at startup as an immortal string,
+ * so evaluating it copies a borrowed pointer and never touches a refcount.
+ *
+ * @param text The literal's (unescaped) string value.
+ * @returns A C++ expression referring to the interned `jspp::AnyValue`.
+ */
+export function getStringLiteral(this: CodeGenerator, text: string): string {
+    const escaped = this.escapeString(text);
+    let index = this.stringLiterals.get(escaped);
+    if (index === undefined) {
+        index = this.stringLiterals.size;
+        this.stringLiterals.set(escaped, index);
+    }
+    return `${this.stringLiteralsVar}[${index}]`;
+}
+
 /**
  * Escapes special characters in a string for safe use in C++ string literals.
  *
@@ -200,6 +425,10 @@ export function getDerefCode(
     if (typeInfo?.isBuiltin) {
         return nodeText;
     }
+    // Numeric bindings are plain doubles that are never read inside their TDZ
+    if (typeInfo?.isNumeric) {
+        return nodeText;
+    }
 
     // Make sure varName is incased in quotes
     if (!varName.startsWith('"')) varName = '"' + varName;
@@ -218,17 +447,19 @@ export function getDerefCode(
         context.localScopeSymbols,
     );
 
+    // Heap-allocated bindings live in their scope's environment record
+    const target = typeInfo?.needsHeapAllocation
+        ? this.getHeapSlot(typeInfo)
+        : nodeText;
+
     // Apply deref code
     if (isInitialized) {
         if (typeInfo && typeInfo.needsHeapAllocation) {
-            return `(*${nodeText})`;
+            return `(${target})`;
         }
-        return `${nodeText}`;
+        return `${target}`;
     } else {
-        if (typeInfo && typeInfo.needsHeapAllocation) {
-            return `jspp::Access::deref_ptr(${nodeText}, ${varName})`;
-        }
-        return `jspp::Access::deref_stack(${nodeText}, ${varName})`;
+        return `jspp::Access::deref_stack(${target}, ${varName})`;
     }
 }
 
@@ -255,6 +486,104 @@ export function markSymbolAsInitialized(
     }
 }
 
+const NATIVE_NUMBER_OPERATORS: Partial<Record<ts.SyntaxKind, string>> = {
+    [ts.SyntaxKind.PlusToken]: "add_native",
+    [ts.SyntaxKind.MinusToken]: "sub_native",
+    [ts.SyntaxKind.AsteriskToken]: "mul_native",
+    [ts.SyntaxKind.SlashToken]: "div_native",
+    [ts.SyntaxKind.PercentToken]: "mod_native",
+    [ts.SyntaxKind.AsteriskAsteriskToken]: "pow_native",
+    [ts.SyntaxKind.LessThanLessThanToken]: "left_shift_native",
+    [ts.SyntaxKind.GreaterThanGreaterThanToken]: "right_shift_native",
+    [ts.SyntaxKind.GreaterThanGreaterThanGreaterThanToken]:
+        "unsigned_right_shift_native",
+    [ts.SyntaxKind.AmpersandToken]: "bitwise_and_native",
+    [ts.SyntaxKind.BarToken]: "bitwise_or_native",
+    [ts.SyntaxKind.CaretToken]: "bitwise_xor_native",
+};
+
+/**
+ * Generates a C++ expression of type `double` for a numeric JS expression.
+ *
+ * Numeric bindings and literals are emitted as-is and arithmetic between them
+ * stays in `*_native` operators, so no `AnyValue` is created along the way.
+ * Any other expression is boxed as usual and converted with `plus_native`.
+ *
+ * @param node The expression to generate.
+ * @param context The current visit context.
+ * @returns The C++ code for the expression as a native double.
+ */
+export function getNativeNumberCode(
+    this: CodeGenerator,
+    node: ts.Expression,
+    context: VisitContext,
+): string {
+    if (ts.isParenthesizedExpression(node)) {
+        return `(${this.getNativeNumberCode(node.expression, context)})`;
+    }
+    if (
+        ts.isAsExpression(node) || ts.isNonNullExpression(node) ||
+        ts.isSatisfiesExpression(node) || ts.isTypeAssertionExpression(node)
+    ) {
+        return this.getNativeNumberCode(node.expression, context);
+    }
+    if (ts.isNumericLiteral(node)) {
+        return /[.eE]/.test(node.text) ? node.text : `${node.text}.0`;
+    }
+    if (ts.isPrefixUnaryExpression(node)) {
+        switch (node.operator) {
+            case ts.SyntaxKind.PlusToken:
+                return this.getNativeNumberCode(node.operand, context);
+            case ts.SyntaxKind.MinusToken:
+                return `jspp::negate_native(${
+                    this.getNativeNumberCode(node.operand, context)
+                })`;
+            case ts.SyntaxKind.TildeToken:
+                return `jspp::bitwise_not_native(${
+                    this.getNativeNumberCode(node.operand, context)
+                })`;
+        }
+    }
+    if (ts.isBinaryExpression(node)) {
+        const op = NATIVE_NUMBER_OPERATORS[node.operatorToken.kind];
+        if (
+            op &&
+            (node.operatorToken.kind !== ts.SyntaxKind.PlusToken ||
+                (this.typeAnalyzer.isNumericExpression(node.left) &&
+                    this.typeAnalyzer.isNumericExpression(node.right)))
+        ) {
+            return `jspp::${op}(${
+                this.getNativeNumberCode(node.left, context)
+            }, ${this.getNativeNumberCode(node.right, context)})`;
+        }
+    }
+
+    let code = this.visit(node, context);
+    if (ts.isIdentifier(node)) {
+        const scope = this.getScopeForNode(node);
+        const typeInfo = this.typeAnalyzer.scopeManager.lookupFromScope(
+            node.text,
+            scope,
+        );
+        if (typeInfo?.isNumeric) {
+            return code;
+        }
+        if (!typeInfo && !this.isBuiltinObject(node)) {
+            code = `jspp::Exception::throw_unresolved_reference(${
+                this.getJsVarName(node)
+            })`;
+        } else if (typeInfo && !typeInfo.isParameter && !typeInfo.isBuiltin) {
+            code = this.getDerefCode(
+                code,
+                this.getJsVarName(node),
+                context,
+                typeInfo,
+            );
+        }
+    }
+    return `jspp::plus_native(${code})`;
+}
+
 /**
  * Determines the appropriate C++ return command (return or co_return) based on context.
  *
@@ -391,12 +720,27 @@ export function hoistDeclaration(
                 scope,
             );
 
-            const initializer = isLet || isConst || ts.isClassDeclaration(decl)
+            const hasTdz = isLet || isConst || ts.isClassDeclaration(decl);
+            const initializer = hasTdz
                 ? "jspp::Constants::UNINITIALIZED"
                 : "jspp::Constants::UNDEFINED";
 
+            // The binding still starts out uninitialized, but if no read can
+            // observe that, reads skip the runtime TDZ check altogether.
+            if (
+                hasTdz && !ts.isParameter(decl) && !isFromDestructuring &&
+                this.isDeclarationInitializedBeforeEveryRead(
+                    decl as ts.VariableDeclaration | ts.ClassDeclaration,
+                    scopeNode,
+                )
+            ) {
+                hoistedSymbols.update(name, {
+                    checks: { initialized: true },
+                });
+            }
+
             if (typeInfo?.needsHeapAllocation) {
-                return `${this.indent()}auto ${name} = std::make_shared<jspp::AnyValue>(${initializer});\n`;
+                return `${this.indent()}${this.getHeapSlot(typeInfo)} = ${initializer};\n`;
             } else {
                 if (
                     (isLet || isConst) &&
@@ -410,6 +754,9 @@ export function hoistDeclaration(
                     });
                     return "";
                 }
+                if (typeInfo?.isNumeric) {
+                    return `${this.indent()}double ${name} = 0;\n`;
+                }
                 return `${this.indent()}jspp::AnyValue ${name} = ${initializer};\n`;
             }
         } else {
@@ -675,6 +1022,9 @@ export function isDeclarationUsedAsValue(
 /**
  * Checks if a declaration is called as a function (e.g. decl()) within a given node.
  *
+ * Bindings that are reassigned never count as called, since their calls must
+ * dispatch through the current value instead of the native lambda.
+ *
  * @param decl The declaration to check.
  * @param root The root node to search for usages within.
  * @returns True if the declaration is called as a function.
@@ -689,9 +1039,10 @@ export function isDeclarationCalledAsFunction(
     const name = nameNode.text;
 
     let isCalled = false;
+    let isReassigned = false;
 
     const visitor = (node: ts.Node) => {
-        if (isCalled) return;
+        if (isCalled || isReassigned) return;
 
         if (ts.isIdentifier(node) && node.text === name) {
             const scope = this.getScopeForNode(node);
@@ -701,6 +1052,10 @@ export function isDeclarationCalledAsFunction(
             );
 
             if (typeInfo?.declaration === decl) {
+                if (typeInfo.isReassigned) {
+                    isReassigned = true;
+                    return;
+                }
                 const parent = node.parent;
 
                 if (
@@ -711,14 +1066,14 @@ export function isDeclarationCalledAsFunction(
             }
         }
 
-        if (!isCalled) {
+        if (!isCalled && !isReassigned) {
             ts.forEachChild(node, visitor);
         }
     };
 
     ts.forEachChild(root, visitor);
 
-    return isCalled;
+    return isCalled && !isReassigned;
 }
 
 /**
@@ -828,6 +1183,193 @@ export function isDeclarationUsedBeforeInitialization(
     return isUsedBefore;
 }
 
+/**
+ * Checks whether every read of a `let`, `const` or `class` binding provably
+ * happens after its declaration has run, so no read needs a TDZ check.
+ *
+ * Reads directly in the declaring block must come after the declaration
+ * (initializer included). Reads inside functions are proven through
+ * `isReachedOnlyAfter`, which covers closures and hoisted function declarations
+ * that are only invoked once the binding is initialized.
+ *
+ * Only references that resolve to `decl` itself are checked: the same name
+ * declared in a nested block or function is a different binding.
+ *
+ * @param decl The declaration to check.
+ * @param root The scope node that hoists the declaration.
+ * @returns True if no read of the binding can observe its TDZ.
+ */
+export function isDeclarationInitializedBeforeEveryRead(
+    this: CodeGenerator,
+    decl: ts.VariableDeclaration | ts.ClassDeclaration,
+    root: ts.Node,
+): boolean {
+    if (!decl.name || !ts.isIdentifier(decl.name)) return false;
+    const name = decl.name.text;
+
+    const block = getDeclarationBlock(decl, root);
+    if (!block) return false;
+    const span: DeclarationSpan = {
+        block,
+        start: decl.getStart(),
+        end: decl.getEnd(),
+    };
+
+    const scopeManager = this.typeAnalyzer.scopeManager;
+    // Resolved from the parent: a class declaration opens its own scope
+    const binding = scopeManager.lookupFromScope(
+        name,
+        this.getScopeForNode(decl.parent),
+    );
+    const resolvesToDecl = (ref: ts.Identifier) =>
+        scopeManager.lookupFromScope(name, this.getScopeForNode(ref)) ===
+            binding;
+
+    return everyReference(
+        name,
+        block,
+        undefined,
+        (ref) =>
+            !resolvesToDecl(ref) || isReachedOnlyAfter(ref, span, new Set()),
+    );
+}
+
+/** The block a binding is scoped to and the source range of its declaration. */
+interface DeclarationSpan {
+    block: ts.Node;
+    start: number;
+    end: number;
+}
+
+/**
+ * Calls `check` on every value reference to `name` inside `root`, skipping
+ * the subtree of `skip`, declaration names and property names.
+ */
+function everyReference(
+    name: string,
+    root: ts.Node,
+    skip: ts.Node | undefined,
+    check: (ref: ts.Identifier) => boolean,
+): boolean {
+    let ok = true;
+
+    function visit(node: ts.Node) {
+        if (!ok || node === skip) return;
+
+        if (ts.isIdentifier(node) && node.text === name) {
+            const parent = node.parent;
+            const isDeclarationName = (ts.isFunctionDeclaration(parent) ||
+                ts.isVariableDeclaration(parent) ||
+                ts.isClassDeclaration(parent) ||
+                ts.isMethodDeclaration(parent) ||
+                ts.isParameter(parent)) &&
+                parent.name === node;
+            const isPropertyName = (ts.isPropertyAccessExpression(parent) &&
+                parent.name === node) ||
+                (ts.isPropertyAssignment(parent) && parent.name === node);
+            if (!isDeclarationName && !isPropertyName && !check(node)) {
+                ok = false;
+                return;
+            }
+        }
+
+        ts.forEachChild(node, visit);
+    }
+
+    ts.forEachChild(root, visit);
+    return ok;
+}
+
+/**
+ * Finds the block whose statements a lexical declaration is scoped to.
+ *
+ * Returns undefined for declarations in a `switch` case: clauses share one
+ * block, so a later clause can be entered without running an earlier
+ * clause's declarations and source order proves nothing there.
+ */
+function getDeclarationBlock(
+    node: ts.Node,
+    root: ts.Node,
+): ts.Node | undefined {
+    let current = node.parent;
+    while (current) {
+        if (ts.isCaseClause(current) || ts.isDefaultClause(current)) {
+            return undefined;
+        }
+        if (
+            current === root || ts.isBlock(current) ||
+            ts.isSourceFile(current) || ts.isModuleBlock(current) ||
+            ts.isForStatement(current) || ts.isForOfStatement(current) ||
+            ts.isForInStatement(current)
+        ) {
+            return current;
+        }
+        current = current.parent;
+    }
+    return undefined;
+}
+
+/**
+ * Decides whether the code at `ref` can only execute after the declaration
+ * in `span` has run.
+ *
+ * Within one block, source order is execution order: loops re-enter the block
+ * with fresh bindings, and `switch` cases are excluded up front. Function and
+ * arrow expressions are created by the code around them, and methods run no
+ * earlier than the class or object literal that defines them, so the walk
+ * passes through all of these to whatever encloses them. A hoisted function
+ * declaration exists from block entry, so once the walk reaches one it is
+ * proven only if every reference to its name is itself reached only after
+ * the declaration. Exported and mutually recursive declarations stay
+ * unproven.
+ *
+ * @param ref The reference being judged.
+ * @param span The binding's declaring block and declaration range.
+ * @param visiting Function declarations already on the proof stack.
+ * @returns True if every execution of `ref` happens after initialization.
+ */
+function isReachedOnlyAfter(
+    ref: ts.Node,
+    span: DeclarationSpan,
+    visiting: Set<ts.Node>,
+): boolean {
+    let current: ts.Node | undefined = ref.parent;
+    while (current && current !== span.block) {
+        if (ts.isFunctionDeclaration(current)) {
+            return isInvokedOnlyAfter(current, span, visiting);
+        }
+        current = current.parent;
+    }
+    // Reached directly from the declaring block
+    return current === span.block && ref.getStart() >= span.end;
+}
+
+function isInvokedOnlyAfter(
+    fn: ts.FunctionDeclaration,
+    span: DeclarationSpan,
+    visiting: Set<ts.Node>,
+): boolean {
+    if (!fn.name || visiting.has(fn)) return false;
+    if (
+        fn.modifiers?.some((m) =>
+            m.kind === ts.SyntaxKind.ExportKeyword ||
+            m.kind === ts.SyntaxKind.DefaultKeyword
+        )
+    ) {
+        return false;
+    }
+
+    visiting.add(fn);
+    const proven = everyReference(
+        fn.name.text,
+        span.block,
+        fn,
+        (ref) => isReachedOnlyAfter(ref, span, visiting),
+    );
+    visiting.delete(fn);
+    return proven;
+}
+
 /**
  * Checks if a variable name is used within a node subtree without a preceding declaration.
  * Returns true if:
@@ -1,6 +1,7 @@
 import ts from "typescript";
 
-import type { TypeAnalyzer } from "../../analysis/typeAnalyzer.js";
+import type { Scope } from "../../analysis/scope.js";
+import type { TypeAnalyzer, TypeInfo } from "../../analysis/typeAnalyzer.js";
 import { DeclaredSymbols } from "../../ast/symbols.js";
 import type { Node } from "../../ast/types.js";
 import { generateDestructuring } from "./destructuring-handlers.js";
@@ -15,22 +16,32 @@ import {
   generateUniqueExceptionName,
   generateUniqueName,
   getDeclaredSymbols,
+  getCapturedEnvironments,
   getDerefCode,
+  getEnvironmentDeclaration,
+  getHeapSlot,
   getJsVarName,
+  getNativeNumberCode,
   getReturnCommand,
   getScopeForNode,
+  getStringLiteral,
   hoistDeclaration,
   indent,
   isAsyncFunction,
   isBuiltinObject,
   isDeclarationCalledAsFunction,
   isDeclarationUsedAsValue,
+  isDeclarationInitializedBeforeEveryRead,
   isDeclarationUsedBeforeInitialization,
   isGeneratorFunction,
   isVariableUsedWithoutDeclaration,
   markSymbolAsInitialized,
   needsTopLevelAwait,
+  getPropertyKey,
+  nextPropertyCache,
+  planEnvironmentRecords,
   prepareScopeSymbolsForVisit,
+  type EnvironmentRecordInfo,
   validateFunctionParams,
 } from "./helpers.js";
 import { visit, type VisitContext } from "./visitor.js";
@@ -42,6 +53,17 @@ export class CodeGenerator {
     public moduleFunctionName!: string;
     public globalThisVar!: string;
     public uniqueNameCounter = 0;
+    public propertyCacheVar!: string;
+    public propertyCacheCount = 0;
+    public propertyKeysVar!: string;
+    public propertyKeys = new Map<string, number>();
+    public stringLiteralsVar!: string;
+    public stringLiterals = new Map<string, number>();
+    public environmentRecords = new Map<Scope | ts.Node, EnvironmentRecordInfo>();
+    public heapSlots = new Map<
+        TypeInfo,
+        { record: EnvironmentRecordInfo; slot: string }
+    >();
     public isWasm = false;
     public wasmExports: {
         jsName: string;
@@ -60,8 +82,16 @@ export class CodeGenerator {
     public getScopeForNode = getScopeForNode;
     public indent = indent;
     public escapeString = escapeString;
+    public nextPropertyCache = nextPropertyCache;
+    public getPropertyKey = getPropertyKey;
+    public getStringLiteral = getStringLiteral;
     public getJsVarName = getJsVarName;
     public getDerefCode = getDerefCode;
+    public planEnvironmentRecords = planEnvironmentRecords;
+    public getHeapSlot = getHeapSlot;
+    public getEnvironmentDeclaration = getEnvironmentDeclaration;
+    public getCapturedEnvironments = getCapturedEnvironments;
+    public getNativeNumberCode = getNativeNumberCode;
     public getReturnCommand = getReturnCommand;
     public isBuiltinObject = isBuiltinObject;
     public isGeneratorFunction = isGeneratorFunction;
@@ -72,6 +102,8 @@ export class CodeGenerator {
     public isDeclarationUsedAsValue = isDeclarationUsedAsValue;
     public isDeclarationUsedBeforeInitialization =
         isDeclarationUsedBeforeInitialization;
+    public isDeclarationInitializedBeforeEveryRead =
+        isDeclarationInitializedBeforeEveryRead;
     public isVariableUsedWithoutDeclaration = isVariableUsedWithoutDeclaration;
     public validateFunctionParams = validateFunctionParams;
     public generateDestructuring = generateDestructuring;
@@ -104,6 +136,22 @@ export class CodeGenerator {
             "__this_val__",
             this.getDeclaredSymbols(ast),
         );
+        this.propertyCacheVar = this.generateUniqueName(
+            "__property_caches_",
+            this.getDeclaredSymbols(ast),
+        );
+        this.propertyCacheCount = 0;
+        this.propertyKeysVar = this.generateUniqueName(
+            "__property_keys_",
+            this.getDeclaredSymbols(ast),
+        );
+        this.propertyKeys = new Map();
+        this.stringLiteralsVar = this.generateUniqueName(
+            "__string_literals_",
+            this.getDeclaredSymbols(ast),
+        );
+        this.stringLiterals = new Map();
+        this.planEnvironmentRecords(ast);
 
         const isAsyncModule = needsTopLevelAwait(ast);
         const moduleReturnType = isAsyncModule
@@ -142,6 +190,33 @@ export class CodeGenerator {
         this.indentationLevel--;
         moduleCode += "}\n\n";
 
+        // Interned string literals, allocated once at startup and never freed
+        if (this.stringLiterals.size > 0) {
+            declarations +=
+                `static const jspp::AnyValue ${this.stringLiteralsVar}[] = {\n`;
+            for (const literal of this.stringLiterals.keys()) {
+                declarations +=
+                    `    jspp::AnyValue::immortal(jspp::AnyValue::make_string("${literal}")),\n`;
+            }
+            declarations += `};\n\n`;
+        }
+
+        // Interned property names used by the cached access sites
+        if (this.propertyKeys.size > 0) {
+            declarations +=
+                `static const jspp::PropertyKey ${this.propertyKeysVar}[] = {\n`;
+            for (const name of this.propertyKeys.keys()) {
+                declarations += `    jspp::PropertyKey("${name}"),\n`;
+            }
+            declarations += `};\n\n`;
+        }
+
+        // Inline caches for the property access sites emitted above
+        if (this.propertyCacheCount > 0) {
+            declarations +=
+                `static jspp::PropertyCache ${this.propertyCacheVar}[${this.propertyCacheCount}];\n\n`;
+        }
+
         // Wasm Exports
         let wasmGlobalPointers = "";
         let wasmWrappers = "";
@@ -192,11 +267,9 @@ export class CodeGenerator {
             mainCode +=
                 `${this.indent()}p.then(nullptr, [](jspp::AnyValue err) {\n`;
             this.indentationLevel++;
-            mainCode +=
-                `${this.indent()}auto error = std::make_shared<jspp::AnyValue>(err);\n`;
             this.indentationLevel++;
             mainCode +=
-                `${this.indent()}console.call_own_property("error", std::span<const jspp::AnyValue>((const jspp::AnyValue[]){*error}, 1));\n`;
+                `${this.indent()}console.call_own_property("error", std::span<const jspp::AnyValue>((const jspp::AnyValue[]){err}, 1));\n`;
             mainCode += `${this.indent()}std::exit(1);\n`;
             this.indentationLevel--;
             mainCode += `${this.indent()}});\n`;
@@ -209,10 +282,10 @@ export class CodeGenerator {
         mainCode += `${this.indent()}} catch (const std::exception& ex) {\n`;
         this.indentationLevel++;
         mainCode +=
-            `${this.indent()}auto error = std::make_shared<jspp::AnyValue>(jspp::Exception::exception_to_any_value(ex));\n`;
+            `${this.indent()}jspp::AnyValue error = jspp::Exception::exception_to_any_value(ex);\n`;
         this.indentationLevel++;
         mainCode +=
-            `${this.indent()}console.call_own_property("error", std::span<const jspp::AnyValue>((const jspp::AnyValue[]){*error}, 1));\n`;
+            `${this.indent()}console.call_own_property("error", std::span<const jspp::AnyValue>((const jspp::AnyValue[]){error}, 1));\n`;
         mainCode += `${this.indent()}return 1;\n`;
         this.indentationLevel--;
         mainCode += `${this.indent()}}\n`;
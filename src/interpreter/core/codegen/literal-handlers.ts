@@ -15,6 +15,16 @@ export function visitIdentifier(
         return visitUndefinedKeyword();
     }
 
+    // Parameters are read without a deref, so a captured one has to name its
+    // environment record slot here
+    const typeInfo = this.typeAnalyzer.scopeManager.lookupFromScope(
+        node.text,
+        this.getScopeForNode(node),
+    );
+    if (typeInfo?.isParameter && typeInfo.needsHeapAllocation) {
+        return this.getHeapSlot(typeInfo);
+    }
+
     return node.text;
 }
 
@@ -53,14 +63,14 @@ export function visitStringLiteral(
     this: CodeGenerator,
     node: ts.StringLiteral,
 ): string {
-    return `jspp::AnyValue::make_string("${this.escapeString(node.text)}")`;
+    return this.getStringLiteral(node.text);
 }
 
 export function visitNoSubstitutionTemplateLiteral(
     this: CodeGenerator,
     node: ts.NoSubstitutionTemplateLiteral,
 ): string {
-    return `jspp::AnyValue::make_string("${this.escapeString(node.text)}")`;
+    return this.getStringLiteral(node.text);
 }
 
 export function visitTrueKeyword(): string {
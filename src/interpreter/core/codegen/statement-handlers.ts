@@ -33,6 +33,9 @@ export function visitSourceFile(
 
     const hoistedSymbols = new DeclaredSymbols();
 
+    // Captured bindings live in the module's environment record
+    code += this.getEnvironmentDeclaration(node);
+
     // Hoist function declarations
     funcDecls.forEach((func) => {
         code += this.hoistDeclaration(func, hoistedSymbols, node);
@@ -138,7 +141,6 @@ export function visitSourceFile(
             {
                 isAssignment: true,
                 nativeName,
-                noTypeSignature: true,
             },
         );
 
@@ -164,7 +166,13 @@ export function visitSourceFile(
             this.isDeclarationUsedBeforeInitialization(funcName, node)
         ) {
             const wrappedLambda = this.generateWrappedLambda(lambdaComps);
-            code += `${this.indent()}*${funcName} = ${wrappedLambda};\n`;
+            const funcType = this.typeAnalyzer.scopeManager.lookupFromScope(
+                funcName,
+                this.getScopeForNode(node),
+            );
+            code += `${this.indent()}${
+                this.getHeapSlot(funcType)
+            } = ${wrappedLambda};\n`;
         }
     });
 
@@ -212,6 +220,26 @@ export function visitBlock(
 
     const hoistedSymbols = new DeclaredSymbols();
 
+    // Captured bindings live in the block's environment record
+    code += this.getEnvironmentDeclaration(node);
+
+    // A captured catch variable moves from the C++ local declared before the block into its slot
+    if (
+        ts.isCatchClause(node.parent) && node.parent.variableDeclaration &&
+        ts.isIdentifier(node.parent.variableDeclaration.name)
+    ) {
+        const varName = node.parent.variableDeclaration.name.text;
+        const typeInfo = this.typeAnalyzer.scopeManager.lookupFromScope(
+            varName,
+            this.getScopeForNode(node),
+        );
+        if (typeInfo?.needsHeapAllocation) {
+            code += `${this.indent()}${
+                this.getHeapSlot(typeInfo)
+            } = ${varName};\n`;
+        }
+    }
+
     // 1. Hoist all function declarations
     funcDecls.forEach((func) => {
         code += this.hoistDeclaration(func, hoistedSymbols, node);
@@ -293,7 +321,6 @@ export function visitBlock(
             {
                 isAssignment: true,
                 nativeName,
-                noTypeSignature: true,
             },
         );
 
@@ -309,7 +336,13 @@ export function visitBlock(
             this.isDeclarationUsedBeforeInitialization(funcName, node)
         ) {
             const wrappedLambda = this.generateWrappedLambda(lambdaComps);
-            code += `${this.indent()}*${funcName} = ${wrappedLambda};\n`;
+            const funcType = this.typeAnalyzer.scopeManager.lookupFromScope(
+                funcName,
+                this.getScopeForNode(node),
+            );
+            code += `${this.indent()}${
+                this.getHeapSlot(funcType)
+            } = ${wrappedLambda};\n`;
         }
     });
 
@@ -407,7 +440,9 @@ export function visitEnumDeclaration(
         context.localScopeSymbols,
     );
 
-    const enumVar = typeInfo?.needsHeapAllocation ? `(*${name})` : name;
+    const enumVar = typeInfo?.needsHeapAllocation
+        ? `(${this.getHeapSlot(typeInfo)})`
+        : name;
 
     let code =
         `${this.indent()}${enumVar} = jspp::AnyValue::make_object({});\n`;
@@ -1090,41 +1125,30 @@ export function visitYieldExpression(
             );
 
             const varName = this.getJsVarName(expr as ts.Identifier);
-            code += `${this.indent()}auto ${iterableRef} = ${exprText};\n`;
-            if (context.isInsideAsyncFunction) {
+            if (!context.isInsideAsyncFunction) {
                 code +=
-                    `${this.indent()}auto ${iterator} = jspp::Access::get_object_async_iterator(${iterableRef}, ${varName});\n`;
+                    `${this.indent()}jspp::ForOfCursor ${iterator}(${exprText}, ${varName});\n`;
+                code += `${this.indent()}while (${iterator}.next()) {\n`;
+                this.indentationLevel++;
+                code += `${this.indent()}co_yield ${iterator}.value();\n`;
             } else {
+                code += `${this.indent()}auto ${iterableRef} = ${exprText};\n`;
                 code +=
-                    `${this.indent()}auto ${iterator} = jspp::Access::get_object_iterator(${iterableRef}, ${varName});\n`;
-            }
-            code +=
-                `${this.indent()}auto ${nextFunc} = ${iterator}.get_own_property("next");\n`;
-            if (context.isInsideAsyncFunction) {
+                    `${this.indent()}auto ${iterator} = jspp::Access::get_object_async_iterator(${iterableRef}, ${varName});\n`;
+                code +=
+                    `${this.indent()}auto ${nextFunc} = ${iterator}.get_own_property("next");\n`;
                 code +=
                     `${this.indent()}auto ${nextRes} = co_await ${nextFunc}.call(${iterator}, {}, "next");\n`;
-            } else {
                 code +=
-                    `${this.indent()}auto ${nextRes} = ${nextFunc}.call(${iterator}, {}, "next");\n`;
-            }
-            code +=
-                `${this.indent()}while (!jspp::is_truthy(${nextRes}.get_own_property("done"))) {\n`;
-            this.indentationLevel++;
-            if (context.isInsideAsyncFunction) {
+                    `${this.indent()}while (!jspp::is_truthy(${nextRes}.get_own_property("done"))) {\n`;
+                this.indentationLevel++;
                 code +=
                     `${this.indent()}co_yield co_await ${nextRes}.get_own_property("value");\n`;
-            } else {
-                code +=
-                    `${this.indent()}co_yield ${nextRes}.get_own_property("value");\n`;
-            }
-            if (context.isInsideAsyncFunction) {
                 code +=
                     `${this.indent()}${nextRes} = co_await ${nextFunc}.call(${iterator}, {}, "next");\n`;
-            } else {
-                code +=
-                    `${this.indent()}${nextRes} = ${nextFunc}.call(${iterator}, {}, "next");\n`;
             }
-
+            this.indentationLevel--;
+            code += `${this.indent()}}\n`;
             this.indentationLevel--;
             code += `${this.indent()}}\n`;
 
@@ -1219,7 +1243,7 @@ export function visitReturnStatement(
 
             const exprReturnType = this.typeAnalyzer.inferNodeReturnType(expr);
             if (
-                exprReturnType === "number" &&
+                exprReturnType === "number" && !typeInfo.isNumeric &&
                 context.isInsideNativeLambda &&
                 context.isInsideFunction
             ) {
@@ -7,6 +7,8 @@
 #include "values/array.hpp"
 #include "values/function.hpp"
 #include "values/promise.hpp"
+#include "values/map.hpp"
+#include "values/set.hpp"
 #include "values/symbol.hpp"
 #include "values/descriptors.hpp"
 #include "exception.hpp"
@@ -18,17 +20,17 @@ namespace jspp
 
     bool AnyValue::operator==(const AnyValue &other) const noexcept
     {
-        return storage == other.storage;
+        return identity() == other.identity();
     }
     bool AnyValue::operator==(const std::string &other) const noexcept
     {
         if (!is_string())
             return false;
-        return as_string()->value == other;
+        return as_string()->value() == other;
     }
     bool AnyValue::operator<(const AnyValue &other) const noexcept
     {
-        return storage < other.storage;
+        return identity() < other.identity();
     }
 
     JsString *AnyValue::as_string() const noexcept { return static_cast<JsString *>(get_ptr()); }
@@ -37,6 +39,8 @@ namespace jspp
     JsFunction *AnyValue::as_function() const noexcept { return static_cast<JsFunction *>(get_ptr()); }
     JsSymbol *AnyValue::as_symbol() const noexcept { return static_cast<JsSymbol *>(get_ptr()); }
     JsPromise *AnyValue::as_promise() const noexcept { return static_cast<JsPromise *>(get_ptr()); }
+    JsMap *AnyValue::as_map() const noexcept { return static_cast<JsMap *>(get_ptr()); }
+    JsSet *AnyValue::as_set() const noexcept { return static_cast<JsSet *>(get_ptr()); }
     DataDescriptor *AnyValue::as_data_descriptor() const noexcept { return static_cast<DataDescriptor *>(get_ptr()); }
     AccessorDescriptor *AnyValue::as_accessor_descriptor() const noexcept { return static_cast<AccessorDescriptor *>(get_ptr()); }
 
@@ -45,8 +49,16 @@ namespace jspp
     // --- AnyValue FACTORIES ---
     AnyValue AnyValue::make_string(const std::string &raw_s) noexcept
     {
+        if (raw_s.size() <= 1)
+            return raw_s.empty() ? JsString::empty() : JsString::from_char(static_cast<unsigned char>(raw_s[0]));
         return from_ptr(new JsString(raw_s));
     }
+    AnyValue AnyValue::make_string(std::string &&raw_s) noexcept
+    {
+        if (raw_s.size() <= 1)
+            return raw_s.empty() ? JsString::empty() : JsString::from_char(static_cast<unsigned char>(raw_s[0]));
+        return from_ptr(new JsString(std::move(raw_s)));
+    }
     AnyValue AnyValue::make_object(std::initializer_list<std::pair<std::string, AnyValue>> props) noexcept
     {
         return from_ptr(new JsObject(props, make_null()));
@@ -55,6 +67,16 @@ namespace jspp
     {
         return from_ptr(new JsObject(props, make_null()));
     }
+    AnyValue AnyValue::make_iterator_result(AnyValue value, bool done) noexcept
+    {
+        static Shape *const result_shape = Shape::empty_shape()->transition("value")->transition("done");
+        auto *object = new JsObject();
+        object->shape = result_shape;
+        object->storage.reserve(2);
+        object->storage.push_back(std::move(value));
+        object->storage.push_back(make_boolean(done));
+        return from_ptr(object);
+    }
     AnyValue AnyValue::make_array(std::span<const AnyValue> dense) noexcept
     {
         std::vector<AnyValue> vec;
@@ -71,44 +93,34 @@ namespace jspp
     {
         return from_ptr(new JsArray(std::move(dense)));
     }
-    AnyValue AnyValue::make_function(const JsFunctionCallable &call, const std::optional<std::string> &name, bool is_constructor) noexcept
+    AnyValue AnyValue::make_function(JsFunctionCallable call, const char *name, bool is_constructor) noexcept
     {
-        auto v = from_ptr(new JsFunction(call, name, {}, {}, false, is_constructor));
-        auto proto = make_object({});
-        proto.define_data_property("constructor", AnyValue::make_data_descriptor(v, true, false, false));
-        v.define_data_property("prototype", AnyValue::make_data_descriptor(proto, false, false, false));
+        auto v = from_ptr(new JsFunction(std::move(call), name, false, is_constructor));
+        v.as_function()->lazy_prototype = true;
         return v;
     }
-    AnyValue AnyValue::make_class(const JsFunctionCallable &call, const std::optional<std::string> &name) noexcept
+    AnyValue AnyValue::make_class(JsFunctionCallable call, const char *name) noexcept
     {
-        auto v = from_ptr(new JsFunction(call, name, {}, {}, true));
-        auto proto = make_object({});
-        proto.define_data_property("constructor", AnyValue::make_data_descriptor(v, true, false, false));
-        v.define_data_property("prototype", AnyValue::make_data_descriptor(proto, false, false, false));
+        auto v = from_ptr(new JsFunction(std::move(call), name, true));
+        v.as_function()->lazy_prototype = true;
         return v;
     }
-    AnyValue AnyValue::make_generator(const JsFunctionCallable &call, const std::optional<std::string> &name) noexcept
+    AnyValue AnyValue::make_generator(JsFunctionCallable call, const char *name) noexcept
     {
-        auto v = from_ptr(new JsFunction(call, true, name, {}, {}, false));
-        auto proto = make_object({});
-        proto.define_data_property("constructor", AnyValue::make_data_descriptor(v, true, false, false));
-        v.define_data_property("prototype", AnyValue::make_data_descriptor(proto, false, false, false));
+        auto v = from_ptr(new JsFunction(std::move(call), true, name, false));
+        v.as_function()->lazy_prototype = true;
         return v;
     }
-    AnyValue AnyValue::make_async_function(const JsFunctionCallable &call, const std::optional<std::string> &name) noexcept
+    AnyValue AnyValue::make_async_function(JsFunctionCallable call, const char *name) noexcept
     {
-        auto v = from_ptr(new JsFunction(call, false, true, name, {}, {}, false));
-        auto proto = make_object({});
-        proto.define_data_property("constructor", AnyValue::make_data_descriptor(v, true, false, false));
-        v.define_data_property("prototype", AnyValue::make_data_descriptor(proto, false, false, false));
+        auto v = from_ptr(new JsFunction(std::move(call), false, true, name, false));
+        v.as_function()->lazy_prototype = true;
         return v;
     }
-    AnyValue AnyValue::make_async_generator(const JsFunctionCallable &call, const std::optional<std::string> &name) noexcept
+    AnyValue AnyValue::make_async_generator(JsFunctionCallable call, const char *name) noexcept
     {
-        auto v = from_ptr(new JsFunction(call, true, true, name, {}, {}, false));
-        auto proto = make_object({});
-        proto.define_data_property("constructor", AnyValue::make_data_descriptor(v, true, false, false));
-        v.define_data_property("prototype", AnyValue::make_data_descriptor(proto, false, false, false));
+        auto v = from_ptr(new JsFunction(std::move(call), true, true, name, false));
+        v.as_function()->lazy_prototype = true;
         return v;
     }
     AnyValue AnyValue::make_symbol(const std::string &description) noexcept
@@ -121,6 +133,14 @@ namespace jspp
         *p = promise;
         return from_ptr(p);
     }
+    AnyValue AnyValue::make_map() noexcept
+    {
+        return from_ptr(new JsMap());
+    }
+    AnyValue AnyValue::make_set() noexcept
+    {
+        return from_ptr(new JsSet());
+    }
     AnyValue AnyValue::make_data_descriptor(AnyValue value, bool writable, bool enumerable, bool configurable) noexcept
     {
         return from_ptr(new DataDescriptor(value, writable, enumerable, configurable));
@@ -237,6 +257,10 @@ namespace jspp
             return as_async_iterator()->to_std_string();
         case JsType::Promise:
             return as_promise()->to_std_string();
+        case JsType::Map:
+            return as_map()->to_std_string();
+        case JsType::Set:
+            return as_set()->to_std_string();
         case JsType::Symbol:
             return as_symbol()->to_std_string();
         case JsType::DataDescriptor:
@@ -265,36 +289,40 @@ namespace jspp
             as_array()->proto = proto;
         else if (is_function())
             as_function()->proto = proto;
+        else if (is_map())
+            as_map()->proto = proto;
+        else if (is_set())
+            as_set()->proto = proto;
         else if (is_uninitialized())
             Exception::throw_uninitialized_reference("#<Object>");
         return *this;
     }
 
-    AnyValue AnyValue::call(AnyValue thisVal, std::span<const AnyValue> args, const std::optional<std::string> &expr) const
+    AnyValue AnyValue::call(AnyValue thisVal, std::span<const AnyValue> args, const char *expr) const
     {
-        if (!is_function())
-            throw Exception::make_exception(expr.value_or(to_std_string()) + " is not a function", "TypeError");
+        if (!is_function()) [[unlikely]]
+            Exception::throw_not_a_function(expr ? std::string(expr) : to_std_string());
         return as_function()->call(thisVal, args);
     }
-    AnyValue AnyValue::optional_call(AnyValue thisVal, std::span<const AnyValue> args, const std::optional<std::string> &expr) const
+    AnyValue AnyValue::optional_call(AnyValue thisVal, std::span<const AnyValue> args, const char *expr) const
     {
         if (is_null() || is_undefined())
             return Constants::UNDEFINED;
         return as_function()->call(thisVal, args);
     }
 
-    AnyValue AnyValue::construct(std::span<const AnyValue> args, const std::optional<std::string> &name) const
+    AnyValue AnyValue::construct(std::span<const AnyValue> args, const char *name) const
     {
-        if (!is_function() || !as_function()->is_constructor)
+        if (!is_function() || !as_function()->is_constructor) [[unlikely]]
         {
-            throw Exception::make_exception(name.value_or(to_std_string()) + " is not a constructor", "TypeError");
+            Exception::throw_not_a_constructor(name ? std::string(name) : to_std_string());
         }
         AnyValue proto = get_own_property("prototype");
         if (!proto.is_object())
             proto = AnyValue::make_object({});
         AnyValue instance = AnyValue::make_object({}).set_prototype(proto);
         AnyValue result = call(instance, args);
-        if (result.is_object() || result.is_function() || result.is_array() || result.is_promise())
+        if (result.is_object() || result.is_function() || result.is_array() || result.is_promise() || result.is_map() || result.is_set())
             return result;
         return instance;
     }
@@ -330,10 +358,8 @@ namespace jspp
             }
             case JsType::Function:
             {
-                auto func = as_function();
-                auto it = func->symbol_props.find(key);
-                if (it != func->symbol_props.end())
-                    return it->second;
+                if (auto slot = as_function()->find_own_symbol_property(key))
+                    return *slot;
                 return Constants::UNDEFINED;
             }
             default:
@@ -347,11 +373,8 @@ namespace jspp
         case JsType::Object:
         {
             auto obj = as_object();
-            if (obj->deleted_keys.count(key_str))
-                return Constants::UNDEFINED;
-            auto offset = obj->shape->get_offset(key_str);
-            if (offset.has_value())
-                return obj->storage[offset.value()];
+            if (auto slot = obj->find_own_property(key_str))
+                return *slot;
             return Constants::UNDEFINED;
         }
         case JsType::Array:
@@ -373,21 +396,20 @@ namespace jspp
         }
         case JsType::Function:
         {
-            auto func = as_function();
-            if (func->props.count(key_str))
-                return func->props.at(key_str);
+            if (auto slot = as_function()->find_own_property(key_str))
+                return *slot;
             return Constants::UNDEFINED;
         }
         case JsType::String:
         {
             auto str = as_string();
             if (key_str == "length")
-                return AnyValue::make_number(str->value.length());
+                return AnyValue::make_number(str->length());
             if (JsArray::is_array_index(key_str))
             {
                 uint32_t idx = static_cast<uint32_t>(std::stoull(key_str));
-                if (idx < str->value.length())
-                    return AnyValue::make_string(std::string(1, str->value[idx]));
+                if (idx < str->length())
+                    return JsString::from_char(static_cast<unsigned char>(str->value()[idx]));
             }
             return Constants::UNDEFINED;
         }
@@ -408,6 +430,10 @@ namespace jspp
             return as_function()->has_property(key);
         case JsType::Promise:
             return as_promise()->get_property(key, *this).is_undefined() == false;
+        case JsType::Map:
+            return as_map()->has_property(key);
+        case JsType::Set:
+            return as_set()->has_property(key);
         case JsType::Iterator:
             return static_cast<JsIterator<AnyValue> *>(get_ptr())->get_property(key, *this).is_undefined() == false;
         case JsType::AsyncIterator:
@@ -420,7 +446,7 @@ namespace jspp
             if (JsArray::is_array_index(key))
             {
                 uint32_t idx = static_cast<uint32_t>(std::stoull(key));
-                return idx < as_string()->value.length();
+                return idx < as_string()->value().length();
             }
             return StringPrototypes::get(key).has_value();
         case JsType::Number:
@@ -447,6 +473,10 @@ namespace jspp
                 return as_function()->has_symbol_property(key);
             case JsType::Promise:
                 return as_promise()->has_symbol_property(key);
+            case JsType::Map:
+                return as_map()->has_symbol_property(key);
+            case JsType::Set:
+                return as_set()->has_symbol_property(key);
             case JsType::Iterator:
                 return static_cast<JsIterator<AnyValue> *>(get_ptr())->has_symbol_property(key);
             case JsType::AsyncIterator:
@@ -495,6 +525,10 @@ namespace jspp
             return as_function()->get_property(key, receiver);
         case JsType::Promise:
             return as_promise()->get_property(key, receiver);
+        case JsType::Map:
+            return as_map()->get_property(key, receiver);
+        case JsType::Set:
+            return as_set()->get_property(key, receiver);
         case JsType::Iterator:
             return static_cast<JsIterator<AnyValue> *>(get_ptr())->get_property(key, receiver);
         case JsType::AsyncIterator:
@@ -540,6 +574,10 @@ namespace jspp
             return as_function()->get_symbol_property(key, receiver);
         case JsType::Promise:
             return as_promise()->get_symbol_property(key, receiver);
+        case JsType::Map:
+            return as_map()->get_symbol_property(key, receiver);
+        case JsType::Set:
+            return as_set()->get_symbol_property(key, receiver);
         case JsType::Iterator:
             return static_cast<JsIterator<AnyValue> *>(get_ptr())->get_symbol_property(key, receiver);
         case JsType::AsyncIterator:
@@ -595,6 +633,10 @@ namespace jspp
             return as_function()->set_property(key, value, *this);
         case JsType::Promise:
             return as_promise()->set_property(key, value, *this);
+        case JsType::Map:
+            return as_map()->set_property(key, value, *this);
+        case JsType::Set:
+            return as_set()->set_property(key, value, *this);
         case JsType::Undefined:
             throw Exception::make_exception("Cannot set properties of undefined (setting '" + key + "')", "TypeError");
         case JsType::Null:
@@ -632,6 +674,10 @@ namespace jspp
             return as_function()->set_symbol_property(key, value, *this);
         case JsType::Promise:
             return as_promise()->set_symbol_property(key, value, *this);
+        case JsType::Map:
+            return as_map()->set_symbol_property(key, value, *this);
+        case JsType::Set:
+            return as_set()->set_symbol_property(key, value, *this);
         case JsType::Iterator:
             return static_cast<JsIterator<AnyValue> *>(get_ptr())->set_symbol_property(key, value, *this);
         case JsType::AsyncIterator:
@@ -647,24 +693,35 @@ namespace jspp
 
     AnyValue AnyValue::call_own_property(const std::string &key, std::span<const AnyValue> args) const
     {
-        return get_own_property(key).call((*this), args, key);
+        return get_own_property(key).call((*this), args, key.c_str());
     }
     AnyValue AnyValue::call_own_property(uint32_t idx, std::span<const AnyValue> args) const
     {
-        if (is_array())
-            return as_array()->get_property(idx).call((*this), args, "[" + std::to_string(idx) + "]");
-        if (is_string())
-            return as_string()->get_property(idx).call((*this), args, "[" + std::to_string(idx) + "]");
+        if (is_array() || is_string())
+        {
+            AnyValue fn = is_array() ? as_array()->get_property(idx) : as_string()->get_property(idx);
+            if (!fn.is_function()) [[unlikely]]
+                Exception::throw_not_a_function("[" + std::to_string(idx) + "]");
+            return fn.call((*this), args);
+        }
         return call_own_property(std::to_string(idx), args);
     }
     AnyValue AnyValue::call_own_property(const AnyValue &key, std::span<const AnyValue> args) const
     {
-        if (key.is_number() && is_array())
-            return as_array()->get_property(key.as_double()).call((*this), args, "[" + key.to_std_string() + "]");
-        if (key.is_number() && is_string())
-            return as_string()->get_property(key.as_double()).call((*this), args, "[" + key.to_std_string() + "]");
+        if (key.is_number() && (is_array() || is_string()))
+        {
+            AnyValue fn = is_array() ? as_array()->get_property(key.as_double()) : as_string()->get_property(key.as_double());
+            if (!fn.is_function()) [[unlikely]]
+                Exception::throw_not_a_function("[" + key.to_std_string() + "]");
+            return fn.call((*this), args);
+        }
         if (key.is_symbol())
-            return get_own_symbol_property(key).call((*this), args, key.to_std_string());
+        {
+            AnyValue fn = get_own_symbol_property(key);
+            if (!fn.is_function()) [[unlikely]]
+                Exception::throw_not_a_function(key.to_std_string());
+            return fn.call((*this), args);
+        }
         return call_own_property(key.to_std_string(), args);
     }
 
@@ -674,18 +731,20 @@ namespace jspp
     {
         if (is_object())
         {
-            auto obj = as_object();
-            auto offset = obj->shape->get_offset(key);
-            if (offset.has_value())
-                obj->storage[offset.value()] = value;
-            else
-            {
-                obj->shape = obj->shape->transition(key);
-                obj->storage.push_back(value);
-            }
+            as_object()->put_own_property(key, value);
         }
         else if (is_function())
-            as_function()->props[key] = value;
+            as_function()->put_own_property(key, value);
+    }
+
+    void AnyValue::define_data_property(PropertyKey key, AnyValue value)
+    {
+        if (is_object())
+        {
+            as_object()->put_own_property(key, value);
+        }
+        else if (is_function())
+            as_function()->put_own_property(key.str(), value);
     }
 
     void AnyValue::define_data_property(const AnyValue &key, AnyValue value)
@@ -695,7 +754,7 @@ namespace jspp
             if (is_object())
                 as_object()->symbol_props[key] = value;
             else if (is_function())
-                as_function()->symbol_props[key] = value;
+                as_function()->put_own_symbol_property(key, value);
         }
         else
             define_data_property(key.to_std_string(), value);
@@ -711,10 +770,9 @@ namespace jspp
         if (is_object())
         {
             auto obj = as_object();
-            auto offset = obj->shape->get_offset(key);
-            if (offset.has_value())
+            if (auto slot = obj->find_own_property(key))
             {
-                auto &val = obj->storage[offset.value()];
+                auto &val = *slot;
                 if (val.is_accessor_descriptor())
                 {
                     auto desc = val.as_accessor_descriptor();
@@ -725,24 +783,23 @@ namespace jspp
                 {
                     auto getFunc = [getter](AnyValue thisVal, std::span<const AnyValue> args) -> AnyValue
                     { return getter.call(thisVal, args); };
-                    obj->storage[offset.value()] = AnyValue::make_accessor_descriptor(getFunc, std::nullopt, true, true);
+                    val = AnyValue::make_accessor_descriptor(getFunc, std::nullopt, true, true);
                 }
             }
             else
             {
                 auto getFunc = [getter](AnyValue thisVal, std::span<const AnyValue> args) -> AnyValue
                 { return getter.call(thisVal, args); };
-                obj->shape = obj->shape->transition(key);
-                obj->storage.push_back(AnyValue::make_accessor_descriptor(getFunc, std::nullopt, true, true));
+                obj->add_own_property(key, AnyValue::make_accessor_descriptor(getFunc, std::nullopt, true, true));
             }
         }
         else if (is_function())
         {
-            auto &props = as_function()->props;
-            auto it = props.find(key);
-            if (it != props.end() && it->second.is_accessor_descriptor())
+            auto func = as_function();
+            auto slot = func->find_own_property(key);
+            if (slot && slot->is_accessor_descriptor())
             {
-                auto desc = it->second.as_accessor_descriptor();
+                auto desc = slot->as_accessor_descriptor();
                 desc->get = [getter](AnyValue thisVal, std::span<const AnyValue> args) -> AnyValue
                 { return getter.call(thisVal, args); };
             }
@@ -750,7 +807,7 @@ namespace jspp
             {
                 auto getFunc = [getter](AnyValue thisVal, std::span<const AnyValue> args) -> AnyValue
                 { return getter.call(thisVal, args); };
-                props[key] = AnyValue::make_accessor_descriptor(getFunc, std::nullopt, true, true);
+                func->put_own_property(key, AnyValue::make_accessor_descriptor(getFunc, std::nullopt, true, true));
             }
         }
     }
@@ -763,7 +820,7 @@ namespace jspp
             if (is_object())
                 as_object()->symbol_props[key] = desc;
             else if (is_function())
-                as_function()->symbol_props[key] = desc;
+                as_function()->put_own_symbol_property(key, desc);
         }
         else
             define_data_property(key.to_std_string(), value, writable, enumerable, configurable);
@@ -779,7 +836,7 @@ namespace jspp
             if (is_object())
                 as_object()->symbol_props[key] = desc;
             else if (is_function())
-                as_function()->symbol_props[key] = desc;
+                as_function()->put_own_symbol_property(key, desc);
         }
         else
             define_getter(key.to_std_string(), getter);
@@ -790,10 +847,9 @@ namespace jspp
         if (is_object())
         {
             auto obj = as_object();
-            auto offset = obj->shape->get_offset(key);
-            if (offset.has_value())
+            if (auto slot = obj->find_own_property(key))
             {
-                auto &val = obj->storage[offset.value()];
+                auto &val = *slot;
                 if (val.is_accessor_descriptor())
                 {
                     auto desc = val.as_accessor_descriptor();
@@ -812,7 +868,7 @@ namespace jspp
                             return jspp::Constants::UNDEFINED;
                         return setter.call(thisVal, args);
                     };
-                    obj->storage[offset.value()] = AnyValue::make_accessor_descriptor(std::nullopt, setFunc, true, true);
+                    val = AnyValue::make_accessor_descriptor(std::nullopt, setFunc, true, true);
                 }
             }
             else
@@ -823,17 +879,16 @@ namespace jspp
                         return jspp::Constants::UNDEFINED;
                     return setter.call(thisVal, args);
                 };
-                obj->shape = obj->shape->transition(key);
-                obj->storage.push_back(AnyValue::make_accessor_descriptor(std::nullopt, setFunc, true, true));
+                obj->add_own_property(key, AnyValue::make_accessor_descriptor(std::nullopt, setFunc, true, true));
             }
         }
         else if (is_function())
         {
-            auto &props = as_function()->props;
-            auto it = props.find(key);
-            if (it != props.end() && it->second.is_accessor_descriptor())
+            auto func = as_function();
+            auto slot = func->find_own_property(key);
+            if (slot && slot->is_accessor_descriptor())
             {
-                auto desc = it->second.as_accessor_descriptor();
+                auto desc = slot->as_accessor_descriptor();
                 desc->set = [setter](AnyValue thisVal, std::span<const AnyValue> args) -> AnyValue
                 {
                     if (args.empty())
@@ -849,7 +904,7 @@ namespace jspp
                         return jspp::Constants::UNDEFINED;
                     return setter.call(thisVal, args);
                 };
-                props[key] = AnyValue::make_accessor_descriptor(std::nullopt, setFunc, true, true);
+                func->put_own_property(key, AnyValue::make_accessor_descriptor(std::nullopt, setFunc, true, true));
             }
         }
     }
@@ -868,7 +923,7 @@ namespace jspp
             if (is_object())
                 as_object()->symbol_props[key] = desc;
             else if (is_function())
-                as_function()->symbol_props[key] = desc;
+                as_function()->put_own_symbol_property(key, desc);
         }
         else
             define_setter(key.to_std_string(), setter);
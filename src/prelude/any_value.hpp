@@ -20,6 +20,7 @@
 
 #include "types.hpp"
 #include "values/non_values.hpp"
+#include "values/property_key.hpp"
 
 namespace jspp
 {
@@ -31,9 +32,10 @@ namespace jspp
     // Any value >= 0xFFFC000000000000 is a special tag.
     //
     // Tagging (bits 48-63):
-    // 0xFFFC: Pointer to HeapObject
+    // 0xFFFC: Pointer to HeapObject, holding a reference
     // 0xFFFD: Boolean (bit 0 is value)
-    // 0xFFFE: Special (Undefined, Null, Uninitialized)
+    // 0xFFFE: Pointer to an immortal HeapObject, borrowed (see AnyValue::immortal)
+    // 0xFFFF: Special (Undefined, Null, Uninitialized)
 
     class AnyValue
     {
@@ -43,7 +45,10 @@ namespace jspp
         static constexpr uint64_t TAG_BASE = 0xFFFC000000000000ULL;
         static constexpr uint64_t TAG_POINTER = 0xFFFC000000000000ULL;
         static constexpr uint64_t TAG_BOOLEAN = 0xFFFD000000000000ULL;
-        static constexpr uint64_t TAG_SPECIAL = 0xFFFE000000000000ULL;
+        static constexpr uint64_t TAG_BORROWED = 0xFFFE000000000000ULL;
+        static constexpr uint64_t TAG_SPECIAL = 0xFFFF000000000000ULL;
+        // The two pointer tags differ only in the bit this mask clears
+        static constexpr uint64_t HEAP_TAG_MASK = 0xFFFD000000000000ULL;
 
         static constexpr uint64_t VAL_UNDEFINED = 0x1ULL;
         static constexpr uint64_t VAL_NULL = 0x2ULL;
@@ -57,6 +62,12 @@ namespace jspp
             return (storage & TAG_MASK) == tag;
         }
 
+        // The bits with a borrowed pointer retagged as counted, so both compare equal
+        inline uint64_t identity() const noexcept
+        {
+            return is_heap_object() ? (TAG_POINTER | (storage & PAYLOAD_MASK)) : storage;
+        }
+
     public:
         inline HeapObject *get_ptr() const noexcept
         {
@@ -81,7 +92,7 @@ namespace jspp
         explicit AnyValue(bool b) noexcept : storage(TAG_BOOLEAN | (b ? 1 : 0)) {}
         AnyValue(const AnyValue &other) noexcept : storage(other.storage)
         {
-            if (is_heap_object())
+            if (holds_reference())
                 get_ptr()->ref();
         }
         AnyValue(AnyValue &&other) noexcept : storage(other.storage)
@@ -90,7 +101,7 @@ namespace jspp
         }
         ~AnyValue()
         {
-            if (is_heap_object())
+            if (holds_reference())
                 get_ptr()->deref();
         }
 
@@ -99,10 +110,10 @@ namespace jspp
         {
             if (this != &other)
             {
-                if (is_heap_object())
+                if (holds_reference())
                     get_ptr()->deref();
                 storage = other.storage;
-                if (is_heap_object())
+                if (holds_reference())
                     get_ptr()->ref();
             }
             return *this;
@@ -111,7 +122,7 @@ namespace jspp
         {
             if (this != &other)
             {
-                if (is_heap_object())
+                if (holds_reference())
                     get_ptr()->deref();
                 storage = other.storage;
                 other.storage = TAG_SPECIAL | VAL_UNDEFINED;
@@ -120,7 +131,7 @@ namespace jspp
         }
         AnyValue &operator=(double val) noexcept
         {
-            if (is_heap_object())
+            if (holds_reference())
                 get_ptr()->deref();
             std::memcpy(&storage, &val, 8);
             if (storage >= TAG_BASE) [[unlikely]]
@@ -181,18 +192,23 @@ namespace jspp
         }
 
         static AnyValue make_string(const std::string &raw_s) noexcept;
+        static AnyValue make_string(std::string &&raw_s) noexcept;
         static AnyValue make_object(std::initializer_list<std::pair<std::string, AnyValue>> props) noexcept;
         static AnyValue make_object(const std::map<std::string, AnyValue> &props) noexcept;
+        // A `{ value, done }` iterator result, built straight into its final shape
+        static AnyValue make_iterator_result(AnyValue value, bool done) noexcept;
         static AnyValue make_array(std::span<const AnyValue> dense) noexcept;
         static AnyValue make_array(const std::vector<AnyValue> &dense) noexcept;
         static AnyValue make_array(std::vector<AnyValue> &&dense) noexcept;
-        static AnyValue make_function(const JsFunctionCallable &call, const std::optional<std::string> &name = std::nullopt, bool is_constructor = true) noexcept;
-        static AnyValue make_class(const JsFunctionCallable &call, const std::optional<std::string> &name = std::nullopt) noexcept;
-        static AnyValue make_generator(const JsFunctionCallable &call, const std::optional<std::string> &name = std::nullopt) noexcept;
-        static AnyValue make_async_function(const JsFunctionCallable &call, const std::optional<std::string> &name = std::nullopt) noexcept;
-        static AnyValue make_async_generator(const JsFunctionCallable &call, const std::optional<std::string> &name = std::nullopt) noexcept;
+        static AnyValue make_function(JsFunctionCallable call, const char *name = nullptr, bool is_constructor = true) noexcept;
+        static AnyValue make_class(JsFunctionCallable call, const char *name = nullptr) noexcept;
+        static AnyValue make_generator(JsFunctionCallable call, const char *name = nullptr) noexcept;
+        static AnyValue make_async_function(JsFunctionCallable call, const char *name = nullptr) noexcept;
+        static AnyValue make_async_generator(JsFunctionCallable call, const char *name = nullptr) noexcept;
         static AnyValue make_symbol(const std::string &description = "") noexcept;
         static AnyValue make_promise(const JsPromise &promise) noexcept;
+        static AnyValue make_map() noexcept;
+        static AnyValue make_set() noexcept;
         static AnyValue make_data_descriptor(AnyValue value, bool writable, bool enumerable, bool configurable) noexcept;
         static AnyValue make_accessor_descriptor(const std::optional<std::function<AnyValue(AnyValue, std::span<const AnyValue>)>> &get,
                                                  const std::optional<std::function<AnyValue(AnyValue, std::span<const AnyValue>)>> &set,
@@ -215,6 +231,25 @@ namespace jspp
             return v;
         }
 
+        // Keeps the target of `value` alive for the rest of the program by never releasing
+        // its reference, and returns a borrowed pointer to it. Copying or destroying a
+        // borrowed pointer leaves the target's count alone, so constants such as the
+        // module literal table are handed out without refcount writes. Non-heap values
+        // are returned unchanged.
+        static AnyValue immortal(AnyValue value) noexcept
+        {
+            if (value.holds_reference())
+                value.storage = TAG_BORROWED | (value.storage & PAYLOAD_MASK);
+            return value;
+        }
+
+        // Drops the reference without touching the target's count. Only the cycle
+        // collector uses this, for edges whose counts trial deletion already removed.
+        void forget() noexcept
+        {
+            storage = TAG_SPECIAL | VAL_UNDEFINED;
+        }
+
         static AnyValue resolve_property_for_read(const AnyValue &val, AnyValue thisVal, const std::string &propName) noexcept;
         static AnyValue resolve_property_for_write(AnyValue &val, AnyValue thisVal, const AnyValue &new_val, const std::string &propName);
 
@@ -237,7 +272,9 @@ namespace jspp
         }
 
         inline bool is_number() const noexcept { return storage < TAG_BASE; }
-        inline bool is_heap_object() const noexcept { return has_tag(TAG_POINTER); }
+        inline bool is_heap_object() const noexcept { return (storage & HEAP_TAG_MASK) == TAG_POINTER; }
+        // A heap pointer that owns a count; borrowed pointers to immortal objects do not
+        inline bool holds_reference() const noexcept { return has_tag(TAG_POINTER); }
         inline bool is_string() const noexcept { return is_heap_object() && get_ptr()->get_heap_type() == JsType::String; }
         inline bool is_object() const noexcept { return is_heap_object() && get_ptr()->get_heap_type() == JsType::Object; }
         inline bool is_array() const noexcept { return is_heap_object() && get_ptr()->get_heap_type() == JsType::Array; }
@@ -252,6 +289,8 @@ namespace jspp
         inline bool is_data_descriptor() const noexcept { return is_heap_object() && get_ptr()->get_heap_type() == JsType::DataDescriptor; }
         inline bool is_accessor_descriptor() const noexcept { return is_heap_object() && get_ptr()->get_heap_type() == JsType::AccessorDescriptor; }
         inline bool is_async_iterator() const noexcept { return is_heap_object() && get_ptr()->get_heap_type() == JsType::AsyncIterator; }
+        inline bool is_map() const noexcept { return is_heap_object() && get_ptr()->get_heap_type() == JsType::Map; }
+        inline bool is_set() const noexcept { return is_heap_object() && get_ptr()->get_heap_type() == JsType::Set; }
 
         JsString *as_string() const noexcept;
         JsObject *as_object() const noexcept;
@@ -261,6 +300,8 @@ namespace jspp
         JsPromise *as_promise() const noexcept;
         JsIterator<AnyValue> *as_iterator() const noexcept;
         JsAsyncIterator<AnyValue> *as_async_iterator() const noexcept;
+        JsMap *as_map() const noexcept;
+        JsSet *as_set() const noexcept;
         DataDescriptor *as_data_descriptor() const noexcept;
         AccessorDescriptor *as_accessor_descriptor() const noexcept;
 
@@ -288,6 +329,7 @@ namespace jspp
         AnyValue get_own_property(const char *key) const { return get_own_property(std::string(key)); }
         AnyValue get_own_property(uint32_t idx) const;
         AnyValue get_own_property(int idx) const { return get_own_property(static_cast<uint32_t>(idx)); }
+        AnyValue get_own_property(double idx) const { return get_own_property(AnyValue(idx)); }
         AnyValue get_own_property(const AnyValue &key) const;
         AnyValue get_own_symbol_property(const AnyValue &key) const;
 
@@ -299,6 +341,7 @@ namespace jspp
         AnyValue set_own_property(const char *key, AnyValue value) const { return set_own_property(std::string(key), value); }
         AnyValue set_own_property(uint32_t idx, AnyValue value) const;
         AnyValue set_own_property(int idx, AnyValue value) const { return set_own_property(static_cast<uint32_t>(idx), value); }
+        AnyValue set_own_property(double idx, AnyValue value) const { return set_own_property(AnyValue(idx), value); }
         AnyValue set_own_property(const AnyValue &key, AnyValue value) const;
         AnyValue set_own_symbol_property(const AnyValue &key, AnyValue value) const;
 
@@ -306,14 +349,17 @@ namespace jspp
         AnyValue call_own_property(const char *key, std::span<const AnyValue> args) const { return call_own_property(std::string(key), args); }
         AnyValue call_own_property(uint32_t idx, std::span<const AnyValue> args) const;
         AnyValue call_own_property(int idx, std::span<const AnyValue> args) const { return call_own_property(static_cast<uint32_t>(idx), args); }
+        AnyValue call_own_property(double idx, std::span<const AnyValue> args) const { return call_own_property(AnyValue(idx), args); }
         AnyValue call_own_property(const AnyValue &key, std::span<const AnyValue> args) const;
 
         void define_data_property(const std::string &key, AnyValue value);
-        void define_data_property(const char *key, AnyValue value) { define_data_property(std::string(key), value); }
+        void define_data_property(PropertyKey key, AnyValue value);
+        // C-string keys come from source literals, so they are interned like named access sites
+        void define_data_property(const char *key, AnyValue value) { define_data_property(PropertyKey(key), value); }
         void define_data_property(const AnyValue &key, AnyValue value);
         void define_data_property(const AnyValue &key, AnyValue value, bool writable, bool enumerable, bool configurable);
         void define_data_property(const std::string &key, AnyValue value, bool writable, bool enumerable, bool configurable);
-        void define_data_property(const char *key, AnyValue value, bool writable, bool enumerable, bool configurable) { define_data_property(std::string(key), value, writable, enumerable, configurable); }
+        void define_data_property(const char *key, AnyValue value, bool writable, bool enumerable, bool configurable) { define_data_property(PropertyKey(key), AnyValue::make_data_descriptor(value, writable, enumerable, configurable)); }
 
         void define_getter(const std::string &key, AnyValue getter);
         void define_getter(const char *key, AnyValue getter) { define_getter(std::string(key), getter); }
@@ -323,9 +369,10 @@ namespace jspp
         void define_setter(const char *key, AnyValue setter) { define_setter(std::string(key), setter); }
         void define_setter(const AnyValue &key, AnyValue setter);
 
-        AnyValue call(AnyValue thisVal, std::span<const AnyValue> args, const std::optional<std::string> &expr = std::nullopt) const;
-        AnyValue optional_call(AnyValue thisVal, std::span<const AnyValue> args, const std::optional<std::string> &expr = std::nullopt) const;
-        AnyValue construct(std::span<const AnyValue> args, const std::optional<std::string> &name = std::nullopt) const;
+        // `expr` is the callee's source text, a static string only read when building a TypeError
+        AnyValue call(AnyValue thisVal, std::span<const AnyValue> args, const char *expr = nullptr) const;
+        AnyValue optional_call(AnyValue thisVal, std::span<const AnyValue> args, const char *expr = nullptr) const;
+        AnyValue construct(std::span<const AnyValue> args, const char *name = nullptr) const;
         AnyValue &set_prototype(AnyValue proto);
         std::string to_std_string() const;
 
@@ -0,0 +1,316 @@
+#include "jspp.hpp"
+#include "cycle_collector.hpp"
+
+#include <chrono>
+#include <new>
+
+namespace jspp {
+
+namespace {
+
+// Traversal stack shared by the per-slot tracers below; traversals never nest.
+thread_local std::vector<HeapObject *> *work = nullptr;
+// Stack scan_black switches to; reserved along with `work`
+thread_local std::vector<HeapObject *> *black_work = nullptr;
+// Traced slots seen by measure_slot
+thread_local size_t edge_count = 0;
+
+inline HeapObject *traced_target(AnyValue &slot) noexcept
+{
+    // Borrowed pointers hold no count for trial deletion to subtract
+    if (!slot.holds_reference())
+        return nullptr;
+    HeapObject *target = slot.get_ptr();
+    return target->is_gc_traced() ? target : nullptr;
+}
+
+void mark_gray_slot(AnyValue &slot)
+{
+    if (HeapObject *target = traced_target(slot))
+    {
+        --target->ref_count;
+        if (target->gc_color != HeapObject::GC_GRAY)
+            work->push_back(target);
+    }
+}
+
+void scan_black_slot(AnyValue &slot)
+{
+    if (HeapObject *target = traced_target(slot))
+    {
+        ++target->ref_count;
+        if (target->gc_color != HeapObject::GC_BLACK)
+        {
+            target->gc_color = HeapObject::GC_BLACK;
+            work->push_back(target);
+        }
+    }
+}
+
+void push_slot(AnyValue &slot)
+{
+    if (HeapObject *target = traced_target(slot))
+        work->push_back(target);
+}
+
+void measure_slot(AnyValue &slot)
+{
+    if (HeapObject *target = traced_target(slot))
+    {
+        ++edge_count;
+        if (target->gc_color != HeapObject::GC_GRAY)
+        {
+            target->gc_color = HeapObject::GC_GRAY;
+            work->push_back(target);
+        }
+    }
+}
+
+void forget_slot(AnyValue &slot)
+{
+    if (traced_target(slot))
+        slot.forget();
+}
+
+// Lists every object reachable from the candidates in `reached`, graying them as it
+// goes, and returns the number of traced edges between them. Only this pass
+// allocates; the ones after it run in space reserved from its counts.
+size_t measure(const std::vector<HeapObject *> &candidates, std::vector<HeapObject *> &reached)
+{
+    edge_count = 0;
+    work = &reached;
+    for (HeapObject *obj : candidates)
+    {
+        if (obj->gc_color != HeapObject::GC_GRAY)
+        {
+            obj->gc_color = HeapObject::GC_GRAY;
+            reached.push_back(obj);
+        }
+    }
+    for (size_t i = 0; i < reached.size(); ++i)
+        reached[i]->trace(measure_slot);
+    work = nullptr;
+    return edge_count;
+}
+
+// Subtracts every reference internal to the subgraph under `root`
+void mark_gray(HeapObject *root)
+{
+    work->push_back(root);
+    while (!work->empty())
+    {
+        HeapObject *obj = work->back();
+        work->pop_back();
+        if (obj->gc_color == HeapObject::GC_GRAY)
+            continue;
+        obj->gc_color = HeapObject::GC_GRAY;
+        obj->trace(mark_gray_slot);
+    }
+}
+
+// Restores the counts of everything reachable from an externally referenced object
+void scan_black(HeapObject *root)
+{
+    std::vector<HeapObject *> *outer = work;
+    std::vector<HeapObject *> &stack = *black_work;
+    work = &stack;
+    root->gc_color = HeapObject::GC_BLACK;
+    stack.push_back(root);
+    while (!stack.empty())
+    {
+        HeapObject *obj = stack.back();
+        stack.pop_back();
+        obj->trace(scan_black_slot);
+    }
+    work = outer;
+}
+
+void scan(HeapObject *root)
+{
+    work->push_back(root);
+    while (!work->empty())
+    {
+        HeapObject *obj = work->back();
+        work->pop_back();
+        if (obj->gc_color != HeapObject::GC_GRAY)
+            continue;
+        if (obj->ref_count > 0)
+        {
+            scan_black(obj);
+        }
+        else
+        {
+            obj->gc_color = HeapObject::GC_WHITE;
+            obj->trace(push_slot);
+        }
+    }
+}
+
+// Gathers the white objects under `root`; buffered ones are gathered from their own root
+size_t collect_white(HeapObject *root, std::vector<HeapObject *> &garbage)
+{
+    size_t found = 0;
+    work->push_back(root);
+    while (!work->empty())
+    {
+        HeapObject *obj = work->back();
+        work->pop_back();
+        if (obj->gc_color != HeapObject::GC_WHITE || obj->gc_buffered)
+            continue;
+        obj->gc_color = HeapObject::GC_BLACK;
+        garbage.push_back(obj);
+        ++found;
+        obj->trace(push_slot);
+    }
+    return found;
+}
+
+} // namespace
+
+void CycleCollector::buffer_root(const HeapObject *obj)
+{
+    if (!state.roots)
+        state.roots = new std::vector<HeapObject *>();
+    obj->gc_buffered = true;
+    state.roots->push_back(const_cast<HeapObject *>(obj));
+}
+
+size_t CycleCollector::buffered_roots() noexcept
+{
+    return state.roots ? state.roots->size() : 0;
+}
+
+void CycleCollector::collect() noexcept
+{
+    if (state.collecting || state.destroying > 0)
+        return;
+    state.allocations = 0;
+    if (!state.roots || state.roots->empty())
+        return;
+
+    auto start = std::chrono::steady_clock::now();
+    state.collecting = true;
+    size_t roots_scanned = state.roots->size();
+
+    // Roots whose count reached zero are garbage already. Free them before tracing:
+    // they can share state with live objects (a promise's resolve functions share its
+    // state), and trace hooks skip state that is not solely theirs. Anything their
+    // destruction buffers is appended and handled in the same pass.
+    {
+        DestroyScope scope;
+        std::vector<HeapObject *> &pending = *state.roots;
+        size_t live = 0;
+        for (size_t i = 0; i < pending.size(); ++i)
+        {
+            HeapObject *obj = pending[i];
+            if (obj->gc_color == HeapObject::GC_BLACK && obj->ref_count == 0)
+                delete obj;
+            else
+                pending[live++] = obj;
+        }
+        pending.resize(live);
+    }
+
+    // Objects buffered while garbage is being freed go to a fresh buffer
+    std::vector<HeapObject *> roots;
+    roots.swap(*state.roots);
+
+    std::vector<HeapObject *> candidates;
+    std::vector<HeapObject *> reached;
+    std::vector<HeapObject *> stack;
+    std::vector<HeapObject *> black_stack;
+    std::vector<HeapObject *> garbage;
+    try
+    {
+        candidates.reserve(roots.size());
+        for (HeapObject *obj : roots)
+        {
+            if (obj->gc_color == HeapObject::GC_PURPLE && obj->ref_count > 0)
+                candidates.push_back(obj);
+        }
+
+        // Every traversal below pushes at most one entry per edge plus one per root,
+        // and scan_black at most one per object
+        size_t edges = measure(candidates, reached);
+        stack.reserve(edges + candidates.size());
+        black_stack.reserve(reached.size() + 1);
+        garbage.reserve(reached.size());
+    }
+    catch (const std::bad_alloc &)
+    {
+        // Nothing has been subtracted yet: undo the graying and retry next time
+        work = nullptr;
+        for (HeapObject *obj : reached)
+            obj->gc_color = HeapObject::GC_BLACK;
+        for (HeapObject *obj : candidates)
+            obj->gc_color = HeapObject::GC_PURPLE;
+        roots.swap(*state.roots);
+        state.collecting = false;
+        return;
+    }
+    for (HeapObject *obj : reached)
+        obj->gc_color = HeapObject::GC_BLACK;
+    for (HeapObject *obj : candidates)
+        obj->gc_color = HeapObject::GC_PURPLE;
+
+    for (HeapObject *obj : roots)
+    {
+        if (obj->gc_color != HeapObject::GC_PURPLE || obj->ref_count == 0)
+            obj->gc_buffered = false;
+    }
+
+    work = &stack;
+    black_work = &black_stack;
+    // A candidate already grayed from an earlier one is handled as part of its subgraph
+    size_t kept = 0;
+    for (HeapObject *obj : candidates)
+    {
+        if (obj->gc_color == HeapObject::GC_PURPLE)
+        {
+            mark_gray(obj);
+            candidates[kept++] = obj;
+        }
+        else
+        {
+            obj->gc_buffered = false;
+        }
+    }
+    candidates.resize(kept);
+
+    for (HeapObject *obj : candidates)
+        scan(obj);
+
+    uint64_t cycles = 0;
+    for (HeapObject *obj : candidates)
+    {
+        obj->gc_buffered = false;
+        if (collect_white(obj, garbage) > 0)
+            ++cycles;
+    }
+    work = nullptr;
+    black_work = nullptr;
+
+    // Trial deletion already removed the counts behind every traced edge out of the
+    // garbage, so drop those edges before destruction instead of decrementing again.
+    for (HeapObject *obj : garbage)
+        obj->trace(forget_slot);
+    {
+        DestroyScope scope;
+        for (HeapObject *obj : garbage)
+            delete obj;
+    }
+
+    state.collecting = false;
+    auto pause = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+    Stats &s = state.stats;
+    ++s.collections;
+    s.roots_scanned += roots_scanned;
+    s.cycles_collected += cycles;
+    s.objects_collected += garbage.size();
+    s.last_pause_ns = pause;
+    s.total_pause_ns += pause;
+    s.max_pause_ns = std::max(s.max_pause_ns, pause);
+}
+
+}
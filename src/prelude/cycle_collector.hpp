@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace jspp
+{
+    struct HeapObject;
+    class AnyValue;
+
+    // Per-slot callback handed to HeapObject::trace
+    using HeapTracer = void (*)(AnyValue &slot);
+
+    // Synchronous trial-deletion cycle collector (Bacon & Rajan, "Concurrent Cycle
+    // Collection in Reference Counted Systems", synchronous variant).
+    //
+    // Every decrement that leaves a traced object alive buffers it as a possible root.
+    // Once enough allocations have happened since the last run, the next allocation
+    // collects: the subgraph under the buffered roots has its internal references
+    // subtracted, anything still referenced from outside is restored, and what is left
+    // is garbage held together only by cycles. References the trace hooks cannot see
+    // (for example values a lambda captures by copy rather than through a Closure)
+    // are never subtracted, so they conservatively keep their targets alive.
+    //
+    // Buffering follows the count of the object itself: releasing a handle to an
+    // environment record buffers the record, never the values stored in it.
+    class CycleCollector
+    {
+    public:
+        static constexpr uint64_t ALLOCATION_THRESHOLD = 32 * 1024;
+
+        struct Stats
+        {
+            uint64_t collections = 0;
+            uint64_t roots_scanned = 0;
+            uint64_t cycles_collected = 0;  // garbage components, counted once per root that reached them
+            uint64_t objects_collected = 0;
+            uint64_t total_pause_ns = 0;
+            uint64_t last_pause_ns = 0;
+            uint64_t max_pause_ns = 0;
+        };
+
+        // Runs a collection unless one is in progress or an object is being destroyed.
+        // All traversal space is reserved before any count is touched; if that fails
+        // the roots stay buffered for the next attempt.
+        static void collect() noexcept;
+        static void buffer_root(const HeapObject *obj);
+        static size_t buffered_roots() noexcept;
+
+        static void on_allocation() noexcept
+        {
+            if (++state.allocations >= ALLOCATION_THRESHOLD) [[unlikely]]
+                collect();
+        }
+
+        // Counters for the calling thread
+        static const Stats &stats() noexcept { return state.stats; }
+
+        // Suppresses collection while a destructor runs: containers of live objects can be
+        // mid-mutation there, and tracing them would read destroyed slots.
+        struct DestroyScope
+        {
+            DestroyScope() noexcept { ++state.destroying; }
+            ~DestroyScope() { --state.destroying; }
+        };
+
+    private:
+        struct State
+        {
+            std::vector<HeapObject *> *roots; // never freed; globals still deref during static destruction
+            uint64_t allocations;
+            uint32_t destroying;
+            bool collecting;
+            Stats stats;
+        };
+
+        static thread_local State state;
+    };
+
+    inline thread_local constinit CycleCollector::State CycleCollector::state{};
+}
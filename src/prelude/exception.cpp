@@ -14,7 +14,7 @@ const char *Exception::what() const noexcept
 Exception Exception::make_exception(const std::string &message, const std::string &name)
 {
     std::vector<AnyValue> args = {AnyValue::make_string(message)};
-    AnyValue errorObj = ::Error.construct(args, name);
+    AnyValue errorObj = ::Error.construct(args, name.c_str());
     errorObj.define_data_property("name", AnyValue::make_string(name), true, false, true);
 
     return Exception(errorObj);
@@ -41,6 +41,18 @@ AnyValue Exception::throw_uninitialized_reference(const std::string &var_name)
 {
     throw Exception::make_exception("Cannot access '" + var_name + "' before initialization", "ReferenceError");
 }
+void Exception::throw_uninitialized_reference(const char *var_name)
+{
+    throw Exception::make_exception(std::string("Cannot access '") + var_name + "' before initialization", "ReferenceError");
+}
+AnyValue Exception::throw_not_a_function(const std::string &expr)
+{
+    throw Exception::make_exception(expr + " is not a function", "TypeError");
+}
+AnyValue Exception::throw_not_a_constructor(const std::string &expr)
+{
+    throw Exception::make_exception(expr + " is not a constructor", "TypeError");
+}
 AnyValue Exception::throw_immutable_assignment()
 {
     throw Exception::make_exception("Assignment to constant variable.", "TypeError");
@@ -22,6 +22,10 @@ namespace jspp
         // --- THROWERS
         static AnyValue throw_unresolved_reference(const std::string &var_name);
         static AnyValue throw_uninitialized_reference(const std::string &var_name);
+        // Out-of-line TDZ failure for deref helpers, so inlined reads keep only a compare and branch
+        [[noreturn, gnu::cold, gnu::noinline]] static void throw_uninitialized_reference(const char *var_name);
+        static AnyValue throw_not_a_function(const std::string &expr);
+        static AnyValue throw_not_a_constructor(const std::string &expr);
         static AnyValue throw_immutable_assignment();
         static AnyValue throw_invalid_return_statement();
     };
@@ -11,6 +11,7 @@
 #include "values/string.hpp"
 
 #include "any_value.hpp" // Must be before iterators for AnyValueAwaiter
+#include "utils/coroutine_args.hpp"
 #include "values/iterator.hpp"
 #include "values/async_iterator.hpp"
 
@@ -18,6 +19,8 @@
 #include "values/array.hpp"
 #include "values/function.hpp"
 #include "values/promise.hpp"
+#include "values/map.hpp"
+#include "values/set.hpp"
 #include "values/descriptors.hpp"
 #include "exception.hpp"
 #include "library/error.hpp"
@@ -30,6 +33,8 @@
 #include "values/prototypes/iterator.hpp"
 #include "values/prototypes/async_iterator.hpp"
 #include "values/prototypes/promise.hpp"
+#include "values/prototypes/map.hpp"
+#include "values/prototypes/set.hpp"
 #include "values/prototypes/string.hpp"
 #include "values/prototypes/number.hpp"
 #include "values/prototypes/boolean.hpp"
@@ -39,6 +44,9 @@
 #include "utils/operators.hpp"
 #include "utils/assignment_operators.hpp"
 #include "utils/access.hpp"
+#include "utils/environment.hpp"
+#include "utils/for_of.hpp"
+#include "utils/inline_cache.hpp"
 #include "utils/log_any_value/log_any_value.hpp"
 
 // js standard libraries
@@ -49,8 +57,11 @@
 #include "library/performance.hpp"
 #include "library/promise.hpp"
 #include "library/math.hpp"
+#include "library/json.hpp"
 #include "library/object.hpp"
 #include "library/array.hpp"
+#include "library/map.hpp"
+#include "library/set.hpp"
 #include "library/boolean.hpp"
 #include "library/global.hpp"
 
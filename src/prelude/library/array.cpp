@@ -3,7 +3,7 @@
 
 namespace jspp {
     jspp::AnyValue Array = jspp::AnyValue::make_class(
-        std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+        [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
     {
         if (args.size() == 1 && args[0].is_number()) {
             double len = args[0].as_double();
@@ -14,6 +14,8 @@ namespace jspp {
             auto arr_ptr = arr.as_array();
             arr_ptr->length = static_cast<uint64_t>(len);
             arr_ptr->dense.resize(static_cast<size_t>(len), jspp::Constants::UNINITIALIZED);
+            if (arr_ptr->length > 0)
+                arr_ptr->kind = jspp::ElementKind::Holey;
             return arr;
         }
         std::vector<jspp::AnyValue> elements;
@@ -21,31 +23,31 @@ namespace jspp {
             elements.push_back(arg);
         }
         return jspp::AnyValue::make_array(std::move(elements)); 
-    }), "Array");
+    }, "Array");
 
     struct ArrayInit
     {
         ArrayInit()
         {
             Array.define_data_property("isArray", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                 if (args.empty()) return jspp::Constants::FALSE;
                 return jspp::AnyValue::make_boolean(args[0].is_array()); 
-            }), "isArray"));
+            }, "isArray"));
 
             Array.define_data_property("of", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                 std::vector<jspp::AnyValue> elements;
                 for(const auto& arg : args) {
                     elements.push_back(arg);
                 }
                 return jspp::AnyValue::make_array(std::move(elements)); 
-            }), "of"));
+            }, "of"));
 
             Array.define_data_property("from", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                 if (args.empty() || args[0].is_null() || args[0].is_undefined()) {
                     throw jspp::Exception::make_exception("Array.from requires an array-like object", "TypeError");
@@ -59,15 +61,11 @@ namespace jspp {
 
                 auto iteratorSym = jspp::AnyValue::from_symbol(jspp::WellKnownSymbols::iterator);
                 if (items.has_property(iteratorSym)) {
-                    auto iter = jspp::Access::get_object_iterator(items, "Array.from source");
-                    auto nextFn = iter.get_own_property("next");
+                    jspp::ForOfCursor iter(items, "Array.from source");
                     
                     size_t k = 0;
-                    while (true) {
-                        auto nextRes = nextFn.call(iter, std::span<const jspp::AnyValue>{}, "next");
-                        if (jspp::is_truthy(nextRes.get_own_property("done"))) break;
-                        
-                        auto val = nextRes.get_own_property("value");
+                    while (iter.next()) {
+                        auto val = iter.value();
                         if (mapFn.is_function()) {
                             jspp::AnyValue kVal = jspp::AnyValue::make_number(k);
                             const jspp::AnyValue mapArgs[] = {val, kVal};
@@ -92,10 +90,10 @@ namespace jspp {
                 }
                 
                 return jspp::AnyValue::make_array(std::move(result)); 
-            }), "from"));
+            }, "from"));
 
             Array.define_data_property("fromAsync", jspp::AnyValue::make_async_function(
-                std::function<JsPromise(AnyValue, std::vector<AnyValue>)>([](jspp::AnyValue, std::vector<jspp::AnyValue> args) -> jspp::JsPromise
+                [](jspp::AnyValue, jspp::CoroutineArgs args) -> jspp::JsPromise
             {
                 if (args.empty() || args[0].is_null() || args[0].is_undefined()) {
                     throw jspp::Exception::make_exception("Array.fromAsync requires an iterable or array-like object", "TypeError");
@@ -163,7 +161,7 @@ namespace jspp {
                     }
                 }
                 co_return jspp::AnyValue::make_array(std::move(result)); 
-            }), "fromAsync"));
+            }, "fromAsync"));
 
             // Array[Symbol.species]
             Array.define_getter(jspp::AnyValue::from_symbol(jspp::WellKnownSymbols::species), jspp::AnyValue::make_function([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
@@ -5,11 +5,11 @@ namespace jspp
 {
     // TODO: implement boolean constructor
     jspp::AnyValue Boolean = jspp::AnyValue::make_function(
-        std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+        [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
                                                                      {
                                                                          if (args.empty())
                                                                              return jspp::Constants::FALSE;
-                                                                         return jspp::AnyValue::make_boolean(jspp::is_truthy(args[0])); }),
+                                                                         return jspp::AnyValue::make_boolean(jspp::is_truthy(args[0])); },
         "Boolean");
 
     struct BooleanInit
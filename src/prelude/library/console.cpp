@@ -45,7 +45,7 @@ namespace jspp {
         if (!console.is_undefined()) return;
 
         logFn = jspp::AnyValue::make_function(
-            std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args)
+            [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args)
             {
                 for (size_t i = 0; i < args.size(); ++i)
                 {
@@ -55,10 +55,10 @@ namespace jspp {
                 }
                 std::cout << "\n" << std::flush;
                 return jspp::Constants::UNDEFINED;
-            }), "log");
+            }, "log");
 
         warnFn = jspp::AnyValue::make_function(
-            std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args)
+            [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args)
             {
                 std::cerr << "\033[33m";
                 for (size_t i = 0; i < args.size(); ++i)
@@ -69,10 +69,10 @@ namespace jspp {
                 }
                 std::cerr << "\033[0m" << "\n" << std::flush;
                 return jspp::Constants::UNDEFINED;
-            }), "warn");
+            }, "warn");
 
         errorFn = jspp::AnyValue::make_function(
-            std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args)
+            [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args)
             {
                 std::cerr << "\033[31m";
                 for (size_t i = 0; i < args.size(); ++i)
@@ -83,19 +83,19 @@ namespace jspp {
                 }
                 std::cerr << "\033[0m" << "\n" << std::flush;
                 return jspp::Constants::UNDEFINED;
-            }), "error");
+            }, "error");
 
         timeFn = jspp::AnyValue::make_function(
-            std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args)
+            [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args)
             {
                 auto start = std::chrono::steady_clock::now();
                 auto key_str = args.size() > 0 ? args[0].to_std_string() : "default";
                 timers[key_str] = start;
                 return jspp::Constants::UNDEFINED;
-            }), "time");
+            }, "time");
 
         timeEndFn = jspp::AnyValue::make_function(
-            std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args)
+            [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args)
             {
                 auto end = std::chrono::steady_clock::now();
                 auto key_str = args.size() > 0 ? args[0].to_std_string() : "default";
@@ -112,7 +112,7 @@ namespace jspp {
                     std::cout << "Timer '" << key_str << "' does not exist.\n";
                 }
                 return jspp::Constants::UNDEFINED;
-            }), "timeEnd");
+            }, "timeEnd");
 
         console = jspp::AnyValue::make_object({
             {"log", logFn},
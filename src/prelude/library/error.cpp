@@ -49,7 +49,7 @@ namespace jspp
     };
 
     jspp::AnyValue isErrorFn = jspp::AnyValue::make_function(
-        std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+        [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
                                                                      {
         if (args.empty()) return jspp::Constants::FALSE;
         jspp::AnyValue val = args[0];
@@ -63,11 +63,11 @@ namespace jspp
                  else break;
             }
         }
-        return jspp::Constants::FALSE; }),
+        return jspp::Constants::FALSE; },
         "isError");
 
     jspp::AnyValue errorToStringFn = jspp::AnyValue::make_function(
-        std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+        [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
                                                                      {
         std::string name = "Error";
         std::string msg = "";
@@ -78,7 +78,7 @@ namespace jspp
         if (name.empty() && msg.empty()) return jspp::AnyValue::make_string("Error");
         if (name.empty()) return jspp::AnyValue::make_string(msg);
         if (msg.empty()) return jspp::AnyValue::make_string(name);
-        return jspp::AnyValue::make_string(name + ": " + msg); }),
+        return jspp::AnyValue::make_string(name + ": " + msg); },
         "toString");
 
     struct ErrorInit
@@ -86,7 +86,7 @@ namespace jspp
         ErrorInit()
         {
             Error = jspp::AnyValue::make_class(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>(errorConstructor), "Error");
+                errorConstructor, "Error");
             auto proto = Error.get_own_property("prototype");
             proto.define_data_property("toString", errorToStringFn, true, false, true);
             proto.define_data_property(jspp::AnyValue::from_symbol(jspp::WellKnownSymbols::toStringTag), errorToStringFn, true, false, true);
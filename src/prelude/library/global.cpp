@@ -15,22 +15,25 @@ namespace jspp {
         init_function_lib();
         init_object();
         init_array();
+        init_map();
+        init_set();
         init_error();
         init_promise();
         init_math();
+        init_json();
         init_console();
         init_boolean();
 
         // 2. Initialize functions and linking
-        GeneratorFunction = jspp::AnyValue::make_generator([](jspp::AnyValue, std::vector<jspp::AnyValue>) -> jspp::JsIterator<jspp::AnyValue>
+        GeneratorFunction = jspp::AnyValue::make_generator([](jspp::AnyValue, jspp::CoroutineArgs) -> jspp::JsIterator<jspp::AnyValue>
                                                                     { co_return jspp::Constants::UNDEFINED; })
                                         .get_own_property("prototype")
                                         .get_own_property("constructor");
-        AsyncFunction = jspp::AnyValue::make_async_function([](jspp::AnyValue, std::vector<jspp::AnyValue>) -> jspp::JsPromise
+        AsyncFunction = jspp::AnyValue::make_async_function([](jspp::AnyValue, jspp::CoroutineArgs) -> jspp::JsPromise
                                                                    { co_return jspp::Constants::UNDEFINED; })
                                     .get_own_property("prototype")
                                     .get_own_property("constructor");
-        AsyncGeneratorFunction = jspp::AnyValue::make_async_generator([](jspp::AnyValue, std::vector<jspp::AnyValue>) -> jspp::JsAsyncIterator<jspp::AnyValue>
+        AsyncGeneratorFunction = jspp::AnyValue::make_async_generator([](jspp::AnyValue, jspp::CoroutineArgs) -> jspp::JsAsyncIterator<jspp::AnyValue>
                                                                              { co_return jspp::Constants::UNDEFINED; })
                                              .get_own_property("prototype")
                                              .get_own_property("constructor");
@@ -51,8 +54,11 @@ namespace jspp {
             {"setInterval", setInterval},
             {"clearInterval", clearInterval},
             {"Math", jspp::Math},
+            {"JSON", jspp::JSON},
             {"Object", jspp::Object},
             {"Array", jspp::Array},
+            {"Map", jspp::Map},
+            {"Set", jspp::Set},
             {"Boolean", jspp::Boolean},
         });
 
@@ -65,12 +71,16 @@ namespace jspp {
         objectProto.define_data_property(toStringTagSym, jspp::AnyValue::make_string("Object"), true, false, true);
         functionProto.define_data_property(toStringTagSym, jspp::AnyValue::make_string("Function"), true, false, true);
         arrayProto.define_data_property(toStringTagSym, jspp::AnyValue::make_string("Array"), true, false, true);
+        ::Map.get_own_property("prototype").define_data_property(toStringTagSym, jspp::AnyValue::make_string("Map"), false, false, true);
+        ::Set.get_own_property("prototype").define_data_property(toStringTagSym, jspp::AnyValue::make_string("Set"), false, false, true);
 
         // Important: Link prototypes to Object.prototype
         arrayProto.set_prototype(objectProto);
         functionProto.set_prototype(objectProto);
         ::Error.get_own_property("prototype").set_prototype(objectProto);
         ::Promise.get_own_property("prototype").set_prototype(objectProto);
+        ::Map.get_own_property("prototype").set_prototype(objectProto);
+        ::Set.get_own_property("prototype").set_prototype(objectProto);
         ::Symbol.get_own_property("prototype").set_prototype(objectProto);
 
         auto generatorFunctionProto = GeneratorFunction.get_own_property("prototype");
@@ -87,6 +97,8 @@ namespace jspp {
 
         ::Object.set_prototype(functionProto);
         ::Array.set_prototype(functionProto);
+        ::Map.set_prototype(functionProto);
+        ::Set.set_prototype(functionProto);
         ::Function.set_prototype(functionProto);
         GeneratorFunction.set_prototype(functionProto);
         AsyncFunction.set_prototype(functionProto);
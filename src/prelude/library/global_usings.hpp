@@ -1,15 +1,21 @@
 #pragma once
 #include "library/console.hpp"
 #include "library/math.hpp"
+#include "library/json.hpp"
 #include "library/object.hpp"
 #include "library/array.hpp"
+#include "library/map.hpp"
+#include "library/set.hpp"
 #include "library/error.hpp"
 #include "library/promise.hpp"
 
 // Global usings for the transpiled code
 using jspp::console;
 using jspp::Math;
+using jspp::JSON;
 using jspp::Object;
 using jspp::Array;
+using jspp::Map;
+using jspp::Set;
 using jspp::Error;
 using jspp::Promise;
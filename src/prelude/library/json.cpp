@@ -0,0 +1,1043 @@
+#include "jspp.hpp"
+#include "library/json.hpp"
+#include <array>
+#include <charconv>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace jspp {
+    namespace Library {
+        // JSON.parse runs in two stages, after simdjson:
+        //
+        //   1. index_structurals() classifies the text 64 bytes at a time into bitmasks
+        //      (quotes, backslashes, structural characters, whitespace), resolves escapes
+        //      and string extents with carry-free bit arithmetic, and records the offset
+        //      of every token start: each `{}[]:,` outside a string, each opening quote
+        //      and the first byte of each number or literal.
+        //   2. JsonParser walks that index and builds values directly. It never looks at
+        //      whitespace and only touches string contents to copy them out.
+
+        constexpr size_t JSON_MAX_DEPTH = 5000;
+
+        // Nesting limit shared by parse and stringify, both of which recurse per level
+        inline void check_depth(size_t depth)
+        {
+            if (depth > JSON_MAX_DEPTH) [[unlikely]]
+                throw Exception::make_exception("Maximum call stack size exceeded", "RangeError");
+        }
+
+        struct JsonBlock
+        {
+            uint64_t backslash = 0;
+            uint64_t quote = 0;
+            uint64_t structural = 0;
+            uint64_t whitespace = 0;
+        };
+
+        inline bool is_json_whitespace(unsigned char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        inline bool is_json_structural(unsigned char c)
+        {
+            return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+        }
+
+        static JsonBlock classify_block(const unsigned char *p)
+        {
+            JsonBlock block;
+#if defined(__SSE2__)
+            for (int i = 0; i < 4; ++i)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * i));
+                auto eq = [v](char c)
+                { return _mm_cmpeq_epi8(v, _mm_set1_epi8(c)); };
+                auto bits = [](__m128i m)
+                { return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(m))); };
+
+                __m128i structural = _mm_or_si128(_mm_or_si128(_mm_or_si128(eq('{'), eq('}')), _mm_or_si128(eq('['), eq(']'))),
+                                                  _mm_or_si128(eq(':'), eq(',')));
+                __m128i whitespace = _mm_or_si128(_mm_or_si128(eq(' '), eq('\t')), _mm_or_si128(eq('\n'), eq('\r')));
+                int shift = 16 * i;
+                block.backslash |= bits(eq('\\')) << shift;
+                block.quote |= bits(eq('"')) << shift;
+                block.structural |= bits(structural) << shift;
+                block.whitespace |= bits(whitespace) << shift;
+            }
+#else
+            for (int i = 0; i < 64; ++i)
+            {
+                uint64_t bit = uint64_t(1) << i;
+                unsigned char c = p[i];
+                if (c == '\\')
+                    block.backslash |= bit;
+                else if (c == '"')
+                    block.quote |= bit;
+                else if (is_json_structural(c))
+                    block.structural |= bit;
+                else if (is_json_whitespace(c))
+                    block.whitespace |= bit;
+            }
+#endif
+            return block;
+        }
+
+        // Bits of characters escaped by a backslash. A run of backslashes escapes the
+        // character after it only if the run has odd length; `prev_escaped` carries
+        // a pending escape into the next block.
+        static uint64_t find_escaped(uint64_t backslash, uint64_t &prev_escaped)
+        {
+            constexpr uint64_t EVEN_BITS = 0x5555555555555555ULL;
+            backslash &= ~prev_escaped;
+            uint64_t follows_escape = (backslash << 1) | prev_escaped;
+            uint64_t odd_sequence_starts = backslash & ~EVEN_BITS & ~follows_escape;
+            uint64_t sequences_starting_on_even_bits;
+            prev_escaped = __builtin_add_overflow(odd_sequence_starts, backslash, &sequences_starting_on_even_bits) ? 1 : 0;
+            uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+            return (EVEN_BITS ^ invert_mask) & follows_escape;
+        }
+
+        // Each bit becomes the parity of all bits up to and including it, which turns
+        // quote positions into "inside a string" ranges (opening quote included).
+        static uint64_t prefix_xor(uint64_t bits)
+        {
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+            return bits;
+        }
+
+        // Stage 1. Returns false if the text ends inside a string.
+        static bool index_structurals(std::string_view text, std::vector<uint32_t> &index)
+        {
+            const auto *data = reinterpret_cast<const unsigned char *>(text.data());
+            size_t size = text.size();
+            index.resize(size / 8 + 64);
+            size_t count = 0;
+
+            uint64_t prev_escaped = 0;
+            uint64_t prev_in_string = 0;
+            uint64_t prev_scalar = 0;
+            unsigned char tail[64];
+
+            for (size_t base = 0; base < size; base += 64)
+            {
+                const unsigned char *block_ptr = data + base;
+                if (size - base < 64)
+                {
+                    // Pad the last block with whitespace, which never forms a token
+                    std::memset(tail, ' ', sizeof(tail));
+                    std::memcpy(tail, block_ptr, size - base);
+                    block_ptr = tail;
+                }
+                JsonBlock block = classify_block(block_ptr);
+
+                uint64_t escaped = find_escaped(block.backslash, prev_escaped);
+                uint64_t quotes = block.quote & ~escaped;
+                uint64_t in_string = prefix_xor(quotes) ^ prev_in_string;
+                prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+                uint64_t scalar = ~(block.structural | block.whitespace | block.quote | in_string);
+                uint64_t scalar_starts = scalar & ~((scalar << 1) | prev_scalar);
+                prev_scalar = scalar >> 63;
+
+                uint64_t tokens = (block.structural & ~in_string) | (quotes & in_string) | scalar_starts;
+
+                if (count + 64 > index.size())
+                    index.resize(index.size() * 2 + 64);
+                while (tokens)
+                {
+                    index[count++] = static_cast<uint32_t>(base + std::countr_zero(tokens));
+                    tokens &= tokens - 1;
+                }
+            }
+            index.resize(count);
+            return prev_in_string == 0;
+        }
+
+        // Offset of the first byte at or after `i` that ends a plain run of string
+        // content: a quote, a backslash, a control character, or (when escaping for
+        // output) the lead byte 0xED of a possibly unpaired surrogate.
+        template <bool StopAtSurrogateLead>
+        static size_t find_string_special(std::string_view s, size_t i)
+        {
+            const auto *p = reinterpret_cast<const unsigned char *>(s.data());
+            size_t n = s.size();
+#if defined(__SSE2__)
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i control_max = _mm_set1_epi8(0x1F);
+            const __m128i surrogate_lead = _mm_set1_epi8(static_cast<char>(0xED));
+            for (; i + 16 <= n; i += 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+                __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                            _mm_cmpeq_epi8(_mm_min_epu8(v, control_max), v));
+                if constexpr (StopAtSurrogateLead)
+                    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, surrogate_lead));
+                if (int mask = _mm_movemask_epi8(hits))
+                    return i + std::countr_zero(static_cast<unsigned>(mask));
+            }
+#endif
+            for (; i < n; ++i)
+            {
+                unsigned char c = p[i];
+                if (c == '"' || c == '\\' || c < 0x20 || (StopAtSurrogateLead && c == 0xED))
+                    return i;
+            }
+            return n;
+        }
+
+        static void append_utf8(std::string &out, uint32_t cp)
+        {
+            // Unpaired surrogates are kept as their 3-byte form so they survive a round trip
+            if (cp < 0x80)
+            {
+                out += static_cast<char>(cp);
+            }
+            else if (cp < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (cp >> 6));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            else if (cp < 0x10000)
+            {
+                out += static_cast<char>(0xE0 | (cp >> 12));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xF0 | (cp >> 18));
+                out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+
+        // Stage 2
+        class JsonParser
+        {
+        public:
+            explicit JsonParser(std::string_view text) : src(text) {}
+
+            AnyValue parse()
+            {
+                if (src.size() > UINT32_MAX)
+                    throw Exception::make_exception("Invalid string length", "RangeError");
+                if (!index_structurals(src, index))
+                    throw Exception::make_exception("Unterminated string in JSON at position " + std::to_string(src.size()), "SyntaxError");
+
+                AnyValue result = parse_value(0);
+                if (next < index.size())
+                    throw Exception::make_exception("Unexpected non-whitespace character after JSON at position " + std::to_string(index[next]), "SyntaxError");
+                return result;
+            }
+
+        private:
+            // Last transition taken out of a shape, keyed by the shape's address. Shapes are
+            // never freed, so entries stay valid across parses and an array of records with
+            // the same keys rebuilds each shape with one pointer and one string comparison
+            // per key instead of interning the key and searching the transition list.
+            struct TransitionCacheEntry
+            {
+                Shape *from = nullptr;
+                Shape *to = nullptr;
+            };
+            static constexpr size_t TRANSITION_CACHE_SIZE = 1024;
+
+            static std::array<TransitionCacheEntry, TRANSITION_CACHE_SIZE> &transition_cache()
+            {
+                static std::array<TransitionCacheEntry, TRANSITION_CACHE_SIZE> cache{};
+                return cache;
+            }
+
+            std::string_view src;
+            std::vector<uint32_t> index;
+            size_t next = 0;
+            // Elements and property values of every open container, innermost last
+            std::vector<AnyValue> stack;
+            std::string scratch;
+
+            [[noreturn]] void unexpected(size_t pos) const
+            {
+                if (pos >= src.size())
+                    throw Exception::make_exception("Unexpected end of JSON input", "SyntaxError");
+                throw Exception::make_exception(std::string("Unexpected token '") + src[pos] + "' in JSON at position " + std::to_string(pos), "SyntaxError");
+            }
+
+            size_t take()
+            {
+                if (next >= index.size())
+                    unexpected(src.size());
+                return index[next++];
+            }
+
+            char peek() const
+            {
+                return next < index.size() ? src[index[next]] : '\0';
+            }
+
+            // A number or literal must be followed by whitespace, a structural character,
+            // or the end of input; anything else is the rest of a malformed scalar.
+            bool ends_scalar(size_t pos) const
+            {
+                if (pos >= src.size())
+                    return true;
+                unsigned char c = src[pos];
+                return is_json_whitespace(c) || is_json_structural(c) || c == '"';
+            }
+
+            AnyValue parse_value(size_t depth)
+            {
+                size_t pos = take();
+                switch (src[pos])
+                {
+                case '{':
+                    return parse_object(depth + 1);
+                case '[':
+                    return parse_array(depth + 1);
+                case '"':
+                    return AnyValue::make_string(std::string(parse_string(pos)));
+                case 't':
+                    return parse_literal(pos, "true", Constants::TRUE);
+                case 'f':
+                    return parse_literal(pos, "false", Constants::FALSE);
+                case 'n':
+                    return parse_literal(pos, "null", Constants::Null);
+                default:
+                    return parse_number(pos);
+                }
+            }
+
+            AnyValue parse_literal(size_t pos, std::string_view word, const AnyValue &value)
+            {
+                if (src.compare(pos, word.size(), word) != 0 || !ends_scalar(pos + word.size()))
+                    unexpected(pos);
+                return value;
+            }
+
+            AnyValue parse_number(size_t pos)
+            {
+                const char *start = src.data() + pos;
+                const char *end = src.data() + src.size();
+                const char *p = start;
+                bool negative = p < end && *p == '-';
+                if (negative)
+                    ++p;
+
+                uint64_t mantissa = 0;
+                const char *digits = p;
+                if (p < end && *p == '0')
+                {
+                    ++p;
+                }
+                else
+                {
+                    while (p < end && *p >= '0' && *p <= '9')
+                        mantissa = mantissa * 10 + static_cast<uint64_t>(*p++ - '0');
+                }
+                if (p == digits)
+                    unexpected(static_cast<size_t>(p - src.data()));
+                size_t digit_count = static_cast<size_t>(p - digits);
+
+                bool integral = true;
+                if (p < end && *p == '.')
+                {
+                    integral = false;
+                    const char *frac = ++p;
+                    while (p < end && *p >= '0' && *p <= '9')
+                        ++p;
+                    if (p == frac)
+                        unexpected(static_cast<size_t>(p - src.data()));
+                }
+                if (p < end && (*p == 'e' || *p == 'E'))
+                {
+                    integral = false;
+                    ++p;
+                    if (p < end && (*p == '+' || *p == '-'))
+                        ++p;
+                    const char *exp = p;
+                    while (p < end && *p >= '0' && *p <= '9')
+                        ++p;
+                    if (p == exp)
+                        unexpected(static_cast<size_t>(p - src.data()));
+                }
+                if (!ends_scalar(static_cast<size_t>(p - src.data())))
+                    unexpected(static_cast<size_t>(p - src.data()));
+
+                // Up to 15 digits convert exactly without going through from_chars
+                if (integral && digit_count <= 15)
+                {
+                    double value = static_cast<double>(mantissa);
+                    return AnyValue::make_number(negative ? -value : value);
+                }
+
+                double value = 0;
+                auto [ptr, ec] = std::from_chars(start, p, value);
+                if (ec == std::errc::result_out_of_range)
+                    value = std::strtod(std::string(start, p).c_str(), nullptr);
+                return AnyValue::make_number(value);
+            }
+
+            // Contents of the string whose opening quote is at `pos`. Strings without
+            // escapes are returned in place; others are decoded into `scratch`.
+            std::string_view parse_string(size_t pos)
+            {
+                size_t begin = pos + 1;
+                size_t i = find_string_special<false>(src, begin);
+                if (i < src.size() && src[i] == '"')
+                    return src.substr(begin, i - begin);
+
+                scratch.assign(src.data() + begin, i - begin);
+                while (true)
+                {
+                    if (i >= src.size())
+                        unexpected(i);
+                    unsigned char c = src[i];
+                    if (c == '"')
+                        return scratch;
+                    if (c < 0x20)
+                        throw Exception::make_exception("Bad control character in string literal in JSON at position " + std::to_string(i), "SyntaxError");
+
+                    // Backslash escape
+                    if (i + 1 >= src.size())
+                        unexpected(src.size());
+                    char e = src[i + 1];
+                    i += 2;
+                    switch (e)
+                    {
+                    case '"': scratch += '"'; break;
+                    case '\\': scratch += '\\'; break;
+                    case '/': scratch += '/'; break;
+                    case 'b': scratch += '\b'; break;
+                    case 'f': scratch += '\f'; break;
+                    case 'n': scratch += '\n'; break;
+                    case 'r': scratch += '\r'; break;
+                    case 't': scratch += '\t'; break;
+                    case 'u':
+                    {
+                        uint32_t cp = parse_hex4(i);
+                        i += 4;
+                        if (cp >= 0xD800 && cp <= 0xDBFF && i + 6 <= src.size() && src[i] == '\\' && src[i + 1] == 'u')
+                        {
+                            uint32_t low = parse_hex4(i + 2);
+                            if (low >= 0xDC00 && low <= 0xDFFF)
+                            {
+                                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                                i += 6;
+                            }
+                        }
+                        append_utf8(scratch, cp);
+                        break;
+                    }
+                    default:
+                        throw Exception::make_exception("Bad escaped character in JSON at position " + std::to_string(i - 1), "SyntaxError");
+                    }
+
+                    size_t run = find_string_special<false>(src, i);
+                    scratch.append(src.data() + i, run - i);
+                    i = run;
+                }
+            }
+
+            uint32_t parse_hex4(size_t pos) const
+            {
+                uint32_t cp = 0;
+                for (size_t k = 0; k < 4; ++k)
+                {
+                    char c = pos + k < src.size() ? src[pos + k] : '\0';
+                    uint32_t digit;
+                    if (c >= '0' && c <= '9')
+                        digit = static_cast<uint32_t>(c - '0');
+                    else if (c >= 'a' && c <= 'f')
+                        digit = static_cast<uint32_t>(c - 'a' + 10);
+                    else if (c >= 'A' && c <= 'F')
+                        digit = static_cast<uint32_t>(c - 'A' + 10);
+                    else
+                        throw Exception::make_exception("Bad Unicode escape in JSON at position " + std::to_string(pos - 2), "SyntaxError");
+                    cp = (cp << 4) | digit;
+                }
+                return cp;
+            }
+
+            AnyValue parse_array(size_t depth)
+            {
+                check_depth(depth);
+                size_t base = stack.size();
+                if (peek() == ']')
+                {
+                    ++next;
+                    return AnyValue::make_array(std::vector<AnyValue>{});
+                }
+                while (true)
+                {
+                    AnyValue element = parse_value(depth);
+                    stack.push_back(std::move(element));
+                    size_t pos = take();
+                    if (src[pos] == ']')
+                        break;
+                    if (src[pos] != ',')
+                        unexpected(pos);
+                }
+                std::vector<AnyValue> elements(std::make_move_iterator(stack.begin() + base), std::make_move_iterator(stack.end()));
+                stack.resize(base);
+                return AnyValue::make_array(std::move(elements));
+            }
+
+            AnyValue parse_object(size_t depth)
+            {
+                check_depth(depth);
+                size_t base = stack.size();
+                Shape *shape = Shape::empty_shape();
+                AnyValue overflow; // the object itself once it leaves fast mode
+                std::string escaped_key;
+                auto &cache = transition_cache();
+
+                if (peek() == '}')
+                {
+                    ++next;
+                    return AnyValue::make_object({});
+                }
+                while (true)
+                {
+                    size_t key_pos = take();
+                    if (src[key_pos] != '"')
+                        unexpected(key_pos);
+                    std::string_view key = parse_string(key_pos);
+                    if (key.data() == scratch.data())
+                    {
+                        // `scratch` is reused while parsing the value
+                        escaped_key.assign(key);
+                        key = escaped_key;
+                    }
+                    size_t colon = take();
+                    if (src[colon] != ':')
+                        unexpected(colon);
+                    AnyValue value = parse_value(depth);
+
+                    if (!overflow.is_undefined())
+                    {
+                        overflow.as_object()->put_own_property(std::string(key), value);
+                    }
+                    else
+                    {
+                        uint32_t count = shape->property_count();
+                        auto &entry = cache[(reinterpret_cast<uintptr_t>(shape) >> 4) & (TRANSITION_CACHE_SIZE - 1)];
+                        if (entry.from == shape && entry.to->key_at(count) == key)
+                        {
+                            // A transition out of `shape` never repeats one of its keys
+                            shape = entry.to;
+                            stack.push_back(std::move(value));
+                        }
+                        else
+                        {
+                            std::string name(key);
+                            if (auto offset = shape->get_offset(name))
+                            {
+                                // Duplicate key: the last one wins, in its first position
+                                stack[base + offset.value()] = std::move(value);
+                            }
+                            else if (count >= JsObject::DICTIONARY_MODE_THRESHOLD)
+                            {
+                                overflow = make_fast_object(shape, base);
+                                overflow.as_object()->add_own_property(name, value);
+                            }
+                            else
+                            {
+                                Shape *to = shape->transition(name);
+                                entry = TransitionCacheEntry{shape, to};
+                                shape = to;
+                                stack.push_back(std::move(value));
+                            }
+                        }
+                    }
+
+                    size_t pos = take();
+                    if (src[pos] == '}')
+                        break;
+                    if (src[pos] != ',')
+                        unexpected(pos);
+                }
+                return overflow.is_undefined() ? make_fast_object(shape, base) : overflow;
+            }
+
+            // Creates the object for `shape` in one step from the values parked on the stack
+            AnyValue make_fast_object(Shape *shape, size_t base)
+            {
+                AnyValue result = AnyValue::make_object({});
+                JsObject *object = result.as_object();
+                object->shape = shape;
+                object->storage.assign(std::make_move_iterator(stack.begin() + base), std::make_move_iterator(stack.end()));
+                stack.resize(base);
+                return result;
+            }
+        };
+
+        // InternalizeJSONProperty: post-order walk handing every value to the reviver
+        static AnyValue internalize(const AnyValue &holder, const std::string &key, const AnyValue &reviver)
+        {
+            AnyValue value = holder.get_property_with_receiver(key, holder);
+            auto revive_child = [&](const std::string &child_key)
+            {
+                AnyValue revived = internalize(value, child_key, reviver);
+                if (revived.is_undefined())
+                    Access::delete_property(value, AnyValue::make_string(child_key));
+                else
+                    value.set_own_property(child_key, revived);
+            };
+
+            if (value.is_array())
+            {
+                uint64_t length = value.as_array()->length;
+                for (uint64_t i = 0; i < length; ++i)
+                    revive_child(std::to_string(i));
+            }
+            else if (value.is_object())
+            {
+                for (const auto &child_key : Access::get_object_keys(value))
+                    revive_child(child_key.to_std_string());
+            }
+
+            const AnyValue args[] = {AnyValue::make_string(key), value};
+            return reviver.call(holder, args);
+        }
+
+        // ECMAScript Number::toString for finite values, from the shortest round-trip digits
+        static void append_json_number(std::string &out, double value)
+        {
+            if (value == 0)
+            {
+                out += '0'; // also -0
+                return;
+            }
+
+            char buf[40];
+            if (std::abs(value) < 9007199254740992.0 && value == std::trunc(value))
+            {
+                auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), static_cast<int64_t>(value));
+                out.append(buf, end);
+                return;
+            }
+
+            auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::scientific);
+            const char *p = buf;
+            if (*p == '-')
+            {
+                out += '-';
+                ++p;
+            }
+            // `p` now reads d[.ddd]e±xx
+            char digits[24];
+            int k = 0;
+            for (; *p != 'e'; ++p)
+            {
+                if (*p != '.')
+                    digits[k++] = *p;
+            }
+            int exponent = 0;
+            std::from_chars(p[1] == '+' ? p + 2 : p + 1, end, exponent);
+            int n = exponent + 1; // position of the decimal point relative to the digits
+
+            if (k <= n && n <= 21)
+            {
+                out.append(digits, k);
+                out.append(static_cast<size_t>(n - k), '0');
+            }
+            else if (0 < n && n <= 21)
+            {
+                out.append(digits, n);
+                out += '.';
+                out.append(digits + n, k - n);
+            }
+            else if (-6 < n && n <= 0)
+            {
+                out += "0.";
+                out.append(static_cast<size_t>(-n), '0');
+                out.append(digits, k);
+            }
+            else
+            {
+                out += digits[0];
+                if (k > 1)
+                {
+                    out += '.';
+                    out.append(digits + 1, k - 1);
+                }
+                out += 'e';
+                out += n - 1 >= 0 ? '+' : '-';
+                auto [exp_end, exp_ec] = std::to_chars(buf, buf + sizeof(buf), std::abs(n - 1));
+                out.append(buf, exp_end);
+            }
+        }
+
+        static void append_json_quoted(std::string &out, std::string_view s)
+        {
+            static constexpr char HEX[] = "0123456789abcdef";
+            out.reserve(out.size() + s.size() + 2);
+            out += '"';
+            size_t i = 0;
+            while (true)
+            {
+                size_t run = find_string_special<true>(s, i);
+                out.append(s.data() + i, run - i);
+                if (run == s.size())
+                    break;
+
+                unsigned char c = s[run];
+                i = run + 1;
+                switch (c)
+                {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\b': out += "\\b"; break;
+                case '\f': out += "\\f"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                case 0xED:
+                {
+                    // ED A0..BF xx encodes a surrogate; alone it is not valid UTF-8 and
+                    // is written as an escape, like V8's well-formed JSON.stringify
+                    bool surrogate = run + 2 < s.size() && (static_cast<unsigned char>(s[run + 1]) & 0xE0) == 0xA0;
+                    if (!surrogate)
+                    {
+                        out += static_cast<char>(c);
+                        break;
+                    }
+                    uint32_t unit = 0xD000 | ((static_cast<unsigned char>(s[run + 1]) & 0x3F) << 6) | (static_cast<unsigned char>(s[run + 2]) & 0x3F);
+                    out += "\\u";
+                    out += HEX[(unit >> 12) & 0xF];
+                    out += HEX[(unit >> 8) & 0xF];
+                    out += HEX[(unit >> 4) & 0xF];
+                    out += HEX[unit & 0xF];
+                    i = run + 3;
+                    break;
+                }
+                default:
+                    out += "\\u00";
+                    out += HEX[c >> 4];
+                    out += HEX[c & 0xF];
+                    break;
+                }
+            }
+            out += '"';
+        }
+
+        // SerializeJSONProperty and friends, writing into a single growing buffer. A
+        // property whose value turns out to be unserializable is rolled back by
+        // truncating the buffer to where the property started.
+        class JsonSerializer
+        {
+        public:
+            struct PropertyName
+            {
+                const std::string *name = nullptr;
+                uint64_t index = 0;
+
+                AnyValue to_value() const
+                {
+                    return name ? AnyValue::make_string(*name) : AnyValue::make_string(std::to_string(index));
+                }
+            };
+
+            std::string out;
+            AnyValue replacer;                          // undefined unless a replacer function was given
+            std::optional<std::vector<std::string>> allow_list; // keys from an array replacer
+            std::string gap;
+
+            // Writes `value` stored under `key` in `holder`, `depth` containers down; false if
+            // it serializes to undefined
+            bool serialize_property(const AnyValue &holder, const PropertyName &key, AnyValue value, size_t depth)
+            {
+                if (value.is_heap_object() && !value.is_string() && !value.is_symbol())
+                {
+                    AnyValue to_json = find_to_json(value);
+                    if (to_json.is_function())
+                    {
+                        const AnyValue args[] = {key.to_value()};
+                        value = to_json.call(value, args, "toJSON");
+                    }
+                }
+                if (!replacer.is_undefined())
+                {
+                    const AnyValue args[] = {key.to_value(), value};
+                    value = replacer.call(holder, args);
+                }
+
+                if (value.is_number())
+                {
+                    double d = value.as_double();
+                    if (std::isfinite(d))
+                        append_json_number(out, d);
+                    else
+                        out += "null";
+                    return true;
+                }
+                if (value.is_string())
+                {
+                    append_json_quoted(out, value.as_string()->value());
+                    return true;
+                }
+                if (value.is_null())
+                {
+                    out += "null";
+                    return true;
+                }
+                if (value.is_boolean())
+                {
+                    out += value.as_boolean() ? "true" : "false";
+                    return true;
+                }
+                if (value.is_array())
+                {
+                    serialize_array(value, depth + 1);
+                    return true;
+                }
+                if (value.is_heap_object() && !value.is_function() && !value.is_symbol() &&
+                    !value.is_data_descriptor() && !value.is_accessor_descriptor())
+                {
+                    serialize_object(value, depth + 1);
+                    return true;
+                }
+                return false;
+            }
+
+        private:
+            std::string indent;
+            std::vector<const HeapObject *> stack;
+
+            static AnyValue find_to_json(const AnyValue &value)
+            {
+                static const PropertyKey to_json_key("toJSON");
+                if (value.is_object())
+                {
+                    // Plain objects without a prototype (literals, JSON.parse results) only
+                    // need their own shape checked
+                    JsObject *object = value.as_object();
+                    if (!object->is_dictionary_mode() && object->proto.is_null())
+                    {
+                        auto offset = object->shape->get_offset(to_json_key);
+                        if (!offset.has_value())
+                            return Constants::UNDEFINED;
+                    }
+                }
+                return value.get_property_with_receiver(to_json_key, value);
+            }
+
+            void enter(const AnyValue &value)
+            {
+                const HeapObject *object = value.get_ptr();
+                if (std::find(stack.begin(), stack.end(), object) != stack.end())
+                    throw Exception::make_exception("Converting circular structure to JSON", "TypeError");
+                stack.push_back(object);
+            }
+
+            void newline(const std::string &level)
+            {
+                out += '\n';
+                out += level;
+            }
+
+            void serialize_object(const AnyValue &value, size_t depth)
+            {
+                check_depth(depth);
+                enter(value);
+                std::string stepback = indent;
+                indent += gap;
+
+                out += '{';
+                bool any = false;
+                auto member = [&](const std::string &key, const AnyValue &member_value)
+                {
+                    size_t mark = out.size();
+                    if (any)
+                        out += ',';
+                    if (!gap.empty())
+                        newline(indent);
+                    append_json_quoted(out, key);
+                    out += gap.empty() ? ":" : ": ";
+                    if (serialize_property(value, PropertyName{&key}, member_value, depth))
+                        any = true;
+                    else
+                        out.resize(mark);
+                };
+
+                if (allow_list)
+                {
+                    for (const auto &key : *allow_list)
+                        member(key, value.get_property_with_receiver(key, value));
+                }
+                else if (value.is_object() && !value.as_object()->is_dictionary_mode())
+                {
+                    // The key list is fixed up front as the spec requires; values are read
+                    // as they are reached since toJSON or a replacer may change them
+                    JsObject *object = value.as_object();
+                    Shape *shape = object->shape;
+                    for (uint32_t offset = 0; offset < shape->property_count(); ++offset)
+                    {
+                        const std::string &key = shape->key_at(offset);
+                        AnyValue member_value;
+                        if (object->shape == shape)
+                        {
+                            member_value = object->storage[offset];
+                        }
+                        else if (const AnyValue *slot = object->find_own_property(key))
+                        {
+                            member_value = *slot;
+                        }
+                        else
+                        {
+                            continue;
+                        }
+
+                        if (member_value.is_data_descriptor() || member_value.is_accessor_descriptor())
+                        {
+                            bool enumerable = member_value.is_data_descriptor() ? member_value.as_data_descriptor()->enumerable
+                                                                                : member_value.as_accessor_descriptor()->enumerable;
+                            if (!enumerable)
+                                continue;
+                            member_value = value.get_property_with_receiver(key, value);
+                        }
+                        member(key, member_value);
+                    }
+                }
+                else
+                {
+                    for (const auto &key_value : Access::get_object_keys(value))
+                    {
+                        std::string key = key_value.to_std_string();
+                        member(key, value.get_property_with_receiver(key, value));
+                    }
+                }
+
+                if (any && !gap.empty())
+                    newline(stepback);
+                out += '}';
+
+                indent = std::move(stepback);
+                stack.pop_back();
+            }
+
+            void serialize_array(const AnyValue &value, size_t depth)
+            {
+                check_depth(depth);
+                enter(value);
+                std::string stepback = indent;
+                indent += gap;
+
+                JsArray *array = value.as_array();
+                uint64_t length = array->length;
+                out += '[';
+                for (uint64_t i = 0; i < length; ++i)
+                {
+                    if (i > 0)
+                        out += ',';
+                    if (!gap.empty())
+                        newline(indent);
+                    AnyValue element = array->is_packed() && i < array->dense.size()
+                                           ? array->dense[i]
+                                           : value.get_own_property(static_cast<uint32_t>(i));
+                    if (!serialize_property(value, PropertyName{nullptr, i}, element, depth))
+                        out += "null";
+                }
+                if (length > 0 && !gap.empty())
+                    newline(stepback);
+                out += ']';
+
+                indent = std::move(stepback);
+                stack.pop_back();
+            }
+        };
+    }
+
+    jspp::AnyValue JSON = jspp::AnyValue::make_object({});
+
+    struct JsonInit
+    {
+        JsonInit()
+        {
+            using namespace jspp::Library;
+
+            auto defMutable = [](const std::string &key, AnyValue val)
+            {
+                jspp::JSON.define_data_property(key, val, true, false, true);
+            };
+
+            defMutable("parse", AnyValue::make_function([](AnyValue, std::span<const AnyValue> args) -> AnyValue
+                                                        {
+                AnyValue text = args.empty() ? Constants::UNDEFINED : args[0];
+                AnyValue result = text.is_string() ? JsonParser(text.as_string()->value()).parse()
+                                                   : JsonParser(text.to_std_string()).parse();
+
+                if (args.size() > 1 && args[1].is_function())
+                {
+                    AnyValue root = AnyValue::make_object({{"", result}});
+                    return internalize(root, "", args[1]);
+                }
+                return result; }, "parse"));
+
+            defMutable("stringify", AnyValue::make_function([](AnyValue, std::span<const AnyValue> args) -> AnyValue
+                                                            {
+                JsonSerializer serializer;
+                AnyValue value = args.empty() ? Constants::UNDEFINED : args[0];
+
+                if (args.size() > 1)
+                {
+                    if (args[1].is_function())
+                    {
+                        serializer.replacer = args[1];
+                    }
+                    else if (args[1].is_array())
+                    {
+                        std::vector<std::string> keys;
+                        JsArray *list = args[1].as_array();
+                        for (uint64_t i = 0; i < list->length; ++i)
+                        {
+                            AnyValue item = args[1].get_own_property(static_cast<uint32_t>(i));
+                            if (!item.is_string() && !item.is_number())
+                                continue;
+                            std::string key = item.to_std_string();
+                            if (std::find(keys.begin(), keys.end(), key) == keys.end())
+                                keys.push_back(std::move(key));
+                        }
+                        serializer.allow_list = std::move(keys);
+                    }
+                }
+
+                if (args.size() > 2)
+                {
+                    const AnyValue &space = args[2];
+                    if (space.is_number())
+                    {
+                        double width = std::min(10.0, std::trunc(space.as_double()));
+                        if (width >= 1)
+                            serializer.gap.assign(static_cast<size_t>(width), ' ');
+                    }
+                    else if (space.is_string())
+                    {
+                        serializer.gap = space.as_string()->value().substr(0, 10);
+                    }
+                }
+
+                AnyValue holder = serializer.replacer.is_undefined() ? Constants::UNDEFINED : AnyValue::make_object({{"", value}});
+                static const std::string empty_key;
+                if (!serializer.serialize_property(holder, JsonSerializer::PropertyName{&empty_key}, value, 0))
+                    return Constants::UNDEFINED;
+                return AnyValue::make_string(std::move(serializer.out)); }, "stringify"));
+
+            jspp::JSON.define_data_property(AnyValue::from_symbol(WellKnownSymbols::toStringTag), AnyValue::make_string("JSON"), false, false, true);
+        }
+    };
+
+    void init_json()
+    {
+        static JsonInit jsonInit;
+    }
+}
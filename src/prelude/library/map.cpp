@@ -0,0 +1,88 @@
+#include "jspp.hpp"
+#include "library/map.hpp"
+
+namespace jspp
+{
+    jspp::AnyValue Map = jspp::AnyValue::make_class(
+        [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                                                                     {
+        if (!thisVal.is_object())
+        {
+            throw jspp::Exception::make_exception("Constructor Map requires 'new'", "TypeError");
+        }
+        auto map = jspp::AnyValue::make_map();
+        map.set_prototype(thisVal.as_object()->proto);
+        if (args.empty() || args[0].is_null() || args[0].is_undefined())
+            return map;
+
+        auto &table = map.as_map()->table;
+        const auto &iterable = args[0];
+        if (iterable.is_map())
+        {
+            iterable.as_map()->table.for_each([&](const jspp::AnyValue &key, const jspp::AnyValue &value)
+                                              { table.set(key, value); });
+            return map;
+        }
+        jspp::Access::for_each_iterable(iterable, "Map source", [&](const jspp::AnyValue &entry)
+                                        {
+            if (entry.is_array())
+            {
+                auto pair = entry.as_array();
+                table.set(pair->get_property(0u), pair->get_property(1u));
+            }
+            else if (entry.is_object() || entry.is_function() || entry.is_map() || entry.is_set())
+            {
+                table.set(entry.get_own_property(0u), entry.get_own_property(1u));
+            }
+            else
+            {
+                throw jspp::Exception::make_exception("Iterator value " + entry.to_std_string() + " is not an entry object", "TypeError");
+            } });
+        return map; },
+        "Map");
+
+    struct MapInit
+    {
+        MapInit()
+        {
+            Map.define_data_property("groupBy", jspp::AnyValue::make_function(
+                                                    [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                                                                                                                 {
+                if (args.size() < 2 || !args[1].is_function())
+                {
+                    throw jspp::Exception::make_exception((args.size() < 2 ? std::string("undefined") : args[1].to_std_string()) + " is not a function", "TypeError");
+                }
+                auto result = jspp::AnyValue::make_map();
+                result.set_prototype(Map.get_own_property("prototype"));
+                auto &table = result.as_map()->table;
+                const auto &callback = args[1];
+                double k = 0;
+                jspp::Access::for_each_iterable(args[0], "Map.groupBy source", [&](const jspp::AnyValue &item)
+                                                {
+                    const jspp::AnyValue cbArgs[] = {item, jspp::AnyValue::make_number(k++)};
+                    auto key = callback.call(jspp::Constants::UNDEFINED, cbArgs);
+                    if (auto group = table.find(key))
+                        group->as_array()->set_property(static_cast<uint32_t>(group->as_array()->length), item);
+                    else
+                        table.set(key, jspp::AnyValue::make_array(std::vector<jspp::AnyValue>{item})); });
+                return result; },
+                                                    "groupBy"));
+
+            auto proto = Map.get_own_property("prototype");
+            const char *methods[] = {"get", "set", "has", "delete", "clear", "forEach", "keys", "values", "entries"};
+            for (const char *m : methods)
+            {
+                proto.define_data_property(m, jspp::MapPrototypes::get(m).value(), true, false, true);
+            }
+            proto.define_getter("size", jspp::AnyValue::make_function([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                                                                      { return jspp::MapPrototypes::get_size_desc().as_accessor_descriptor()->get.value()(thisVal, args); }, "get size"));
+
+            auto iteratorSym = jspp::AnyValue::from_symbol(jspp::WellKnownSymbols::iterator);
+            proto.define_data_property(iteratorSym, jspp::MapPrototypes::get(iteratorSym).value(), true, false, true);
+        }
+    };
+    void init_map()
+    {
+        static MapInit mapInit;
+    }
+}
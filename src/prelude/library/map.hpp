@@ -0,0 +1,14 @@
+#pragma once
+
+#include "types.hpp"
+#include "any_value.hpp"
+#include "utils/operators.hpp"
+#include "utils/access.hpp"
+
+namespace jspp
+{
+    extern AnyValue Map;
+    void init_map();
+}
+
+using jspp::Map;
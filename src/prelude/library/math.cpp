@@ -227,18 +227,14 @@ namespace jspp {
             defMutable("sumPrecise", AnyValue::make_function([](AnyValue thisVal, std::span<const AnyValue> args) -> AnyValue {
                 if (args.empty()) throw Exception::make_exception("Math.sumPrecise requires an iterable", "TypeError");
                 
-                auto iterObj = jspp::Access::get_object_iterator(args[0], "iterable");
-                auto nextFunc = iterObj.get_own_property("next");
+                jspp::ForOfCursor iter(args[0], "iterable");
                 
                 double sum = 0;
                 // Kahan summation algorithm for better precision
                 double c = 0; 
                 
-                while (true) {
-                    auto nextRes = nextFunc.call(iterObj, std::span<const jspp::AnyValue>{}, "next");
-                    if (is_truthy(nextRes.get_own_property("done"))) break;
-                    
-                    double val = Operators_Private::ToNumber(nextRes.get_own_property("value"));
+                while (iter.next()) {
+                    double val = Operators_Private::ToNumber(iter.value());
                     if (std::isnan(val)) {
                         sum = std::numeric_limits<double>::quiet_NaN();
                         break;
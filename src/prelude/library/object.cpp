@@ -3,7 +3,7 @@
 
 namespace jspp {
     jspp::AnyValue Object = jspp::AnyValue::make_class(
-        std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+        [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
     {
         if (args.empty() || args[0].is_undefined() || args[0].is_null()) {
             return jspp::AnyValue::make_object({});
@@ -12,14 +12,14 @@ namespace jspp {
             return args[0];
         }
         return jspp::AnyValue::make_object({});
-    }), "Object");
+    }, "Object");
 
     struct ObjectInit
     {
         ObjectInit()
         {
             Object.define_data_property("keys", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                 if (args.empty()) throw jspp::Exception::make_exception("Object.keys called on non-object", "TypeError");
                 auto obj = args[0];
@@ -31,10 +31,10 @@ namespace jspp {
                     keyValues.push_back(k);
                 }
                 return jspp::AnyValue::make_array(std::move(keyValues));
-            }), "keys"));
+            }, "keys"));
 
             Object.define_data_property("values", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                 if (args.empty()) throw jspp::Exception::make_exception("Object.values called on non-object", "TypeError");
                 auto obj = args[0];
@@ -46,10 +46,10 @@ namespace jspp {
                     values.push_back(obj.get_own_property(k));
                 }
                 return jspp::AnyValue::make_array(std::move(values));
-            }), "values"));
+            }, "values"));
 
             Object.define_data_property("entries", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                 if (args.empty()) throw jspp::Exception::make_exception("Object.entries called on non-object", "TypeError");
                 auto obj = args[0];
@@ -64,10 +64,10 @@ namespace jspp {
                     entries.push_back(jspp::AnyValue::make_array(std::move(entry)));
                 }
                 return jspp::AnyValue::make_array(std::move(entries));
-            }), "entries"));
+            }, "entries"));
 
             Object.define_data_property("assign", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                 if (args.empty()) throw jspp::Exception::make_exception("Cannot convert undefined or null to object", "TypeError");
                 auto target = args[0];
@@ -84,10 +84,10 @@ namespace jspp {
                     }
                 }
                 return target;
-            }), "assign"));
+            }, "assign"));
 
             Object.define_data_property("getOwnPropertySymbols", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                 if (args.empty()) throw jspp::Exception::make_exception("Object.getOwnPropertySymbols called on non-object", "TypeError");
                 auto obj = args[0];
@@ -99,10 +99,10 @@ namespace jspp {
                     if (k.is_symbol()) symbolValues.push_back(k);
                 }
                 return jspp::AnyValue::make_array(std::move(symbolValues));
-            }), "getOwnPropertySymbols"));
+            }, "getOwnPropertySymbols"));
 
             Object.define_data_property("is", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                 jspp::AnyValue v1 = args.size() > 0 ? args[0] : jspp::Constants::UNDEFINED;
                 jspp::AnyValue v2 = args.size() > 1 ? args[1] : jspp::Constants::UNDEFINED;
@@ -118,10 +118,10 @@ namespace jspp {
                 }
                 
                 return jspp::is_strictly_equal_to(v1, v2);
-            }), "is"));
+            }, "is"));
 
             Object.define_data_property("getPrototypeOf", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                  if (args.empty()) throw jspp::Exception::make_exception("Object.getPrototypeOf called on non-object", "TypeError");
                  auto obj = args[0];
@@ -137,10 +137,10 @@ namespace jspp {
                  }
                  
                  return jspp::Constants::Null;
-            }), "getPrototypeOf"));
+            }, "getPrototypeOf"));
 
             Object.define_data_property("setPrototypeOf", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                  if (args.size() < 2) throw jspp::Exception::make_exception("Object.setPrototypeOf requires at least 2 arguments", "TypeError");
                  auto obj = args[0];
@@ -159,10 +159,10 @@ namespace jspp {
                  }
                  
                  return obj;
-            }), "setPrototypeOf"));
+            }, "setPrototypeOf"));
 
             Object.define_data_property("create", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                  if (args.empty()) throw jspp::Exception::make_exception("Object prototype may only be an Object or null", "TypeError");
                  auto proto = args[0];
@@ -172,7 +172,7 @@ namespace jspp {
                  
                  auto newObj = jspp::AnyValue::make_object({}).set_prototype(proto);
                  return newObj;
-            }), "create"));
+            }, "create"));
 
             auto getDescHelper = [](jspp::AnyValue descVal) -> jspp::AnyValue
             {
@@ -195,7 +195,7 @@ namespace jspp {
                     if (a->get.has_value())
                     {
                         result.set_own_property("get", jspp::AnyValue::make_function(
-                            std::function<AnyValue(AnyValue, std::span<const AnyValue>)>(a->get.value()), std::nullopt));
+                            a->get.value(), nullptr));
                     }
                     else
                     {
@@ -205,7 +205,7 @@ namespace jspp {
                     if (a->set.has_value())
                     {
                         result.set_own_property("set", jspp::AnyValue::make_function(
-                            std::function<AnyValue(AnyValue, std::span<const AnyValue>)>(a->set.value()), std::nullopt));
+                            a->set.value(), nullptr));
                     }
                     else
                     {
@@ -218,17 +218,17 @@ namespace jspp {
             };
 
             Object.define_data_property("getOwnPropertyDescriptor", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>( [getDescHelper](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                 [getDescHelper](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                 if (args.empty()) throw jspp::Exception::make_exception("Object.getOwnPropertyDescriptor called on non-object", "TypeError");
                 auto obj = args[0];
                 if (obj.is_null() || obj.is_undefined()) throw jspp::Exception::make_exception("Object.getOwnPropertyDescriptor called on null or undefined", "TypeError");
                 jspp::AnyValue prop = args.size() > 1 ? args[1] : jspp::Constants::UNDEFINED;
                 return getDescHelper(obj.get_own_property_descriptor(prop));
-            }), "getOwnPropertyDescriptor"));
+            }, "getOwnPropertyDescriptor"));
 
             Object.define_data_property("defineProperty", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                  if (args.size() < 3) throw jspp::Exception::make_exception("Object.defineProperty requires 3 arguments", "TypeError");
                  auto obj = args[0];
@@ -283,28 +283,22 @@ namespace jspp {
                         }
                         
                         auto desc = jspp::AnyValue::make_accessor_descriptor(getFunc, setFunc, enumerable, configurable);
-                        auto offset = o_ptr->shape->get_offset(prop);
-                        if (offset.has_value()) {
-                            o_ptr->storage[offset.value()] = desc;
-                        } else {
-                            o_ptr->shape = o_ptr->shape->transition(prop);
-                            o_ptr->storage.push_back(desc);
-                        }
+                        o_ptr->put_own_property(prop, desc);
                      }
                  }
                  return obj;
-            }), "defineProperty"));
+            }, "defineProperty"));
 
             Object.define_data_property("hasOwn", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                 if (args.empty()) throw jspp::Exception::make_exception("Object.hasOwn called on non-object", "TypeError");
                 auto obj = args[0];
                 if (obj.is_null() || obj.is_undefined()) throw jspp::Exception::make_exception("Object.hasOwn called on null or undefined", "TypeError");
                 std::string prop = args.size() > 1 ? args[1].to_std_string() : "undefined";
                 
-                if (obj.is_object()) return jspp::AnyValue::make_boolean(obj.as_object()->shape->get_offset(prop).has_value());
-                if (obj.is_function()) return jspp::AnyValue::make_boolean(obj.as_function()->props.count(prop));
+                if (obj.is_object()) return jspp::AnyValue::make_boolean(obj.as_object()->has_own_property(prop));
+                if (obj.is_function()) return jspp::AnyValue::make_boolean(obj.as_function()->has_own_property(prop));
                 if (obj.is_array()) {
                     if (prop == "length") return jspp::Constants::TRUE;
                     if (jspp::JsArray::is_array_index(prop)) {
@@ -317,15 +311,15 @@ namespace jspp {
                     return jspp::AnyValue::make_boolean(obj.as_array()->props.count(prop));
                 }
                 return jspp::Constants::FALSE;
-            }), "hasOwn"));
+            }, "hasOwn"));
 
             auto proto = Object.get_own_property("prototype");
             proto.define_data_property("hasOwnProperty", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                  std::string prop = args.size() > 0 ? args[0].to_std_string() : "undefined";
-                 if (thisVal.is_object()) return jspp::AnyValue::make_boolean(thisVal.as_object()->shape->get_offset(prop).has_value());
-                 if (thisVal.is_function()) return jspp::AnyValue::make_boolean(thisVal.as_function()->props.count(prop));
+                 if (thisVal.is_object()) return jspp::AnyValue::make_boolean(thisVal.as_object()->has_own_property(prop));
+                 if (thisVal.is_function()) return jspp::AnyValue::make_boolean(thisVal.as_function()->has_own_property(prop));
                  if (thisVal.is_array()) {
                      if (prop == "length") return jspp::Constants::TRUE;
                      if (jspp::JsArray::is_array_index(prop)) {
@@ -338,7 +332,7 @@ namespace jspp {
                      return jspp::AnyValue::make_boolean(thisVal.as_array()->props.count(prop));
                  }
                  return jspp::Constants::FALSE;
-            }), "hasOwnProperty"), true, false, true);
+            }, "hasOwnProperty"), true, false, true);
 
             auto toStringFn = jspp::ObjectPrototypes::get("toString");
             if (toStringFn.has_value()) {
@@ -346,11 +340,11 @@ namespace jspp {
             }
 
             proto.define_data_property("valueOf", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
-            { return thisVal; }), "valueOf"), true, false, true);
+                [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+            { return thisVal; }, "valueOf"), true, false, true);
 
             proto.define_data_property("isPrototypeOf", jspp::AnyValue::make_function(
-                std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
             {
                 if (args.empty() || !args[0].is_object()) return jspp::Constants::FALSE;
                 auto target = args[0];
@@ -369,7 +363,7 @@ namespace jspp {
                     else break;
                 }
                 return jspp::Constants::FALSE;
-            }), "isPrototypeOf"), true, false, true);
+            }, "isPrototypeOf"), true, false, true);
         }
     };
     void init_object()
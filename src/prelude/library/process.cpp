@@ -20,7 +20,36 @@ AnyValue process = jspp::AnyValue::make_object({
         }
         std::exit(code);
         return jspp::Constants::UNDEFINED;
-    }, "exit")}
+    }, "exit")},
+    // Runs the cycle collector now instead of at the next allocation threshold
+    {"gc", jspp::AnyValue::make_function([](jspp::AnyValue, std::span<const jspp::AnyValue>) -> jspp::AnyValue {
+        jspp::CycleCollector::collect();
+        return jspp::Constants::UNDEFINED;
+    }, "gc")},
+    // Snapshot of the cycle collector's counters for this thread
+    {"gcStats", jspp::AnyValue::make_function([](jspp::AnyValue, std::span<const jspp::AnyValue>) -> jspp::AnyValue {
+        const auto &stats = jspp::CycleCollector::stats();
+        return jspp::AnyValue::make_object({
+            {"collections", jspp::AnyValue::make_number(static_cast<double>(stats.collections))},
+            {"rootsScanned", jspp::AnyValue::make_number(static_cast<double>(stats.roots_scanned))},
+            {"cyclesCollected", jspp::AnyValue::make_number(static_cast<double>(stats.cycles_collected))},
+            {"objectsCollected", jspp::AnyValue::make_number(static_cast<double>(stats.objects_collected))},
+            {"totalPauseMs", jspp::AnyValue::make_number(static_cast<double>(stats.total_pause_ns) / 1e6)},
+            {"maxPauseMs", jspp::AnyValue::make_number(static_cast<double>(stats.max_pause_ns) / 1e6)},
+        });
+    }, "gcStats")},
+    // Snapshot of the heap value allocator's counters for this thread
+    {"heapStats", jspp::AnyValue::make_function([](jspp::AnyValue, std::span<const jspp::AnyValue>) -> jspp::AnyValue {
+        const auto &stats = jspp::HeapAllocator::stats();
+        return jspp::AnyValue::make_object({
+            {"allocations", jspp::AnyValue::make_number(static_cast<double>(stats.allocations))},
+            {"deallocations", jspp::AnyValue::make_number(static_cast<double>(stats.deallocations))},
+            {"live", jspp::AnyValue::make_number(static_cast<double>(stats.live()))},
+            {"largeAllocations", jspp::AnyValue::make_number(static_cast<double>(stats.large_allocations))},
+            {"slabs", jspp::AnyValue::make_number(static_cast<double>(stats.slabs))},
+            {"reservedBytes", jspp::AnyValue::make_number(static_cast<double>(stats.reserved_bytes()))},
+        });
+    }, "heapStats")}
 });
 
 void setup_process_argv(int argc, char** argv) {
@@ -4,7 +4,7 @@
 namespace jspp
 {
     jspp::AnyValue Promise = jspp::AnyValue::make_function(
-        std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+        [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
                                                                      {
         if (args.empty() || !args[0].is_function())
         {
@@ -17,21 +17,21 @@ namespace jspp
 
         // resolve function
         auto resolveFn = jspp::AnyValue::make_function(
-            std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([state](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+            [state](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
         {
             jspp::JsPromise p; p.state = state;
             p.resolve(args.empty() ? jspp::Constants::UNDEFINED : args[0]);
             return jspp::Constants::UNDEFINED; 
-        }), "resolve");
+        }, "resolve");
 
         // reject function
         auto rejectFn = jspp::AnyValue::make_function(
-            std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([state](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+            [state](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
         {
             jspp::JsPromise p; p.state = state;
             p.reject(args.empty() ? jspp::Constants::UNDEFINED : args[0]);
             return jspp::Constants::UNDEFINED; 
-        }), "reject");
+        }, "reject");
 
         try
         {
@@ -47,7 +47,7 @@ namespace jspp
             promise.reject(jspp::AnyValue::make_string("Unknown error during Promise execution"));
         }
 
-        return jspp::AnyValue::make_promise(promise); }),
+        return jspp::AnyValue::make_promise(promise); },
         "Promise");
 
     struct PromiseInit
@@ -55,23 +55,23 @@ namespace jspp
         PromiseInit()
         {
             Promise.define_data_property("resolve", jspp::AnyValue::make_function(
-                                                        std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                                                        [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
                                                                                                                      {
                 jspp::JsPromise p;
                 p.resolve(args.empty() ? jspp::Constants::UNDEFINED : args[0]);
-                return jspp::AnyValue::make_promise(p); }),
+                return jspp::AnyValue::make_promise(p); },
                                                         "resolve"));
 
             Promise.define_data_property("reject", jspp::AnyValue::make_function(
-                                                       std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                                                       [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
                                                                                                                     {
                 jspp::JsPromise p;
                 p.reject(args.empty() ? jspp::Constants::UNDEFINED : args[0]);
-                return jspp::AnyValue::make_promise(p); }),
+                return jspp::AnyValue::make_promise(p); },
                                                        "reject"));
 
             Promise.define_data_property("all", jspp::AnyValue::make_function(
-                                                    std::function<AnyValue(AnyValue, std::span<const AnyValue>)>([](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                                                    [](jspp::AnyValue, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
                                                                                                                  {
                  if (args.empty() || !args[0].is_array()) {
                      jspp::JsPromise p; p.reject(jspp::AnyValue::make_string("Promise.all argument must be an array"));
@@ -120,7 +120,7 @@ namespace jspp
                      }
                  }
                  
-                 return jspp::AnyValue::make_promise(masterPromise); }),
+                 return jspp::AnyValue::make_promise(masterPromise); },
                                                     "all"));
         }
     };
@@ -0,0 +1,53 @@
+#include "jspp.hpp"
+#include "library/set.hpp"
+
+namespace jspp
+{
+    jspp::AnyValue Set = jspp::AnyValue::make_class(
+        [](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                                                                     {
+        if (!thisVal.is_object())
+        {
+            throw jspp::Exception::make_exception("Constructor Set requires 'new'", "TypeError");
+        }
+        auto set = jspp::AnyValue::make_set();
+        set.set_prototype(thisVal.as_object()->proto);
+        if (args.empty() || args[0].is_null() || args[0].is_undefined())
+            return set;
+
+        auto &table = set.as_set()->table;
+        const auto &iterable = args[0];
+        if (iterable.is_set())
+        {
+            iterable.as_set()->table.for_each([&](const jspp::AnyValue &key, const jspp::AnyValue &)
+                                              { table.set(key, jspp::Constants::UNDEFINED); });
+            return set;
+        }
+        jspp::Access::for_each_iterable(iterable, "Set source", [&](const jspp::AnyValue &value)
+                                        { table.set(value, jspp::Constants::UNDEFINED); });
+        return set; },
+        "Set");
+
+    struct SetInit
+    {
+        SetInit()
+        {
+            auto proto = Set.get_own_property("prototype");
+            const char *methods[] = {"add", "has", "delete", "clear", "forEach", "keys", "values", "entries",
+                                     "union", "intersection", "difference", "symmetricDifference", "isSubsetOf", "isSupersetOf", "isDisjointFrom"};
+            for (const char *m : methods)
+            {
+                proto.define_data_property(m, jspp::SetPrototypes::get(m).value(), true, false, true);
+            }
+            proto.define_getter("size", jspp::AnyValue::make_function([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
+                                                                      { return jspp::SetPrototypes::get_size_desc().as_accessor_descriptor()->get.value()(thisVal, args); }, "get size"));
+
+            auto iteratorSym = jspp::AnyValue::from_symbol(jspp::WellKnownSymbols::iterator);
+            proto.define_data_property(iteratorSym, jspp::SetPrototypes::get(iteratorSym).value(), true, false, true);
+        }
+    };
+    void init_set()
+    {
+        static SetInit setInit;
+    }
+}
@@ -4,6 +4,14 @@
 namespace jspp
 {
 
+    // Timer ids are integers below 2^53; NaN, negative and larger values match no timer
+    static TimerWheel::Id timer_id(double value)
+    {
+        if (!(value >= 0 && value < 9007199254740992.0))
+            return 0;
+        return static_cast<TimerWheel::Id>(value);
+    }
+
     AnyValue setTimeout = jspp::AnyValue::make_function([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
                                                         {
     if (args.empty() || !args[0].is_function()) {
@@ -34,14 +42,13 @@ namespace jspp
          }
     };
 
-    size_t id = jspp::Scheduler::instance().set_timeout(task, static_cast<size_t>(delay));
+    auto id = jspp::Scheduler::instance().set_timeout(task, delay);
     return jspp::AnyValue::make_number(static_cast<double>(id)); }, "setTimeout");
 
     AnyValue clearTimeout = jspp::AnyValue::make_function([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
                                                           {
     if (!args.empty() && args[0].is_number()) {
-        size_t id = static_cast<size_t>(args[0].as_double());
-        jspp::Scheduler::instance().clear_timer(id);
+        jspp::Scheduler::instance().clear_timer(timer_id(args[0].as_double()));
     }
     return jspp::Constants::UNDEFINED; }, "clearTimeout");
 
@@ -74,14 +81,13 @@ namespace jspp
          }
     };
 
-    size_t id = jspp::Scheduler::instance().set_interval(task, static_cast<size_t>(delay));
+    auto id = jspp::Scheduler::instance().set_interval(task, delay);
     return jspp::AnyValue::make_number(static_cast<double>(id)); }, "setInterval");
 
     AnyValue clearInterval = jspp::AnyValue::make_function([](jspp::AnyValue thisVal, std::span<const jspp::AnyValue> args) -> jspp::AnyValue
                                                            {
     if (!args.empty() && args[0].is_number()) {
-        size_t id = static_cast<size_t>(args[0].as_double());
-        jspp::Scheduler::instance().clear_timer(id);
+        jspp::Scheduler::instance().clear_timer(timer_id(args[0].as_double()));
     }
     return jspp::Constants::UNDEFINED; }, "clearInterval");
 
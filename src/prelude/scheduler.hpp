@@ -1,145 +1,115 @@
 #pragma once
-#include <deque>
-#include <functional>
 #include <chrono>
-#include <queue>
-#include <unordered_set>
-#include <vector>
 #include <thread>
 #include <iostream>
 
+#include "utils/task_queue.hpp"
+#include "utils/timer_wheel.hpp"
+
 namespace jspp {
+    // Single-threaded event loop.
+    //
+    // Microtasks (promise reactions, coroutine resumptions) are drained completely
+    // after every macrotask, so a promise chain started by a timer callback settles
+    // before the next timer runs. The macrotasks are timers, which come due in order
+    // from a TimerWheel. Tasks are move-only and live in a ring buffer or pooled timer
+    // nodes, so a steady-state loop performs no allocation per task.
     class Scheduler {
     public:
-        using Task = std::function<void()>;
-        using TimePoint = std::chrono::steady_clock::time_point;
-        
-        struct Timer {
-            size_t id;
-            TimePoint next_run;
-            std::chrono::milliseconds interval; // 0 if not repeating
-            Task task;
-            
-            // Min-heap priority queue (smallest time at top)
-            bool operator>(const Timer& other) const {
-                return next_run > other.next_run;
-            }
-        };
+        using Task = jspp::Task;
+        using Clock = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
 
         static Scheduler& instance() {
             static Scheduler s;
             return s;
         }
 
+        // Queues a microtask
         void enqueue(Task task) {
-            tasks.push_back(std::move(task));
+            microtasks.push(std::move(task));
         }
 
-        size_t set_timeout(Task task, size_t delay_ms) {
-            return schedule_timer(std::move(task), delay_ms, false);
+        // Delays as JS passes them; see clamp_delay
+        TimerWheel::Id set_timeout(Task task, double delay_ms) {
+            return timers.schedule(std::move(task), schedule_ms(), clamp_delay(delay_ms), 0);
         }
 
-        size_t set_interval(Task task, size_t delay_ms) {
-             return schedule_timer(std::move(task), delay_ms, true);
+        TimerWheel::Id set_interval(Task task, double delay_ms) {
+            size_t delay = clamp_delay(delay_ms);
+            // A zero interval would fire on every tick of the same millisecond forever
+            size_t interval = delay > 0 ? delay : 1;
+            return timers.schedule(std::move(task), schedule_ms(), delay, interval);
         }
-        
-        void clear_timer(size_t id) {
-            cancelled_timers.insert(id);
+
+        // Node's timer rule: a delay that is NaN, negative or above 2^31 - 1 runs after 1 ms
+        // (HTML would clamp these to 0). This also keeps delays inside the timing wheel's range.
+        static size_t clamp_delay(double delay_ms) noexcept {
+            constexpr double MAX_DELAY = 2147483647.0;
+            if (!(delay_ms >= 0) || delay_ms > MAX_DELAY)
+                return 1;
+            return static_cast<size_t>(delay_ms);
+        }
+
+        void clear_timer(TimerWheel::Id id) {
+            timers.cancel(id);
         }
 
         void run() {
             while (true) {
-                bool has_work = false;
+                bool has_work = run_microtasks();
 
-                // 1. Process all immediate tasks (microtask/task queue)
-                while (!tasks.empty()) {
-                    Task task = tasks.front();
-                    tasks.pop_front();
-                    task();
-                    has_work = true;
-                }
-
-                // 2. Process timers
-                auto now = std::chrono::steady_clock::now();
-                while (!timers.empty()) {
-                    // Peek top
-                    const auto& top = timers.top();
-                    
-                    // Cleanup cancelled timers lazily
-                    if (cancelled_timers.count(top.id)) {
-                        cancelled_timers.erase(top.id);
-                        timers.pop();
-                        continue;
-                    }
-                    
-                    if (top.next_run <= now) {
-                        // Timer is ready
-                        Timer t = top;
-                        timers.pop();
-                        
-                        // Execute task
-                        t.task();
-                        has_work = true;
-                        
-                        // Reschedule if interval and not cancelled during execution
-                        if (t.interval.count() > 0 && cancelled_timers.find(t.id) == cancelled_timers.end()) {
-                            // Drift-safe(ish) scheduling: run next interval relative to now
-                            // Note: JS allows drift.
-                            t.next_run = std::chrono::steady_clock::now() + t.interval;
-                            timers.push(t);
-                        }
-                    } else {
-                        break; // Next timer is in the future
+                // 1. Due timers, each followed by a microtask checkpoint
+                if (timers.collect(now_ms()) > 0) {
+                    while (timers.run_next([this] { return schedule_ms(); })) {
+                        run_microtasks();
                     }
+                    has_work = true;
                 }
 
-                // 3. Exit or Wait
+                // 2. Exit or Wait
                 if (!has_work) {
-                    if (tasks.empty() && timers.empty()) {
+                    if (!has_tasks()) {
                         break; // No pending work, exit event loop
                     }
-                    
-                    if (!timers.empty()) {
-                        auto next_time = timers.top().next_run;
-                        std::this_thread::sleep_until(next_time);
+
+                    if (auto next = timers.next_event()) {
+                        std::this_thread::sleep_until(epoch + std::chrono::milliseconds(*next));
                     }
                 }
             }
         }
-        
+
         bool has_tasks() const {
-            return !tasks.empty() || !timers.empty();
+            return !microtasks.empty() || !timers.empty();
         }
 
     private:
-        std::deque<Task> tasks;
-        std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers;
-        std::unordered_set<size_t> cancelled_timers;
-        size_t next_timer_id = 1;
-        const size_t MAX_TIMER_ID = 2147483647; // 2^31 - 1
-
-        size_t schedule_timer(Task task, size_t delay_ms, bool repeat) {
-            size_t id = next_timer_id++;
-            if (next_timer_id > MAX_TIMER_ID) {
-                next_timer_id = 1;
-            }
-            
-            // If we wrap around, ensure we don't accidentally treat this new ID as cancelled
-            // (in case an old timer with this ID is still lingering in the 'cancelled' set)
-            if (cancelled_timers.count(id)) {
-                cancelled_timers.erase(id);
+        TaskQueue microtasks;
+        TimerWheel timers;
+        TimePoint epoch = Clock::now();
+
+        TimerWheel::Tick now_ms() const {
+            return static_cast<TimerWheel::Tick>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - epoch).count());
+        }
+
+        // A timer fires once the truncated clock reaches its due tick, so due ticks are
+        // counted from the clock rounded up; otherwise a timer set 0.9 ms into a tick
+        // would fire 0.9 ms before its delay had elapsed.
+        TimerWheel::Tick schedule_ms() const {
+            return static_cast<TimerWheel::Tick>(
+                std::chrono::ceil<std::chrono::milliseconds>(Clock::now() - epoch).count());
+        }
+
+        bool run_microtasks() {
+            bool ran = false;
+            while (!microtasks.empty()) {
+                Task task = microtasks.pop();
+                task();
+                ran = true;
             }
-            
-            auto now = std::chrono::steady_clock::now();
-            
-            Timer t;
-            t.id = id;
-            t.next_run = now + std::chrono::milliseconds(delay_ms);
-            t.interval = repeat ? std::chrono::milliseconds(delay_ms) : std::chrono::milliseconds(0);
-            t.task = std::move(task);
-            
-            timers.push(t);
-            return id;
+            return ran;
         }
     };
-}
\ No newline at end of file
+}
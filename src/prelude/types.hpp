@@ -17,6 +17,9 @@
 #include <optional>
 #include <span>
 
+#include "utils/heap_allocator.hpp"
+#include "cycle_collector.hpp"
+
 // JSPP standard library
 namespace jspp
 {
@@ -37,19 +40,47 @@ namespace jspp
         DataDescriptor = 12,
         AccessorDescriptor = 13,
         AsyncIterator = 14,
+        Environment = 15, // captured bindings of one scope; never a JS value
+        Map = 16,
+        Set = 17,
     };
 
     struct HeapObject {
+        // Trial-deletion colors used by CycleCollector
+        enum GcColor : uint8_t { GC_BLACK, GC_GRAY, GC_WHITE, GC_PURPLE };
+
         mutable uint32_t ref_count = 0;
+        const JsType heap_type; // Stored inline so type checks are a load and compare, not a virtual call
+        mutable GcColor gc_color = GC_BLACK;
+        mutable bool gc_buffered = false; // listed as a possible cycle root
         
-        HeapObject() noexcept : ref_count(0) {}
+        explicit HeapObject(JsType type) noexcept : ref_count(0), heap_type(type) {}
         
-        // Disable copying/assignment of ref_count
-        HeapObject(const HeapObject&) noexcept : ref_count(0) {}
+        // Disable copying/assignment of ref_count and collector state
+        HeapObject(const HeapObject& other) noexcept : ref_count(0), heap_type(other.heap_type) {}
         HeapObject& operator=(const HeapObject&) noexcept { return *this; }
         
         virtual ~HeapObject() = default;
-        virtual JsType get_heap_type() const = 0;
+        JsType get_heap_type() const noexcept { return heap_type; }
+
+        // Types that can own references back into the graph and so take part in cycles.
+        // Strings, symbols and accessor/iterator internals are leaves to the collector.
+        bool is_gc_traced() const noexcept {
+            constexpr uint32_t TRACED = (1u << static_cast<uint8_t>(JsType::Object)) |
+                                        (1u << static_cast<uint8_t>(JsType::Array)) |
+                                        (1u << static_cast<uint8_t>(JsType::Function)) |
+                                        (1u << static_cast<uint8_t>(JsType::Promise)) |
+                                        (1u << static_cast<uint8_t>(JsType::DataDescriptor)) |
+                                        (1u << static_cast<uint8_t>(JsType::Environment)) |
+                                        (1u << static_cast<uint8_t>(JsType::Map)) |
+                                        (1u << static_cast<uint8_t>(JsType::Set));
+            return (TRACED >> static_cast<uint8_t>(heap_type)) & 1u;
+        }
+
+        // Visits every AnyValue slot this object holds a counted reference through.
+        // Each visited slot must correspond to exactly one reference, and slots must
+        // stay put for the duration of a collection.
+        virtual void trace(HeapTracer) {}
         
         void ref() const {
             ++ref_count;
@@ -57,9 +88,26 @@ namespace jspp
         
         void deref() const {
             if (--ref_count == 0) {
+                // A buffered root is freed by the collector when it drains the buffer
+                if (gc_buffered) {
+                    gc_color = GC_BLACK;
+                    return;
+                }
+                CycleCollector::DestroyScope scope;
                 delete this;
+            } else if (is_gc_traced()) {
+                gc_color = GC_PURPLE;
+                if (!gc_buffered) CycleCollector::buffer_root(this);
             }
         }
+
+        // All heap values are carved from the size-class slabs; the virtual destructor
+        // makes `delete this` pass the most-derived size back to the matching class.
+        static void* operator new(std::size_t size) {
+            CycleCollector::on_allocation();
+            return HeapAllocator::allocate(size);
+        }
+        static void operator delete(void* ptr, std::size_t size) noexcept { HeapAllocator::deallocate(ptr, size); }
     };
 
     // Js value forward declarations
@@ -72,6 +120,8 @@ namespace jspp
     struct JsFunction;      // can set property
     struct JsPromise;       // can set property
     struct JsSymbol;        // can set property (but usually doesn't have own props)
+    struct JsMap;           // can set property
+    struct JsSet;           // can set property
 
     template <typename T>
     class JsIterator; // can set property
@@ -89,11 +139,12 @@ namespace jspp
     // Dynamic AnyValue
     class AnyValue;
 
-    using JsFunctionCallable = std::variant<
-        std::function<AnyValue(AnyValue, std::span<const AnyValue>)>,
-        std::function<JsIterator<AnyValue>(AnyValue, std::vector<AnyValue>)>,
-        std::function<JsPromise(AnyValue, std::vector<AnyValue>)>,
-        std::function<JsAsyncIterator<AnyValue>(AnyValue, std::vector<AnyValue>)>>;
+    // Arguments owned by a generator or async function frame
+    class CoroutineArgs;
+
+    // Body of a JsFunction (utils/function_callable.hpp)
+    class JsFunctionCallable;
+    enum class FunctionKind : uint8_t;
 
     // Truthiness checker
     const bool is_truthy(const double &val) noexcept;
@@ -182,4 +233,14 @@ namespace jspp
         std::optional<AnyValue> get(const std::string &key);
         std::optional<AnyValue> get(const AnyValue &key);
     }
+    namespace MapPrototypes
+    {
+        std::optional<AnyValue> get(const std::string &key);
+        std::optional<AnyValue> get(const AnyValue &key);
+    }
+    namespace SetPrototypes
+    {
+        std::optional<AnyValue> get(const std::string &key);
+        std::optional<AnyValue> get(const AnyValue &key);
+    }
 }
@@ -4,6 +4,8 @@
 #include "well_known_symbols.hpp"
 #include "values/function.hpp"
 #include "values/symbol.hpp"
+#include "values/iterator.hpp"
+#include "values/prototypes/iterator.hpp"
 #include "exception.hpp"
 #include "any_value.hpp"
 #include <ranges>
@@ -12,26 +14,8 @@ namespace jspp
 {
     namespace Access
     {
-        // Helper function to check for TDZ and deref heap-allocated variables
-        inline const AnyValue &deref_ptr(const std::shared_ptr<AnyValue> &var, const std::string &name)
-        {
-            if (var->is_uninitialized()) [[unlikely]]
-            {
-                Exception::throw_uninitialized_reference(name);
-            }
-            return *var;
-        }
-        inline AnyValue &deref_ptr(std::shared_ptr<AnyValue> &var, const std::string &name)
-        {
-            if (var->is_uninitialized()) [[unlikely]]
-            {
-                Exception::throw_uninitialized_reference(name);
-            }
-            return *var;
-        }
-
-        // Helper function to check for TDZ on stack-allocated variables
-        inline const AnyValue &deref_stack(const AnyValue &var, const std::string &name)
+        // Helper function to check for TDZ on variables, on the stack or in a captured environment record
+        inline const AnyValue &deref_stack(const AnyValue &var, const char *name)
         {
             if (var.is_uninitialized()) [[unlikely]]
             {
@@ -39,7 +23,7 @@ namespace jspp
             }
             return var;
         }
-        inline AnyValue &deref_stack(AnyValue &var, const std::string &name)
+        inline AnyValue &deref_stack(AnyValue &var, const char *name)
         {
             if (var.is_uninitialized()) [[unlikely]]
             {
@@ -53,20 +37,15 @@ namespace jspp
         {
             std::vector<AnyValue> keys;
 
-            if (obj.is_object())
+            // A function's own properties live in a JsObject, once it has any
+            JsObject *ptr = obj.is_object()     ? obj.as_object()
+                            : obj.is_function() ? obj.as_function()->own_properties()
+                                                : nullptr;
+            if (ptr)
             {
-                auto ptr = obj.as_object();
-                for (const auto &key : ptr->shape->property_names)
-                {
-                    if (ptr->deleted_keys.count(key))
-                        continue;
-
-                    auto offset_opt = ptr->shape->get_offset(key);
-                    if (!offset_opt.has_value())
-                        continue;
-
-                    const auto &val = ptr->storage[offset_opt.value()];
-
+                keys.reserve(ptr->own_property_count());
+                ptr->for_each_own_property([&](const std::string &key, const AnyValue &val)
+                                           {
                     if (val.is_data_descriptor())
                     {
                         if (val.as_data_descriptor()->enumerable)
@@ -80,41 +59,7 @@ namespace jspp
                     else
                     {
                         keys.push_back(AnyValue::make_string(key));
-                    }
-                }
-                if (include_symbols)
-                {
-                    for (const auto &pair : ptr->symbol_props)
-                    {
-                        const auto &val = pair.second;
-                        if (val.is_data_descriptor())
-                        {
-                            if (val.as_data_descriptor()->enumerable)
-                                keys.push_back(pair.first);
-                        }
-                        else if (val.is_accessor_descriptor())
-                        {
-                            if (val.as_accessor_descriptor()->enumerable)
-                                keys.push_back(pair.first);
-                        }
-                        else
-                        {
-                            keys.push_back(pair.first);
-                        }
-                    }
-                }
-            }
-            if (obj.is_function())
-            {
-                auto ptr = obj.as_function();
-                for (const auto &pair : ptr->props)
-                {
-                    if (!pair.second.is_data_descriptor() && !pair.second.is_accessor_descriptor())
-                        keys.push_back(AnyValue::make_string(pair.first));
-                    else if ((pair.second.is_data_descriptor() && pair.second.as_data_descriptor()->enumerable) ||
-                             (pair.second.is_accessor_descriptor() && pair.second.as_accessor_descriptor()->enumerable))
-                        keys.push_back(AnyValue::make_string(pair.first));
-                }
+                    } });
                 if (include_symbols)
                 {
                     for (const auto &pair : ptr->symbol_props)
@@ -169,7 +114,7 @@ namespace jspp
             }
             if (obj.is_string())
             {
-                auto len = obj.as_string()->value.length();
+                auto len = obj.as_string()->value().length();
                 for (size_t i = 0; i < len; ++i)
                 {
                     keys.push_back(AnyValue::make_string(std::to_string(i)));
@@ -179,7 +124,7 @@ namespace jspp
             return keys;
         }
 
-        inline AnyValue get_object_iterator(const AnyValue &obj, const std::optional<std::string> &name = std::nullopt)
+        inline AnyValue get_object_iterator(const AnyValue &obj, const char *name = nullptr)
         {
             if (obj.is_null() || obj.is_undefined())
             {
@@ -195,7 +140,7 @@ namespace jspp
             auto gen_fn = obj.get_own_property(iterSym);
             if (gen_fn.is_function())
             {
-                auto iter = gen_fn.call(obj, {}, iterSym.to_std_string());
+                auto iter = gen_fn.call(obj, {});
                 if (iter.is_iterator())
                 {
                     return iter;
@@ -210,10 +155,10 @@ namespace jspp
                 }
             }
 
-            throw jspp::Exception::make_exception(name.value_or(obj.to_std_string()) + " is not iterable", "TypeError");
+            throw jspp::Exception::make_exception((name ? std::string(name) : obj.to_std_string()) + " is not iterable", "TypeError");
         }
 
-        inline AnyValue get_object_async_iterator(const AnyValue &obj, const std::optional<std::string> &name = std::nullopt)
+        inline AnyValue get_object_async_iterator(const AnyValue &obj, const char *name = nullptr)
         {
             if (obj.is_null() || obj.is_undefined())
             {
@@ -227,7 +172,7 @@ namespace jspp
             auto method = obj.get_own_property(asyncIterSym);
             if (method.is_function())
             {
-                auto iter = method.call(obj, {}, asyncIterSym.to_std_string());
+                auto iter = method.call(obj, {});
                 if (iter.is_object() || iter.is_async_iterator() || iter.is_iterator())
                     return iter;
             }
@@ -236,17 +181,38 @@ namespace jspp
             auto syncMethod = obj.get_own_property(iterSym);
             if (syncMethod.is_function())
             {
-                auto iter = syncMethod.call(obj, {}, iterSym.to_std_string());
+                auto iter = syncMethod.call(obj, {});
                 if (iter.is_object() || iter.is_iterator())
                     return iter;
             }
 
-            throw jspp::Exception::make_exception(name.value_or(obj.to_std_string()) + " is not async iterable", "TypeError");
+            throw jspp::Exception::make_exception((name ? std::string(name) : obj.to_std_string()) + " is not async iterable", "TypeError");
+        }
+
+        // IteratorStep + IteratorValue: advances `iter` and stores what it produced in `out`,
+        // returning false once it is done. A native generator whose `next` is still the
+        // built-in one is resumed directly, so no {value, done} object is created; only
+        // other iterators have their result object read.
+        inline bool iterator_step(const AnyValue &iter, const AnyValue &next_fn, AnyValue &out)
+        {
+            if (iter.is_iterator() && next_fn.is_heap_object() && next_fn.get_ptr() == IteratorPrototypes::get_next_fn().get_ptr())
+            {
+                auto res = iter.as_iterator()->next();
+                if (res.done)
+                    return false;
+                out = std::move(res.value).value_or(Constants::UNDEFINED);
+                return true;
+            }
+            auto next_res = next_fn.call(iter, {}, "next");
+            if (is_truthy(next_res.get_own_property("done")))
+                return false;
+            out = next_res.get_own_property("value");
+            return true;
         }
 
         inline AnyValue in(const AnyValue &lhs, const AnyValue &rhs)
         {
-            if (!rhs.is_object() && !rhs.is_array() && !rhs.is_function() && !rhs.is_promise() && !rhs.is_iterator())
+            if (!rhs.is_object() && !rhs.is_array() && !rhs.is_function() && !rhs.is_promise() && !rhs.is_iterator() && !rhs.is_map() && !rhs.is_set())
             {
                 throw jspp::Exception::make_exception("Cannot use 'in' operator to search for '" + lhs.to_std_string() + "' in " + rhs.to_std_string(), "TypeError");
             }
@@ -259,7 +225,7 @@ namespace jspp
             {
                 throw jspp::Exception::make_exception("Right-hand side of 'instanceof' is not callable", "TypeError");
             }
-            if (!lhs.is_object() && !lhs.is_array() && !lhs.is_function() && !lhs.is_promise() && !lhs.is_iterator() && !lhs.is_async_iterator())
+            if (!lhs.is_object() && !lhs.is_array() && !lhs.is_function() && !lhs.is_promise() && !lhs.is_iterator() && !lhs.is_async_iterator() && !lhs.is_map() && !lhs.is_set())
             {
                 return Constants::FALSE;
             }
@@ -286,6 +252,14 @@ namespace jspp
                 {
                     proto = current.as_function()->proto;
                 }
+                else if (current.is_map())
+                {
+                    proto = current.as_map()->proto;
+                }
+                else if (current.is_set())
+                {
+                    proto = current.as_set()->proto;
+                }
                 else if (current.is_promise())
                 {
                     proto = current.as_promise()->get_property("__proto__", current); // Fallback for promise if not fully modularized
@@ -310,10 +284,7 @@ namespace jspp
             {
                 auto ptr = obj.as_object();
                 std::string key_str = key.to_std_string();
-                if (ptr->shape->get_offset(key_str).has_value())
-                {
-                    ptr->deleted_keys.insert(key_str);
-                }
+                ptr->delete_own_property(key_str);
                 return Constants::TRUE;
             }
             if (obj.is_array())
@@ -322,15 +293,7 @@ namespace jspp
                 std::string key_str = key.to_std_string();
                 if (JsArray::is_array_index(key_str))
                 {
-                    uint32_t idx = static_cast<uint32_t>(std::stoull(key_str));
-                    if (idx < ptr->dense.size())
-                    {
-                        ptr->dense[idx] = Constants::UNINITIALIZED;
-                    }
-                    else
-                    {
-                        ptr->sparse.erase(idx);
-                    }
+                    ptr->clear_element(static_cast<uint32_t>(std::stoull(key_str)));
                 }
                 else
                 {
@@ -340,8 +303,7 @@ namespace jspp
             }
             if (obj.is_function())
             {
-                auto ptr = obj.as_function();
-                ptr->props.erase(key.to_std_string());
+                obj.as_function()->delete_own_property(key.to_std_string());
                 return Constants::TRUE;
             }
             return Constants::TRUE;
@@ -368,13 +330,13 @@ namespace jspp
             return obj.get_own_property(static_cast<uint32_t>(key));
         }
 
-        inline AnyValue call_optional_property(const AnyValue &obj, const std::string &key, std::span<const AnyValue> args, const std::optional<std::string> &expr = std::nullopt)
+        inline AnyValue call_optional_property(const AnyValue &obj, const std::string &key, std::span<const AnyValue> args, const char *expr = nullptr)
         {
             if (obj.is_null() || obj.is_undefined())
                 return Constants::UNDEFINED;
             return obj.get_own_property(key).call(obj, args, expr);
         }
-        inline AnyValue call_optional_property_with_optional_call(const AnyValue &obj, const std::string &key, std::span<const AnyValue> args, const std::optional<std::string> &expr = std::nullopt)
+        inline AnyValue call_optional_property_with_optional_call(const AnyValue &obj, const std::string &key, std::span<const AnyValue> args, const char *expr = nullptr)
         {
             if (obj.is_null() || obj.is_undefined())
                 return Constants::UNDEFINED;
@@ -395,23 +357,19 @@ namespace jspp
             else if (source.is_string())
             {
                 auto s = source.as_string();
-                target.reserve(target.size() + s->value.length());
-                for (char c : s->value)
+                target.reserve(target.size() + s->length());
+                for (char c : s->value())
                 {
-                    target.push_back(AnyValue::make_string(std::string(1, c)));
+                    target.push_back(JsString::from_char(static_cast<unsigned char>(c)));
                 }
             }
-            else if (source.is_object() || source.is_function() || source.is_iterator())
+            else if (source.is_object() || source.is_function() || source.is_iterator() || source.is_map() || source.is_set())
             {
                 auto iter = get_object_iterator(source, "spread target");
                 auto next_fn = iter.get_own_property("next");
-                while (true)
-                {
-                    auto next_res = next_fn.call(iter, {});
-                    if (is_truthy(next_res.get_own_property("done")))
-                        break;
-                    target.push_back(next_res.get_own_property("value"));
-                }
+                AnyValue value;
+                while (iterator_step(iter, next_fn, value))
+                    target.push_back(std::move(value));
             }
             else
             {
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "types.hpp"
+#include "any_value.hpp"
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace jspp
+{
+    // Arguments of a generator or async function call. The coroutine may run long after
+    // the caller's argument array is gone, so it keeps its own copy; the usual handful of
+    // arguments lives inline, which puts them inside the pooled coroutine frame instead
+    // of in a separate vector allocation. Reads like the std::span regular functions get.
+    class CoroutineArgs
+    {
+    public:
+        static constexpr size_t INLINE_CAPACITY = 4;
+
+        CoroutineArgs() noexcept = default;
+        explicit CoroutineArgs(std::span<const AnyValue> args) : count(args.size())
+        {
+            if (count <= INLINE_CAPACITY)
+                std::copy(args.begin(), args.end(), inline_values);
+            else
+                spilled.assign(args.begin(), args.end());
+        }
+
+        size_t size() const noexcept { return count; }
+        bool empty() const noexcept { return count == 0; }
+
+        const AnyValue *data() const noexcept { return count <= INLINE_CAPACITY ? inline_values : spilled.data(); }
+        const AnyValue *begin() const noexcept { return data(); }
+        const AnyValue *end() const noexcept { return data() + count; }
+        const AnyValue &operator[](size_t i) const noexcept { return data()[i]; }
+
+        // Arguments from `offset` on; empty when fewer were passed
+        std::span<const AnyValue> subspan(size_t offset) const noexcept
+        {
+            return std::span<const AnyValue>(data(), count).subspan(std::min(offset, count));
+        }
+
+        operator std::span<const AnyValue>() const noexcept { return {data(), count}; }
+
+    private:
+        AnyValue inline_values[INLINE_CAPACITY];
+        std::vector<AnyValue> spilled;
+        size_t count = 0;
+    };
+}
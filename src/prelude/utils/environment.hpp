@@ -0,0 +1,111 @@
+#pragma once
+
+#include "types.hpp"
+#include "any_value.hpp"
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace jspp
+{
+    // Heap record holding the bindings of one scope that closures capture.
+    //
+    // Codegen emits a struct per such scope with one AnyValue member per captured
+    // binding, and allocates one record for it when the scope is entered, naming the
+    // members the record traces:
+    //   struct __env_3_t { jspp::AnyValue count, next; };
+    //   auto __env_3 = jspp::make_env<__env_3_t, &__env_3_t::count, &__env_3_t::next>();
+    // Bindings are read and written as `__env_3->count`. A closure naming any of the
+    // scope's bindings holds the whole record through one EnvPtr, however many of them
+    // it uses, and keeps that EnvPtr in a Closure so the collector can see it.
+    template <typename Slots>
+    struct Environment : HeapObject
+    {
+        Slots slots{};
+
+        Environment() noexcept : HeapObject(JsType::Environment) {}
+
+        // A fresh record holding the same values
+        virtual Environment *copy() const = 0;
+    };
+
+    template <typename Slots, AnyValue Slots::*...Bindings>
+    struct EnvironmentRecord final : Environment<Slots>
+    {
+        void trace(HeapTracer visit) override { (visit(this->slots.*Bindings), ...); }
+
+        Environment<Slots> *copy() const override
+        {
+            auto *record = new EnvironmentRecord();
+            record->slots = this->slots;
+            return record;
+        }
+    };
+
+    // Counted handle to an Environment
+    template <typename Slots>
+    class EnvPtr
+    {
+    public:
+        explicit EnvPtr(Environment<Slots> *record) noexcept : handle(AnyValue::from_ptr(record)) {}
+
+        Slots *operator->() const noexcept { return &record()->slots; }
+
+        void trace(HeapTracer visit) { visit(handle); }
+
+        // Moves this handle onto a copy of its record if anything else still holds the
+        // current one, so the closures of each loop iteration keep the bindings they saw
+        void unshare()
+        {
+            if (record()->ref_count > 1)
+                handle = AnyValue::from_ptr(record()->copy());
+        }
+
+    private:
+        Environment<Slots> *record() const noexcept { return static_cast<Environment<Slots> *>(handle.get_ptr()); }
+
+        AnyValue handle;
+    };
+
+    template <typename Slots, AnyValue Slots::*...Bindings>
+    inline EnvPtr<Slots> make_env()
+    {
+        return EnvPtr<Slots>(new EnvironmentRecord<Slots, Bindings...>());
+    }
+
+    // Function body together with the environment records it reads. The records are
+    // passed to the body ahead of its own arguments instead of being captured, so a
+    // JsFunction can trace them:
+    //   jspp::make_closure([=](const jspp::EnvPtr<__env_3_t> &__env_3, jspp::AnyValue, std::span<const jspp::AnyValue> args) mutable -> jspp::AnyValue { ... }, __env_3)
+    template <typename Body, typename... Slots>
+    class Closure
+    {
+    public:
+        Closure(Body body, EnvPtr<Slots>... envs) : body(std::move(body)), envs(std::move(envs)...) {}
+
+        template <typename... Args>
+        auto operator()(Args &&...args) -> std::invoke_result_t<Body &, const EnvPtr<Slots> &..., Args...>
+        {
+            return std::apply([&](const EnvPtr<Slots> &...env) -> decltype(auto)
+                              { return body(env..., std::forward<Args>(args)...); },
+                              envs);
+        }
+
+        void trace(HeapTracer visit)
+        {
+            std::apply([&](EnvPtr<Slots> &...env)
+                       { (env.trace(visit), ...); },
+                       envs);
+        }
+
+    private:
+        Body body;
+        std::tuple<EnvPtr<Slots>...> envs;
+    };
+
+    template <typename Body, typename... Slots>
+    inline Closure<Body, Slots...> make_closure(Body body, EnvPtr<Slots>... envs)
+    {
+        return Closure<Body, Slots...>(std::move(body), std::move(envs)...);
+    }
+}
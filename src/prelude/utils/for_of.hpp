@@ -0,0 +1,154 @@
+#pragma once
+
+#include "types.hpp"
+#include "any_value.hpp"
+#include "utils/access.hpp"
+#include "values/prototypes/array.hpp"
+
+namespace jspp
+{
+    // Drives a `for...of` loop, and the other places that consume an iterable one
+    // element at a time (array destructuring, `yield*`, Array.from, Map and Set
+    // sources). Arrays whose Symbol.iterator is still the built-in one, and
+    // strings, are walked by index with exactly the steps the built-in iterators
+    // would take, so no iterator object, coroutine or {value, done} result is created.
+    // Anything else, including an array whose Symbol.iterator (own or on its
+    // prototype) has been replaced, falls back to the iterator protocol, which
+    // resumes native generators without materialising their results.
+    //
+    //   ForOfCursor cursor(iterable, "name");
+    //   while (cursor.next()) { x = cursor.value(); ... }
+    class ForOfCursor
+    {
+    public:
+        ForOfCursor(AnyValue iterable, const char *name)
+            : source(std::move(iterable))
+        {
+            if (source.is_array() && has_builtin_array_iteration(source))
+            {
+                mode = Mode::ArrayIndex;
+            }
+            else if (source.is_string())
+            {
+                mode = Mode::StringIndex;
+            }
+            else
+            {
+                mode = Mode::Protocol;
+                iterator = Access::get_object_iterator(source, name);
+                next_fn = iterator.get_own_property("next");
+            }
+        }
+
+        // Advances to the next element; false once the iteration is done
+        bool next()
+        {
+            switch (mode)
+            {
+            case Mode::ArrayIndex:
+            {
+                // Length is re-read each step, like the built-in iterator
+                JsArray *array = source.as_array();
+                if (index >= array->length)
+                    return false;
+                current = array->is_packed() && index < array->dense.size()
+                              ? array->dense[index]
+                              : array->get_property(static_cast<uint32_t>(index));
+                ++index;
+                return true;
+            }
+            case Mode::StringIndex:
+            {
+                const std::string &text = source.as_string()->value();
+                if (index >= text.size())
+                    return false;
+                size_t len = utf8_sequence_length(static_cast<unsigned char>(text[index]));
+                if (index + len > text.size())
+                    len = text.size() - index;
+                current = len == 1 ? JsString::from_char(static_cast<unsigned char>(text[index]))
+                                   : AnyValue::make_string(text.substr(index, len));
+                index += len;
+                return true;
+            }
+            case Mode::Protocol:
+            default:
+            {
+                if (exhausted)
+                    return false;
+                exhausted = !Access::iterator_step(iterator, next_fn, current);
+                return !exhausted;
+            }
+            }
+        }
+
+        // IteratorClose for a loop or pattern left before the iterator finished
+        void close()
+        {
+            if (mode == Mode::Protocol && !exhausted)
+            {
+                exhausted = true;
+                Access::call_optional_property_with_optional_call(iterator, "return", {});
+            }
+        }
+
+        const AnyValue &value() const noexcept { return current; }
+
+        // True when iterating `array` would run ArrayPrototypes' own iterator
+        static bool has_builtin_array_iteration(const AnyValue &array)
+        {
+            JsArray *ptr = array.as_array();
+            if (ptr->symbol_props.empty() && (ptr->proto.is_null() || ptr->proto.is_undefined()))
+                return true;
+            AnyValue method = array.get_own_property(AnyValue::from_symbol(WellKnownSymbols::iterator));
+            return method.is_heap_object() && method.get_ptr() == ArrayPrototypes::get_iterator_fn().get_ptr();
+        }
+
+    private:
+        enum class Mode : uint8_t
+        {
+            ArrayIndex,
+            StringIndex,
+            Protocol,
+        };
+
+        static size_t utf8_sequence_length(unsigned char lead) noexcept
+        {
+            if ((lead & 0xE0) == 0xC0)
+                return 2;
+            if ((lead & 0xF0) == 0xE0)
+                return 3;
+            if ((lead & 0xF8) == 0xF0)
+                return 4;
+            return 1;
+        }
+
+        AnyValue source;
+        AnyValue iterator;
+        AnyValue next_fn;
+        AnyValue current;
+        uint64_t index = 0;
+        Mode mode;
+        bool exhausted = false;
+    };
+
+    namespace Access
+    {
+        // Calls `fn` with each value `iterable` produces, under the same rules as for...of.
+        // The iterator is closed if `fn` throws.
+        template <typename Fn>
+        inline void for_each_iterable(const AnyValue &iterable, const char *name, Fn &&fn)
+        {
+            ForOfCursor cursor(iterable, name);
+            try
+            {
+                while (cursor.next())
+                    fn(cursor.value());
+            }
+            catch (...)
+            {
+                cursor.close();
+                throw;
+            }
+        }
+    }
+}
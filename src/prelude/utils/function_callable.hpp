@@ -0,0 +1,131 @@
+#pragma once
+
+#include "types.hpp"
+#include "any_value.hpp"
+#include "utils/coroutine_args.hpp"
+#include "utils/small_buffer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace jspp
+{
+    // What calling a function produces; fixed when the callable is created
+    enum class FunctionKind : uint8_t
+    {
+        Normal,         // AnyValue(AnyValue thisVal, std::span<const AnyValue> args)
+        Generator,      // JsIterator<AnyValue>(AnyValue thisVal, CoroutineArgs args)
+        Async,          // JsPromise(AnyValue thisVal, CoroutineArgs args)
+        AsyncGenerator, // JsAsyncIterator<AnyValue>(AnyValue thisVal, CoroutineArgs args)
+    };
+
+    // Move-only body of a JsFunction: a function pointer table plus the closure, held
+    // in a SmallBuffer (in place when its captures fit in INLINE_SIZE, in a slab block
+    // otherwise). A call is one indirect jump straight into the closure, with no variant
+    // dispatch and no std::function invoker in between.
+    class JsFunctionCallable
+    {
+        // Declared ahead of the public section: the converting constructor's
+        // requires-clause is not a complete-class context
+        // Closure kind, read off the form it can be called with
+        template <typename Fn>
+        static constexpr FunctionKind kind_of()
+        {
+            if constexpr (std::is_invocable_v<Fn &, AnyValue, CoroutineArgs>)
+            {
+                using R = std::invoke_result_t<Fn &, AnyValue, CoroutineArgs>;
+                if constexpr (std::is_same_v<R, JsIterator<AnyValue>>)
+                    return FunctionKind::Generator;
+                else if constexpr (std::is_same_v<R, JsPromise>)
+                    return FunctionKind::Async;
+                else if constexpr (std::is_same_v<R, JsAsyncIterator<AnyValue>>)
+                    return FunctionKind::AsyncGenerator;
+            }
+            return FunctionKind::Normal;
+        }
+
+        template <typename Fn>
+        static constexpr bool is_supported()
+        {
+            return kind_of<Fn>() != FunctionKind::Normal ||
+                   std::is_invocable_r_v<AnyValue, Fn &, AnyValue, std::span<const AnyValue>>;
+        }
+
+        struct Ops : SmallBufferOps
+        {
+            FunctionKind kind;
+            AnyValue (*call)(void *self, const AnyValue &thisVal, std::span<const AnyValue> args);
+            void (*trace)(void *self, HeapTracer visit);
+        };
+        using Storage = SmallBuffer<Ops, 48>;
+
+    public:
+        static constexpr size_t INLINE_SIZE = Storage::INLINE_SIZE;
+
+        JsFunctionCallable() noexcept = default;
+
+        template <typename F>
+            requires(!std::is_same_v<std::decay_t<F>, JsFunctionCallable> && is_supported<std::decay_t<F>>())
+        JsFunctionCallable(F &&fn)
+        {
+            using Fn = std::decay_t<F>;
+            storage.emplace<Fn>(std::forward<F>(fn), &table<Fn>);
+        }
+
+        FunctionKind kind() const noexcept { return ops() ? ops()->kind : FunctionKind::Normal; }
+        explicit operator bool() const noexcept { return ops() != nullptr; }
+
+        AnyValue operator()(const AnyValue &thisVal, std::span<const AnyValue> args)
+        {
+            return ops() ? ops()->call(storage.data(), thisVal, args) : Constants::UNDEFINED;
+        }
+
+        void reset() noexcept { storage.reset(); }
+
+        // Visits the environment records a Closure body holds; other bodies hold none the
+        // collector can see
+        void trace(HeapTracer visit)
+        {
+            if (ops())
+                ops()->trace(storage.data(), visit);
+        }
+
+    private:
+        const Ops *ops() const noexcept { return storage.table(); }
+
+        template <typename Fn>
+        static AnyValue call_span(void *self, const AnyValue &thisVal, std::span<const AnyValue> args)
+        {
+            Fn &fn = Storage::target<Fn>(self);
+            constexpr FunctionKind kind = kind_of<Fn>();
+            if constexpr (kind == FunctionKind::Generator)
+                return AnyValue::from_iterator(fn(thisVal, CoroutineArgs(args)));
+            else if constexpr (kind == FunctionKind::Async)
+                return AnyValue::from_promise(fn(thisVal, CoroutineArgs(args)));
+            else if constexpr (kind == FunctionKind::AsyncGenerator)
+                return AnyValue::from_async_iterator(fn(thisVal, CoroutineArgs(args)));
+            else
+                return fn(thisVal, args);
+        }
+
+        template <typename Fn>
+        static void trace_closure(void *self, HeapTracer visit)
+        {
+            if constexpr (requires(Fn &fn) { fn.trace(visit); })
+                Storage::target<Fn>(self).trace(visit);
+        }
+
+        template <typename Fn>
+        static constexpr Ops table = {
+            Storage::lifetime_ops<Fn>(),
+            kind_of<Fn>(),
+            &call_span<Fn>,
+            &trace_closure<Fn>,
+        };
+
+        Storage storage;
+    };
+}
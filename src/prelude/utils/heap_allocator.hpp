@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace jspp
+{
+    // Thread-local size-class slab allocator. Requests are rounded up to Granule bytes;
+    // each size class carves blocks out of its own SlabSize slabs and recycles them
+    // through an intrusive free list, so the steady state of short-lived allocations is
+    // a pointer pop/push. Requests above MaxSmallSize fall through to ::operator new.
+    //
+    // Slabs are never returned to the system: runtime globals are released during static
+    // destruction, after thread-locals with non-trivial destructors would already be gone,
+    // so the state is deliberately trivially destructible.
+    template <size_t Granule, size_t MaxSmallSize, size_t SlabSize>
+    class SizeClassAllocator
+    {
+    public:
+        static constexpr size_t GRANULE = Granule;
+        static constexpr size_t MAX_SMALL_SIZE = MaxSmallSize;
+        static constexpr size_t CLASS_COUNT = MAX_SMALL_SIZE / GRANULE;
+        static constexpr size_t SLAB_SIZE = SlabSize;
+
+        struct Stats
+        {
+            uint64_t allocations = 0;         // all requests, including large ones
+            uint64_t deallocations = 0;
+            uint64_t large_allocations = 0;   // served by ::operator new
+            uint64_t slabs = 0;               // slabs reserved from the system
+            uint64_t class_allocations[CLASS_COUNT] = {};
+            uint64_t class_live[CLASS_COUNT] = {};
+
+            uint64_t live() const noexcept { return allocations - deallocations; }
+            size_t reserved_bytes() const noexcept { return slabs * SLAB_SIZE; }
+        };
+
+        static void *allocate(size_t size)
+        {
+            State &s = state;
+            ++s.stats.allocations;
+            if (size > MAX_SMALL_SIZE) [[unlikely]]
+            {
+                ++s.stats.large_allocations;
+                return ::operator new(size);
+            }
+
+            size_t cls = class_of(size);
+            ++s.stats.class_allocations[cls];
+            ++s.stats.class_live[cls];
+            if (FreeNode *node = s.free_lists[cls]) [[likely]]
+            {
+                s.free_lists[cls] = node->next;
+                return node;
+            }
+
+            size_t block = (cls + 1) * GRANULE;
+            if (s.bump[cls] == nullptr || static_cast<size_t>(s.bump_end[cls] - s.bump[cls]) < block)
+            {
+                s.bump[cls] = static_cast<char *>(::operator new(SLAB_SIZE));
+                s.bump_end[cls] = s.bump[cls] + SLAB_SIZE;
+                ++s.stats.slabs;
+            }
+            void *result = s.bump[cls];
+            s.bump[cls] += block;
+            return result;
+        }
+
+        static void deallocate(void *ptr, size_t size) noexcept
+        {
+            if (!ptr)
+                return;
+            State &s = state;
+            ++s.stats.deallocations;
+            if (size > MAX_SMALL_SIZE) [[unlikely]]
+            {
+                ::operator delete(ptr);
+                return;
+            }
+
+            size_t cls = class_of(size);
+            --s.stats.class_live[cls];
+            auto *node = static_cast<FreeNode *>(ptr);
+            node->next = s.free_lists[cls];
+            s.free_lists[cls] = node;
+        }
+
+        // Counters for the calling thread
+        static const Stats &stats() noexcept { return state.stats; }
+
+    private:
+        struct FreeNode
+        {
+            FreeNode *next;
+        };
+
+        struct State
+        {
+            FreeNode *free_lists[CLASS_COUNT];
+            char *bump[CLASS_COUNT];
+            char *bump_end[CLASS_COUNT];
+            Stats stats;
+        };
+
+        static constexpr size_t class_of(size_t size) noexcept
+        {
+            return size == 0 ? 0 : (size - 1) / GRANULE;
+        }
+
+        static inline thread_local constinit State state{};
+    };
+
+    // Backs every HeapObject subclass: iterator results, intermediate strings
+    // and other temporaries.
+    using HeapAllocator = SizeClassAllocator<16, 512, 64 * 1024>;
+
+    // Backs coroutine frames for generators, async functions and async generators. A
+    // frame holds the body's locals across suspension, so frames are larger and fewer
+    // than heap values and get coarser classes.
+    using FrameAllocator = SizeClassAllocator<64, 4096, 256 * 1024>;
+}
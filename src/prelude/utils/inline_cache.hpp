@@ -0,0 +1,192 @@
+#pragma once
+
+#include "types.hpp"
+#include "any_value.hpp"
+#include "values/object.hpp"
+#include "values/prototypes/object.hpp"
+
+namespace jspp
+{
+    // Per-site inline cache for named property access on plain objects.
+    // Codegen emits one static PropertyCache for each `obj.name`, `obj.name = v`
+    // and `obj.name(...)` site. Entries are keyed by the receiver's shape, so a hit
+    // costs a shape compare (plus one pointer/shape compare per prototype hop) and
+    // an indexed load. Dictionary-mode objects have no shape and always miss.
+    // Sites name their key with a PropertyKey atom, so filling the cache compares
+    // shape keys by pointer and never builds a std::string.
+    struct PropertyCache
+    {
+        static constexpr uint8_t MAX_ENTRIES = 4;     // polymorphic up to this many receiver shapes
+        static constexpr uint8_t MAX_PROTO_DEPTH = 3; // instance -> class prototype -> base prototype
+
+        struct Entry
+        {
+            const Shape *shape = nullptr;      // receiver shape
+            const Shape *transition = nullptr; // store sites: shape after appending the key
+            JsObject *chain[MAX_PROTO_DEPTH] = {};
+            const Shape *chain_shapes[MAX_PROTO_DEPTH] = {};
+            uint32_t offset = 0;
+            uint8_t depth = 0; // prototype hops to the holder; 0 means an own property
+        };
+
+        Entry entries[MAX_ENTRIES];
+        uint8_t size = 0;
+        uint8_t next_victim = 0;
+
+        // Returns the slot holding the property, or nullptr on a miss.
+        AnyValue *lookup(JsObject *obj) const noexcept
+        {
+            const Shape *shape = obj->shape;
+            for (uint8_t i = 0; i < size; ++i)
+            {
+                const Entry &e = entries[i];
+                if (e.shape != shape || e.transition)
+                    continue;
+                JsObject *holder = obj;
+                for (uint8_t d = 0; d < e.depth; ++d)
+                {
+                    if (!holder->proto.is_object())
+                        return nullptr;
+                    holder = holder->proto.as_object();
+                    if (holder != e.chain[d] || holder->shape != e.chain_shapes[d])
+                        return nullptr;
+                }
+                return &holder->storage[e.offset];
+            }
+            return nullptr;
+        }
+
+        // Returns the cached transition for adding the key to `obj`, or nullptr.
+        Shape *lookup_transition(JsObject *obj) const noexcept
+        {
+            const Shape *shape = obj->shape;
+            for (uint8_t i = 0; i < size; ++i)
+            {
+                if (entries[i].shape == shape && entries[i].transition)
+                    return const_cast<Shape *>(entries[i].transition);
+            }
+            return nullptr;
+        }
+
+        void record_load(JsObject *obj, PropertyKey key)
+        {
+            if (!obj->shape)
+                return;
+            Entry e;
+            e.shape = obj->shape;
+            JsObject *holder = obj;
+            while (true)
+            {
+                if (!holder->shape)
+                    return;
+                auto offset = holder->shape->get_offset(key);
+                if (offset.has_value())
+                {
+                    e.offset = offset.value();
+                    insert(e);
+                    return;
+                }
+                if (e.depth == MAX_PROTO_DEPTH || !holder->proto.is_object())
+                    return;
+                holder = holder->proto.as_object();
+                e.chain[e.depth] = holder;
+                e.chain_shapes[e.depth] = holder->shape;
+                ++e.depth;
+            }
+        }
+
+        // `before` is the receiver's shape before the slow-path store ran.
+        void record_store(JsObject *obj, const Shape *before, PropertyKey key)
+        {
+            if (!before || !obj->shape)
+                return;
+            // Built-in prototype accessors intercept stores before own slots; never cache those keys
+            if (ObjectPrototypes::get(key.str()).has_value())
+                return;
+            Entry e;
+            e.shape = before;
+            if (obj->shape == before)
+            {
+                auto offset = before->get_offset(key);
+                if (!offset.has_value())
+                    return;
+                e.offset = offset.value();
+            }
+            else if (obj->shape->get_parent() == before && obj->shape->atom_at(before->property_count()) == key.get())
+            {
+                e.transition = obj->shape;
+            }
+            else
+            {
+                return;
+            }
+            insert(e);
+        }
+
+    private:
+        void insert(const Entry &e) noexcept
+        {
+            if (size < MAX_ENTRIES)
+            {
+                entries[size++] = e;
+                return;
+            }
+            entries[next_victim] = e;
+            next_victim = (next_victim + 1) % MAX_ENTRIES;
+        }
+    };
+
+    namespace Access
+    {
+        inline AnyValue get_property_cached(const AnyValue &obj, const PropertyKey &key, PropertyCache &cache)
+        {
+            if (!obj.is_object())
+                return obj.get_own_property(key.str());
+
+            JsObject *ptr = obj.as_object();
+            if (AnyValue *slot = cache.lookup(ptr)) [[likely]]
+            {
+                if (!slot->is_data_descriptor() && !slot->is_accessor_descriptor())
+                    return *slot;
+                return AnyValue::resolve_property_for_read(*slot, obj, key.str());
+            }
+
+            AnyValue result = ptr->get_property(key, obj);
+            cache.record_load(ptr, key);
+            return result;
+        }
+
+        inline AnyValue set_property_cached(const AnyValue &obj, const PropertyKey &key, const AnyValue &value, PropertyCache &cache)
+        {
+            if (!obj.is_object())
+                return obj.set_own_property(key.str(), value);
+
+            JsObject *ptr = obj.as_object();
+            if (AnyValue *slot = cache.lookup(ptr)) [[likely]]
+            {
+                if (!slot->is_data_descriptor() && !slot->is_accessor_descriptor())
+                {
+                    *slot = value;
+                    return value;
+                }
+                return AnyValue::resolve_property_for_write(*slot, obj, value, key.str());
+            }
+            if (Shape *next = cache.lookup_transition(ptr))
+            {
+                ptr->shape = next;
+                ptr->storage.push_back(value);
+                return value;
+            }
+
+            const Shape *before = ptr->shape;
+            AnyValue result = ptr->set_property(key, value, obj);
+            cache.record_store(ptr, before, key);
+            return result;
+        }
+
+        inline AnyValue call_property_cached(const AnyValue &obj, const PropertyKey &key, std::span<const AnyValue> args, PropertyCache &cache)
+        {
+            return get_property_cached(obj, key, cache).call(obj, args, key.str().c_str());
+        }
+    }
+}
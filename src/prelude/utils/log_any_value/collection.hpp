@@ -0,0 +1,92 @@
+#pragma once
+#include "types.hpp"
+#include "any_value.hpp"
+#include "values/map.hpp"
+#include "values/set.hpp"
+#include "utils/log_any_value/config.hpp"
+#include "utils/log_any_value/helpers.hpp"
+#include "utils/log_any_value/fwd.hpp"
+#include <string>
+#include <sstream>
+#include <unordered_set>
+#include <algorithm>
+
+namespace jspp
+{
+    namespace LogAnyValue
+    {
+        // Map(n) { k => v, ... } and Set(n) { v, ... }
+        inline std::string format_collection(const AnyValue &val, std::unordered_set<const void *> &visited, int depth)
+        {
+            bool is_map = val.is_map();
+            const OrderedHashTable &table = is_map ? val.as_map()->table : val.as_set()->table;
+            size_t count = table.size();
+
+            std::string indent(depth * 2, ' ');
+            std::string next_indent((depth + 1) * 2, ' ');
+            std::stringstream ss;
+            ss << (is_map ? "Map(" : "Set(") << count << ") ";
+            if (count == 0)
+            {
+                ss << "{}";
+                return ss.str();
+            }
+
+            auto format_entry = [&](const OrderedHashTable::Entry &entry)
+            {
+                std::string out = to_log_string(entry.key, visited, depth + 1);
+                if (is_map)
+                    out += Color::BRIGHT_BLACK + " => " + Color::RESET + to_log_string(entry.value, visited, depth + 1);
+                return out;
+            };
+
+            bool use_horizontal_layout = count <= HORIZONTAL_ARRAY_MAX_ITEMS;
+            for (size_t i = 0; use_horizontal_layout && i < table.extent(); ++i)
+            {
+                if (const auto *entry = table.at(i))
+                    use_horizontal_layout = is_simple_value(entry->key) && (!is_map || is_simple_value(entry->value));
+            }
+
+            if (use_horizontal_layout)
+            {
+                ss << "{ ";
+                bool needs_comma = false;
+                for (size_t i = 0; i < table.extent(); ++i)
+                {
+                    const auto *entry = table.at(i);
+                    if (!entry)
+                        continue;
+                    if (needs_comma)
+                        ss << Color::BRIGHT_BLACK << ", " << Color::RESET;
+                    ss << format_entry(*entry);
+                    needs_comma = true;
+                }
+                ss << " }";
+                return ss.str();
+            }
+
+            ss << "{\n";
+            size_t shown = 0;
+            for (size_t i = 0; i < table.extent() && shown < MAX_ARRAY_ITEMS; ++i)
+            {
+                const auto *entry = table.at(i);
+                if (!entry)
+                    continue;
+                if (shown > 0)
+                    ss << Color::BRIGHT_BLACK << ",\n"
+                       << Color::RESET;
+                ss << next_indent << format_entry(*entry);
+                ++shown;
+            }
+            if (count > shown)
+            {
+                ss << Color::BRIGHT_BLACK << ",\n"
+                   << Color::RESET
+                   << next_indent << Color::BRIGHT_BLACK << "... " << (count - shown) << " more item" << (count - shown > 1 ? "s" : "") << Color::RESET;
+            }
+            ss << "\n"
+               << indent << "}";
+            return ss.str();
+        }
+    }
+}
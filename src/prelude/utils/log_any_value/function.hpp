@@ -20,19 +20,19 @@ namespace jspp
                     if (fn->proto.is_function())
                     {
                         auto parent = fn->proto.as_function();
-                        std::string name = parent->name.value_or("");
+                        std::string name = parent->name ? parent->name : "";
                         if (!name.empty())
                         {
                             extends_part = " extends " + name;
                         }
                     }
                 }
-                std::string name = fn->name.value_or("");
+                std::string name = fn->name ? fn->name : "";
                 return Color::CYAN + std::string("[class ") + (name.empty() ? "(anonymous)" : name) + extends_part + "]" + Color::RESET;
             }
 
             auto type_part = fn->is_generator ? "GeneratorFunction" : "Function";
-            auto name_part = fn->name.has_value() ? ": " + fn->name.value() : " (anonymous)";
+            auto name_part = fn->name ? ": " + std::string(fn->name) : " (anonymous)";
             return Color::CYAN + "[" + type_part + name_part + "]" + Color::RESET;
         }
     }
@@ -10,6 +10,7 @@
 #include "utils/log_any_value/function.hpp"
 #include "utils/log_any_value/object.hpp"
 #include "utils/log_any_value/array.hpp"
+#include "utils/log_any_value/collection.hpp"
 
 #include <unordered_set>
 
@@ -45,6 +46,10 @@ namespace jspp
                     return Color::CYAN + std::string("[Object]") + Color::RESET;
                 if (val.is_array())
                     return Color::CYAN + std::string("[Array]") + Color::RESET;
+                if (val.is_map())
+                    return Color::CYAN + std::string("[Map]") + Color::RESET;
+                if (val.is_set())
+                    return Color::CYAN + std::string("[Set]") + Color::RESET;
             }
 
             // 4. Circular reference detection
@@ -53,6 +58,8 @@ namespace jspp
                 ptr_address = val.as_object();
             else if (val.is_array())
                 ptr_address = val.as_array();
+            else if (val.is_map() || val.is_set())
+                ptr_address = val.get_ptr();
 
             if (ptr_address)
             {
@@ -61,7 +68,7 @@ namespace jspp
                 visited.insert(ptr_address);
             }
 
-            // 5. Complex Types (Objects & Arrays)
+            // 5. Complex Types (Objects, Arrays, Maps & Sets)
             if (val.is_object())
             {
                 return format_object(val, visited, depth);
@@ -72,6 +79,11 @@ namespace jspp
                 return format_array(val, visited, depth);
             }
 
+            if (val.is_map() || val.is_set())
+            {
+                return format_collection(val, visited, depth);
+            }
+
             // 6. DataDescriptor
             if (val.is_data_descriptor())
             {
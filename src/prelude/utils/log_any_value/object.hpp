@@ -8,6 +8,7 @@
 #include <string>
 #include <sstream>
 #include <unordered_set>
+#include <vector>
 
 namespace jspp
 {
@@ -17,12 +18,17 @@ namespace jspp
         {
             auto obj = val.as_object();
 
-            size_t prop_count = obj->storage.size() + obj->symbol_props.size();
+            std::vector<std::pair<const std::string *, const AnyValue *>> own_props;
+            own_props.reserve(obj->own_property_count());
+            obj->for_each_own_property([&](const std::string &key, const AnyValue &prop_val)
+                                       { own_props.emplace_back(&key, &prop_val); });
+
+            size_t prop_count = own_props.size() + obj->symbol_props.size();
             bool use_horizontal_layout = prop_count > 0 && prop_count <= HORIZONTAL_OBJECT_MAX_PROPS;
 
-            for (size_t i = 0; i < obj->storage.size(); ++i)
+            for (const auto &[_, prop_ptr] : own_props)
             {
-                const auto &prop_val = obj->storage[i];
+                const auto &prop_val = *prop_ptr;
                 if (!is_enumerable_property(prop_val))
                 {
                     prop_count--;
@@ -95,10 +101,10 @@ namespace jspp
             {
                 ss << "{ ";
                 size_t current_prop = 0;
-                for (size_t i = 0; i < obj->shape->property_names.size(); ++i)
+                for (const auto &[key_ptr, prop_ptr] : own_props)
                 {
-                    const auto &key = obj->shape->property_names[i];
-                    const auto &prop_val = obj->storage[i];
+                    const auto &key = *key_ptr;
+                    const auto &prop_val = *prop_ptr;
 
                     if (!is_enumerable_property(prop_val))
                         continue;
@@ -137,10 +143,10 @@ namespace jspp
                 {
                     ss << "\n";
                     size_t props_shown = 0;
-                    for (size_t i = 0; i < obj->shape->property_names.size(); ++i)
+                    for (const auto &[key_ptr, prop_ptr] : own_props)
                     {
-                        const auto &key = obj->shape->property_names[i];
-                        const auto &prop_val = obj->storage[i];
+                        const auto &key = *key_ptr;
+                        const auto &prop_val = *prop_ptr;
 
                         if (props_shown >= MAX_OBJECT_PROPS)
                             break;
@@ -40,7 +40,7 @@ namespace jspp
 
             if (val.is_string())
             {
-                const std::string &s = val.as_string()->value;
+                const std::string &s = val.as_string()->value();
                 if (depth == 0)
                     return truncate_string(s);
                 return Color::GREEN + std::string("\"") + truncate_string(s) + "\"" + Color::RESET;
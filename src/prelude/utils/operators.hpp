@@ -8,6 +8,9 @@
 #include <string>    // For std::stod
 #include <algorithm> // For std::all_of
 #include <limits>    // For numeric_limits
+#include <array>
+#include <span>
+#include <vector>
 
 namespace jspp
 {
@@ -41,6 +44,10 @@ namespace jspp
             return AnyValue::make_string("object");
         case JsType::AsyncIterator:
             return AnyValue::make_string("object");
+        case JsType::Map:
+            return AnyValue::make_string("object");
+        case JsType::Set:
+            return AnyValue::make_string("object");
         default:
             return AnyValue::make_string("undefined");
         }
@@ -121,12 +128,16 @@ namespace jspp
     // --- BASIC ARITHMETIC ---
 
     // Function add
+    // String concatenation goes through JsString::concat, which links long operands
+    // into a rope rather than copying them
     inline AnyValue add(const AnyValue &lhs, const AnyValue &rhs)
     {
         if (lhs.is_number() && rhs.is_number())
             return AnyValue::make_number(lhs.as_double() + rhs.as_double());
-        if (lhs.is_string() || rhs.is_string())
-            return AnyValue::make_string(lhs.to_std_string() + rhs.to_std_string());
+        if (lhs.is_string())
+            return JsString::concat(lhs, rhs.is_string() ? rhs : AnyValue::make_string(rhs.to_std_string()));
+        if (rhs.is_string())
+            return JsString::concat(AnyValue::make_string(lhs.to_std_string()), rhs);
         return AnyValue::make_number(add_native(lhs, rhs));
     }
     inline AnyValue add(const AnyValue &lhs, const double &rhs)
@@ -134,7 +145,7 @@ namespace jspp
         if (lhs.is_number())
             return AnyValue::make_number(lhs.as_double() + rhs);
         if (lhs.is_string())
-            return AnyValue::make_string(lhs.to_std_string() + JsNumber::to_std_string(rhs));
+            return JsString::concat(lhs, AnyValue::make_string(JsNumber::to_std_string(rhs)));
         return AnyValue::make_number(add_native(lhs, rhs));
     }
     inline AnyValue add(const double &lhs, const AnyValue &rhs)
@@ -142,7 +153,7 @@ namespace jspp
         if (rhs.is_number())
             return AnyValue::make_number(lhs + rhs.as_double());
         if (rhs.is_string())
-            return AnyValue::make_string(JsNumber::to_std_string(lhs) + rhs.to_std_string());
+            return JsString::concat(AnyValue::make_string(JsNumber::to_std_string(lhs)), rhs);
         return AnyValue::make_number(add_native(lhs, rhs));
     }
     inline AnyValue add(const double &lhs, const double &rhs)
@@ -150,6 +161,42 @@ namespace jspp
         return AnyValue::make_number(lhs + rhs);
     }
 
+    // Template literal `a${b}c`: every part is converted once and copied into a
+    // result buffer sized up front. Parts are the literal chunks and substitutions
+    // in source order, with empty chunks left out.
+    inline AnyValue template_literal(std::span<const AnyValue> parts)
+    {
+        constexpr size_t INLINE_PARTS = 16;
+        std::array<std::string, INLINE_PARTS> inline_text;
+        std::vector<std::string> heap_text;
+        std::string *text = inline_text.data();
+        if (parts.size() > INLINE_PARTS)
+        {
+            heap_text.resize(parts.size());
+            text = heap_text.data();
+        }
+
+        size_t total = 0;
+        for (size_t i = 0; i < parts.size(); ++i)
+        {
+            if (parts[i].is_string())
+            {
+                total += parts[i].as_string()->length();
+            }
+            else
+            {
+                text[i] = parts[i].to_std_string();
+                total += text[i].size();
+            }
+        }
+
+        std::string result;
+        result.reserve(total);
+        for (size_t i = 0; i < parts.size(); ++i)
+            result += parts[i].is_string() ? parts[i].as_string()->value() : text[i];
+        return AnyValue::make_string(std::move(result));
+    }
+
     // Function sub
     inline AnyValue sub(const AnyValue &lhs, const AnyValue &rhs)
     {
@@ -219,7 +266,7 @@ namespace jspp
     inline AnyValue less_than(const AnyValue &lhs, const AnyValue &rhs)
     {
         if (lhs.is_string() && rhs.is_string())
-            return AnyValue::make_boolean(lhs.as_string()->value < rhs.as_string()->value);
+            return AnyValue::make_boolean(lhs.as_string()->value() < rhs.as_string()->value());
 
         return AnyValue::make_boolean(less_than_native(lhs, rhs));
     }
@@ -244,7 +291,7 @@ namespace jspp
     inline AnyValue less_than_or_equal(const AnyValue &lhs, const AnyValue &rhs)
     {
         if (lhs.is_string() && rhs.is_string())
-            return AnyValue::make_boolean(lhs.as_string()->value <= rhs.as_string()->value);
+            return AnyValue::make_boolean(lhs.as_string()->value() <= rhs.as_string()->value());
         return AnyValue::make_boolean(less_than_or_equal_native(lhs, rhs));
     }
     inline AnyValue less_than_or_equal(const AnyValue &lhs, const double &rhs)
@@ -263,7 +310,7 @@ namespace jspp
     inline AnyValue greater_than_or_equal(const AnyValue &lhs, const AnyValue &rhs)
     {
         if (lhs.is_string() && rhs.is_string())
-            return AnyValue::make_boolean(lhs.as_string()->value >= rhs.as_string()->value);
+            return AnyValue::make_boolean(lhs.as_string()->value() >= rhs.as_string()->value());
         return AnyValue::make_boolean(greater_than_or_equal_native(lhs, rhs));
     }
     inline AnyValue greater_than_or_equal(const AnyValue &lhs, const double &rhs)
@@ -27,7 +27,7 @@ namespace jspp
                 return val.as_boolean() ? 1.0 : 0.0;
             if (val.is_string())
             {
-                const std::string &s = val.as_string()->value;
+                const std::string &s = val.as_string()->value();
                 if (s.empty() || std::all_of(s.begin(), s.end(), [](unsigned char c)
                                              { return std::isspace(c); }))
                     return 0.0;
@@ -55,30 +55,39 @@ namespace jspp
             return std::numeric_limits<double>::quiet_NaN();
         }
         // Implements the ToInt32 abstract operation from ECMA-262.
-        inline int32_t ToInt32(const AnyValue &val)
+        inline int32_t ToInt32(double num)
         {
-            double num = ToNumber(val);
+            // Fast path for values that already fit (NaN fails both comparisons)
+            if (num >= -2147483648.0 && num <= 2147483647.0)
+                return static_cast<int32_t>(num);
 
             if (std::isnan(num) || std::isinf(num) || num == 0)
                 return 0;
 
             double posInt = std::signbit(num) ? -std::floor(std::abs(num)) : std::floor(std::abs(num));
             double int32bit = fmod(posInt, 4294967296.0); // 2^32
+            if (int32bit < 0)
+                int32bit += 4294967296.0;
 
             if (int32bit >= 2147483648.0) // 2^31
                 return static_cast<int32_t>(int32bit - 4294967296.0);
             else
                 return static_cast<int32_t>(int32bit);
         }
+        inline int32_t ToInt32(const AnyValue &val)
+        {
+            return ToInt32(ToNumber(val));
+        }
         // Implements the ToUint32 abstract operation from ECMA-262.
+        inline uint32_t ToUint32(double num)
+        {
+            if (num >= 0.0 && num <= 4294967295.0)
+                return static_cast<uint32_t>(num);
+            return static_cast<uint32_t>(ToInt32(num));
+        }
         inline uint32_t ToUint32(const AnyValue &val)
         {
-            double num = ToNumber(val);
-            if (std::isnan(num) || std::isinf(num) || num == 0)
-                return 0;
-            double posInt = std::signbit(num) ? -std::floor(std::abs(num)) : std::floor(std::abs(num));
-            uint32_t uint32bit = static_cast<uint32_t>(fmod(posInt, 4294967296.0));
-            return uint32bit;
+            return ToUint32(ToNumber(val));
         }
     }
 
@@ -98,7 +107,7 @@ namespace jspp
         case JsType::Number:
             return is_truthy(val.as_double());
         case JsType::String:
-            return is_truthy(val.as_string()->value);
+            return val.as_string()->length() != 0;
         case JsType::Boolean:
             return val.as_boolean();
         case JsType::Null:
@@ -116,7 +125,7 @@ namespace jspp
     inline double negate_native(const AnyValue &val) { return -Operators_Private::ToNumber(val); }
     inline double negate_native(double val) { return -val; }
     inline double bitwise_not_native(const AnyValue &val) { return static_cast<double>(~Operators_Private::ToInt32(val)); }
-    inline double bitwise_not_native(double val) { return static_cast<double>(~static_cast<int32_t>(val)); }
+    inline double bitwise_not_native(double val) { return static_cast<double>(~Operators_Private::ToInt32(val)); }
     inline bool logical_not_native(const AnyValue &val) { return !is_truthy(val); }
     inline bool logical_not_native(double val) { return !is_truthy(val); }
 
@@ -151,7 +160,9 @@ namespace jspp
         case JsType::Number:
             return lhs.as_double() == rhs.as_double();
         case JsType::String:
-            return lhs.as_string()->value == rhs.as_string()->value;
+            // Interned literals share one JsString, so identity settles most comparisons
+            return lhs.as_string() == rhs.as_string() ||
+                   (lhs.as_string()->length() == rhs.as_string()->length() && lhs.as_string()->value() == rhs.as_string()->value());
         case JsType::Array:
             return lhs.as_array() == rhs.as_array();
         case JsType::Object:
@@ -164,6 +175,10 @@ namespace jspp
             return lhs.as_async_iterator() == rhs.as_async_iterator();
         case JsType::Promise:
             return lhs.as_promise() == rhs.as_promise();
+        case JsType::Map:
+            return lhs.as_map() == rhs.as_map();
+        case JsType::Set:
+            return lhs.as_set() == rhs.as_set();
         case JsType::Symbol:
             return lhs.as_symbol() == rhs.as_symbol();
         case JsType::DataDescriptor:
@@ -216,12 +231,12 @@ namespace jspp
         {
             return is_equal_to_native(lhs, AnyValue::make_number(rhs.as_boolean() ? 1.0 : 0.0));
         }
-        if ((lhs_type == JsType::Object || lhs_type == JsType::Array || lhs_type == JsType::Function || lhs_type == JsType::Promise || lhs_type == JsType::Iterator) &&
+        if ((lhs_type == JsType::Object || lhs_type == JsType::Array || lhs_type == JsType::Function || lhs_type == JsType::Promise || lhs_type == JsType::Iterator || lhs_type == JsType::Map || lhs_type == JsType::Set) &&
             (rhs_type == JsType::String || rhs_type == JsType::Number || rhs_type == JsType::Symbol))
         {
             return is_equal_to_native(AnyValue::make_string(lhs.to_std_string()), rhs);
         }
-        if ((rhs_type == JsType::Object || rhs_type == JsType::Array || rhs_type == JsType::Function || rhs_type == JsType::Promise || rhs_type == JsType::Iterator) &&
+        if ((rhs_type == JsType::Object || rhs_type == JsType::Array || rhs_type == JsType::Function || rhs_type == JsType::Promise || rhs_type == JsType::Iterator || rhs_type == JsType::Map || rhs_type == JsType::Set) &&
             (lhs_type == JsType::String || lhs_type == JsType::Number || lhs_type == JsType::Symbol))
         {
             return is_equal_to_native(lhs, AnyValue::make_string(rhs.to_std_string()));
@@ -310,7 +325,7 @@ namespace jspp
     // --- PRIMITIVE BITWISE OPERATORS ---
     inline double bitwise_and_native(const double &lhs, const double &rhs)
     {
-        return static_cast<double>(static_cast<int32_t>(lhs) & static_cast<int32_t>(rhs));
+        return static_cast<double>(Operators_Private::ToInt32(lhs) & Operators_Private::ToInt32(rhs));
     }
     inline double bitwise_and_native(const AnyValue &lhs, const AnyValue &rhs) { return bitwise_and_native(Operators_Private::ToInt32(lhs), Operators_Private::ToInt32(rhs)); }
     inline double bitwise_and_native(const AnyValue &lhs, const double &rhs) { return bitwise_and_native(Operators_Private::ToInt32(lhs), rhs); }
@@ -318,7 +333,7 @@ namespace jspp
 
     inline double bitwise_or_native(const double &lhs, const double &rhs)
     {
-        return static_cast<double>(static_cast<int32_t>(lhs) | static_cast<int32_t>(rhs));
+        return static_cast<double>(Operators_Private::ToInt32(lhs) | Operators_Private::ToInt32(rhs));
     }
     inline double bitwise_or_native(const AnyValue &lhs, const AnyValue &rhs) { return bitwise_or_native(Operators_Private::ToInt32(lhs), Operators_Private::ToInt32(rhs)); }
     inline double bitwise_or_native(const AnyValue &lhs, const double &rhs) { return bitwise_or_native(Operators_Private::ToInt32(lhs), rhs); }
@@ -326,7 +341,7 @@ namespace jspp
 
     inline double bitwise_xor_native(const double &lhs, const double &rhs)
     {
-        return static_cast<double>(static_cast<int32_t>(lhs) ^ static_cast<int32_t>(rhs));
+        return static_cast<double>(Operators_Private::ToInt32(lhs) ^ Operators_Private::ToInt32(rhs));
     }
     inline double bitwise_xor_native(const AnyValue &lhs, const AnyValue &rhs) { return bitwise_xor_native(Operators_Private::ToInt32(lhs), Operators_Private::ToInt32(rhs)); }
     inline double bitwise_xor_native(const AnyValue &lhs, const double &rhs) { return bitwise_xor_native(Operators_Private::ToInt32(lhs), rhs); }
@@ -334,7 +349,7 @@ namespace jspp
 
     inline double left_shift_native(const double &lhs, const double &rhs)
     {
-        return static_cast<double>(static_cast<int32_t>(lhs) << (static_cast<int32_t>(rhs) & 0x1F));
+        return static_cast<double>(Operators_Private::ToInt32(lhs) << (Operators_Private::ToUint32(rhs) & 0x1F));
     }
     inline double left_shift_native(const AnyValue &lhs, const AnyValue &rhs) { return left_shift_native(Operators_Private::ToInt32(lhs), Operators_Private::ToInt32(rhs)); }
     inline double left_shift_native(const AnyValue &lhs, const double &rhs) { return left_shift_native(Operators_Private::ToInt32(lhs), rhs); }
@@ -342,7 +357,7 @@ namespace jspp
 
     inline double right_shift_native(const double &lhs, const double &rhs)
     {
-        return static_cast<double>(static_cast<int32_t>(lhs) >> (static_cast<int32_t>(rhs) & 0x1F));
+        return static_cast<double>(Operators_Private::ToInt32(lhs) >> (Operators_Private::ToUint32(rhs) & 0x1F));
     }
     inline double right_shift_native(const AnyValue &lhs, const AnyValue &rhs) { return right_shift_native(Operators_Private::ToInt32(lhs), Operators_Private::ToInt32(rhs)); }
     inline double right_shift_native(const AnyValue &lhs, const double &rhs) { return right_shift_native(Operators_Private::ToInt32(lhs), rhs); }
@@ -350,8 +365,8 @@ namespace jspp
 
     inline double unsigned_right_shift_native(const double &lhs, const double &rhs)
     {
-        uint32_t l = static_cast<uint32_t>(fmod(lhs, 4294967296.0));
-        return static_cast<double>(l >> (static_cast<int32_t>(rhs) & 0x1F));
+        uint32_t l = Operators_Private::ToUint32(lhs);
+        return static_cast<double>(l >> (Operators_Private::ToUint32(rhs) & 0x1F));
     }
     inline double unsigned_right_shift_native(const AnyValue &lhs, const AnyValue &rhs) { return unsigned_right_shift_native(Operators_Private::ToUint32(lhs), Operators_Private::ToInt32(rhs)); }
     inline double unsigned_right_shift_native(const AnyValue &lhs, const double &rhs) { return unsigned_right_shift_native(Operators_Private::ToUint32(lhs), rhs); }
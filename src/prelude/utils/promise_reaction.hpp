@@ -0,0 +1,66 @@
+#pragma once
+
+#include "types.hpp"
+#include "any_value.hpp"
+#include "utils/small_buffer.hpp"
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace jspp
+{
+    // Move-only `void(const AnyValue &)` callback a pending promise runs once it settles.
+    //
+    // Reactions stay in the promise state until it settles, so a reaction whose handler
+    // reaches back to the promise forms a cycle. As with JsFunctionCallable, a stored
+    // object that defines `trace(HeapTracer)` exposes its captured values to the cycle
+    // collector; plain lambdas expose nothing and keep their captures alive.
+    class PromiseReaction
+    {
+        struct Ops : SmallBufferOps
+        {
+            void (*invoke)(void *self, const AnyValue &value);
+            void (*trace)(void *self, HeapTracer visit);
+        };
+        using Storage = SmallBuffer<Ops, 48>;
+
+    public:
+        static constexpr size_t INLINE_SIZE = Storage::INLINE_SIZE;
+
+        PromiseReaction() noexcept = default;
+
+        template <typename F>
+            requires(!std::is_same_v<std::decay_t<F>, PromiseReaction> && std::is_invocable_v<std::decay_t<F> &, const AnyValue &>)
+        PromiseReaction(F &&fn)
+        {
+            storage.emplace<std::decay_t<F>>(std::forward<F>(fn), &table<std::decay_t<F>>);
+        }
+
+        void operator()(const AnyValue &value) { storage.table()->invoke(storage.data(), value); }
+        explicit operator bool() const noexcept { return storage.table() != nullptr; }
+
+        void trace(HeapTracer visit)
+        {
+            if (storage.table())
+                storage.table()->trace(storage.data(), visit);
+        }
+
+    private:
+        template <typename Fn>
+        static void trace_captures(void *self, HeapTracer visit)
+        {
+            if constexpr (requires(Fn &fn) { fn.trace(visit); })
+                Storage::target<Fn>(self).trace(visit);
+        }
+
+        template <typename Fn>
+        static constexpr Ops table = {
+            Storage::lifetime_ops<Fn>(),
+            [](void *self, const AnyValue &value)
+            { Storage::target<Fn>(self)(value); },
+            &trace_captures<Fn>,
+        };
+
+        Storage storage;
+    };
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "types.hpp"
+#include <array>
+#include <bit>
+#include <string_view>
+
+namespace jspp
+{
+    struct PrototypeEntry
+    {
+        std::string_view name;
+        AnyValue &(*getter)();
+    };
+
+    // Compile-time perfect hash from a built-in prototype's property names to their
+    // getters. A lookup is one hash, one slot load and one string compare; the seed
+    // search runs in the constructor, so a table that cannot be built fails to compile.
+    template <size_t N>
+    class PrototypeTable
+    {
+    public:
+        static constexpr size_t SLOT_COUNT = std::bit_ceil(N * 4);
+
+        consteval explicit PrototypeTable(const std::array<PrototypeEntry, N> &list) : entries(list)
+        {
+            for (seed = 0; seed < MAX_SEED; ++seed)
+            {
+                if (try_seed())
+                    return;
+            }
+            throw "PrototypeTable: no perfect hash seed found";
+        }
+
+        AnyValue *find(std::string_view key) const
+        {
+            uint8_t slot = slots[hash(key, seed) & (SLOT_COUNT - 1)];
+            if (slot == EMPTY)
+                return nullptr;
+            const auto &entry = entries[slot];
+            return entry.name == key ? &entry.getter() : nullptr;
+        }
+
+    private:
+        static_assert(N < 255, "PrototypeTable indexes entries with uint8_t");
+        static constexpr uint8_t EMPTY = 0xFF;
+        static constexpr uint32_t MAX_SEED = 1u << 16;
+
+        std::array<PrototypeEntry, N> entries;
+        std::array<uint8_t, SLOT_COUNT> slots{};
+        uint32_t seed = 0;
+
+        // Seeded FNV-1a with a final avalanche so the low bits used for slot selection mix well
+        static constexpr uint32_t hash(std::string_view key, uint32_t seed) noexcept
+        {
+            uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+            for (char c : key)
+            {
+                h ^= static_cast<uint8_t>(c);
+                h *= 16777619u;
+            }
+            h ^= h >> 16;
+            h *= 0x7FEB352Du;
+            h ^= h >> 15;
+            return h;
+        }
+
+        constexpr bool try_seed()
+        {
+            slots.fill(EMPTY);
+            for (size_t i = 0; i < N; ++i)
+            {
+                auto &slot = slots[hash(entries[i].name, seed) & (SLOT_COUNT - 1)];
+                if (slot != EMPTY)
+                    return false;
+                slot = static_cast<uint8_t>(i);
+            }
+            return true;
+        }
+    };
+}
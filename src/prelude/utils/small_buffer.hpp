@@ -0,0 +1,171 @@
+#pragma once
+
+#include "utils/heap_allocator.hpp"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace jspp
+{
+    // Entries every SmallBuffer operations table starts with
+    struct SmallBufferOps
+    {
+        void (*relocate)(void *from, void *to) noexcept; // move-construct into `to`, destroy `from`
+        void (*destroy)(void *self) noexcept;
+    };
+
+    // Move-only storage for one type-erased object, shared by Task and JsFunctionCallable.
+    //
+    // The owner defines `Ops`, a table deriving from SmallBufferOps with its own call
+    // entries, and builds one constexpr instance per stored type. Those entries reach
+    // the object through target<Fn>(). Objects that fit in InlineSize bytes and
+    // move without throwing live in place and are relocated by move. Anything else is
+    // put in a HeapAllocator block, or an aligned ::operator new block when it is
+    // over-aligned, and only the pointer moves.
+    template <typename Ops, size_t InlineSize>
+    class SmallBuffer
+    {
+        static_assert(std::is_base_of_v<SmallBufferOps, Ops>);
+
+    public:
+        static constexpr size_t INLINE_SIZE = InlineSize;
+
+        template <typename Fn>
+        static constexpr bool stored_inline()
+        {
+            return sizeof(Fn) <= INLINE_SIZE && alignof(Fn) <= alignof(std::max_align_t) &&
+                   std::is_nothrow_move_constructible_v<Fn>;
+        }
+
+        // The object behind `self`, the storage passed to every Ops entry
+        template <typename Fn>
+        static Fn &target(void *self) noexcept
+        {
+            if constexpr (stored_inline<Fn>())
+                return *std::launder(static_cast<Fn *>(self));
+            else
+                return **static_cast<Fn **>(self);
+        }
+
+        // The SmallBufferOps part of the table for Fn
+        template <typename Fn>
+        static constexpr SmallBufferOps lifetime_ops()
+        {
+            if constexpr (stored_inline<Fn>())
+                return {
+                    [](void *from, void *to) noexcept
+                    {
+                        Fn *src = std::launder(static_cast<Fn *>(from));
+                        ::new (to) Fn(std::move(*src));
+                        src->~Fn();
+                    },
+                    [](void *self) noexcept
+                    { std::launder(static_cast<Fn *>(self))->~Fn(); },
+                };
+            else
+                return {
+                    [](void *from, void *to) noexcept
+                    { ::new (to) Fn *(*static_cast<Fn **>(from)); },
+                    [](void *self) noexcept
+                    {
+                        Fn *fn = *static_cast<Fn **>(self);
+                        fn->~Fn();
+                        deallocate_block<Fn>(fn);
+                    },
+                };
+        }
+
+        SmallBuffer() noexcept = default;
+
+        SmallBuffer(SmallBuffer &&other) noexcept : ops(other.ops)
+        {
+            if (ops)
+            {
+                ops->relocate(other.storage, storage);
+                other.ops = nullptr;
+            }
+        }
+
+        SmallBuffer &operator=(SmallBuffer &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                if (other.ops)
+                {
+                    other.ops->relocate(other.storage, storage);
+                    ops = std::exchange(other.ops, nullptr);
+                }
+            }
+            return *this;
+        }
+
+        SmallBuffer(const SmallBuffer &) = delete;
+        SmallBuffer &operator=(const SmallBuffer &) = delete;
+
+        ~SmallBuffer() { reset(); }
+
+        // Stores `fn` as a Fn that `table` operates on
+        template <typename Fn, typename F>
+        void emplace(F &&fn, const Ops *table)
+        {
+            reset();
+            if constexpr (stored_inline<Fn>())
+            {
+                ::new (static_cast<void *>(storage)) Fn(std::forward<F>(fn));
+            }
+            else
+            {
+                void *block = allocate_block<Fn>();
+                Fn *object;
+                try
+                {
+                    object = ::new (block) Fn(std::forward<F>(fn));
+                }
+                catch (...)
+                {
+                    deallocate_block<Fn>(block);
+                    throw;
+                }
+                ::new (static_cast<void *>(storage)) Fn *(object);
+            }
+            ops = table;
+        }
+
+        const Ops *table() const noexcept { return ops; }
+        void *data() noexcept { return storage; }
+
+        void reset() noexcept
+        {
+            if (ops)
+            {
+                ops->destroy(storage);
+                ops = nullptr;
+            }
+        }
+
+    private:
+        // HeapAllocator blocks are aligned for max_align_t; stricter types go to ::operator new
+        template <typename Fn>
+        static void *allocate_block()
+        {
+            if constexpr (alignof(Fn) > alignof(std::max_align_t))
+                return ::operator new(sizeof(Fn), std::align_val_t(alignof(Fn)));
+            else
+                return HeapAllocator::allocate(sizeof(Fn));
+        }
+
+        template <typename Fn>
+        static void deallocate_block(void *block) noexcept
+        {
+            if constexpr (alignof(Fn) > alignof(std::max_align_t))
+                ::operator delete(block, sizeof(Fn), std::align_val_t(alignof(Fn)));
+            else
+                HeapAllocator::deallocate(block, sizeof(Fn));
+        }
+
+        const Ops *ops = nullptr;
+        alignas(std::max_align_t) unsigned char storage[INLINE_SIZE];
+    };
+}
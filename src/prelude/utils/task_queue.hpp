@@ -0,0 +1,116 @@
+#pragma once
+
+#include "utils/small_buffer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace jspp
+{
+    // Move-only `void()` callable with inline storage for small captures.
+    //
+    // Scheduler callbacks capture a handful of words (a coroutine handle, a callback
+    // plus its argument), so they are stored in place and relocated by move; only
+    // captures larger than INLINE_SIZE go to the heap. Unlike std::function, a Task
+    // is never copied, so queueing and dequeueing cost a move each.
+    class Task
+    {
+        struct Ops : SmallBufferOps
+        {
+            void (*invoke)(void *self);
+        };
+        using Storage = SmallBuffer<Ops, 48>;
+
+    public:
+        static constexpr size_t INLINE_SIZE = Storage::INLINE_SIZE;
+
+        Task() noexcept = default;
+
+        template <typename F>
+            requires(!std::is_same_v<std::decay_t<F>, Task> && std::is_invocable_v<std::decay_t<F> &>)
+        Task(F &&fn)
+        {
+            storage.emplace<std::decay_t<F>>(std::forward<F>(fn), &table<std::decay_t<F>>);
+        }
+
+        void operator()() { storage.table()->invoke(storage.data()); }
+        explicit operator bool() const noexcept { return storage.table() != nullptr; }
+        void reset() noexcept { storage.reset(); }
+
+    private:
+        template <typename Fn>
+        static constexpr Ops table = {
+            Storage::lifetime_ops<Fn>(),
+            [](void *self)
+            { Storage::target<Fn>(self)(); },
+        };
+
+        Storage storage;
+    };
+
+    // FIFO of Tasks in a power-of-two ring buffer. Push and pop move a Task in and
+    // out of a slot; the buffer only grows, so a steady-state loop allocates nothing.
+    class TaskQueue
+    {
+    public:
+        TaskQueue() noexcept = default;
+        TaskQueue(const TaskQueue &) = delete;
+        TaskQueue &operator=(const TaskQueue &) = delete;
+
+        ~TaskQueue()
+        {
+            while (!empty())
+                pop();
+            ::operator delete(slots);
+        }
+
+        bool empty() const noexcept { return head == tail; }
+        size_t size() const noexcept { return tail - head; }
+
+        void push(Task task)
+        {
+            if (size() == capacity)
+                grow();
+            ::new (static_cast<void *>(&slots[tail & (capacity - 1)])) Task(std::move(task));
+            ++tail;
+        }
+
+        // Moves the front task out; callers run it after popping so it may enqueue freely.
+        Task pop() noexcept
+        {
+            Task &front = slots[head & (capacity - 1)];
+            Task task(std::move(front));
+            front.~Task();
+            ++head;
+            return task;
+        }
+
+    private:
+        static constexpr size_t INITIAL_CAPACITY = 64;
+
+        Task *slots = nullptr;
+        size_t capacity = 0;
+        size_t head = 0; // monotonically increasing; masked on access
+        size_t tail = 0;
+
+        void grow()
+        {
+            size_t new_capacity = capacity ? capacity * 2 : INITIAL_CAPACITY;
+            Task *fresh = static_cast<Task *>(::operator new(new_capacity * sizeof(Task)));
+            size_t count = size();
+            for (size_t i = 0; i < count; ++i)
+            {
+                Task &src = slots[(head + i) & (capacity - 1)];
+                ::new (static_cast<void *>(&fresh[i])) Task(std::move(src));
+                src.~Task();
+            }
+            ::operator delete(slots);
+            slots = fresh;
+            capacity = new_capacity;
+            head = 0;
+            tail = count;
+        }
+    };
+}
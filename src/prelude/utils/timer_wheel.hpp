@@ -0,0 +1,332 @@
+#pragma once
+
+#include "task_queue.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace jspp
+{
+    // Hierarchical timing wheel (Varghese & Lauck) with 1 ms ticks.
+    //
+    // LEVELS wheels of SLOTS slots each; level k slot s holds timers due within the
+    // s-th 64^k ms stretch of the current level k+1 block. Timers are pooled nodes
+    // linked into their slot, so scheduling and cancelling are O(1). When time reaches
+    // the start of a higher-level slot its timers cascade down, and a level-0 slot holds
+    // exactly the timers due on that tick. Occupancy bitmaps let `collect` jump straight
+    // to the next tick with work instead of stepping through idle milliseconds.
+    //
+    // Timer ids pack the node index with a per-node generation, so an id that already
+    // fired or was cleared can never cancel a later timer that reuses its node. Ids are
+    // 64-bit on every target and use 52 bits (20 index, 32 generation), so they survive
+    // the round trip through a JS number exactly.
+    class TimerWheel
+    {
+    public:
+        using Tick = uint64_t; // milliseconds since the owner's epoch
+        using Id = uint64_t;
+
+        static constexpr unsigned SLOT_BITS = 6;
+        static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+        static constexpr unsigned LEVELS = 6; // 2^36 ms; Scheduler::clamp_delay keeps delays below 2^31
+
+        TimerWheel()
+        {
+            for (auto &level : heads)
+                std::fill(std::begin(level), std::end(level), NONE);
+        }
+
+        TimerWheel(const TimerWheel &) = delete;
+        TimerWheel &operator=(const TimerWheel &) = delete;
+
+        bool empty() const noexcept { return live == 0; }
+        size_t size() const noexcept { return live; }
+
+        // `interval` of 0 makes a one-shot timer. The timer comes due on tick `now + delay`,
+        // so callers pass the current time rounded up to keep it from firing early.
+        Id schedule(Task task, Tick now, Tick delay, Tick interval)
+        {
+            if (live == 0)
+                current = std::max(current, now);
+
+            uint32_t index = allocate_node();
+            Node &node = nodes[index];
+            node.task = std::move(task);
+            node.due = now + delay;
+            node.interval = interval;
+            node.seq = next_seq++;
+            node.state = State::Scheduled;
+            ++live;
+            place(index);
+            return make_id(index, node.generation);
+        }
+
+        void cancel(Id id) noexcept
+        {
+            if ((id & INDEX_MASK) == 0 || (id >> INDEX_BITS) > UINT32_MAX)
+                return;
+            uint32_t index = static_cast<uint32_t>((id & INDEX_MASK) - 1);
+            if (index >= nodes.size())
+                return;
+            Node &node = nodes[index];
+            if (node.generation != static_cast<uint32_t>(id >> INDEX_BITS))
+                return;
+            switch (node.state)
+            {
+            case State::Scheduled:
+                unlink(index);
+                release(index);
+                break;
+            case State::Expired:
+            case State::Running:
+                // Still referenced from the expired batch or the running frame
+                node.state = State::Cancelled;
+                break;
+            case State::Free:
+            case State::Cancelled:
+                break;
+            }
+        }
+
+        // Moves every timer due at or before `now` into the expired batch, in due
+        // order (ties in scheduling order). Returns the number collected.
+        size_t collect(Tick now)
+        {
+            size_t before = expired.size() - expired_cursor;
+            while (current <= now)
+            {
+                process_tick(current);
+                current = std::min(next_event_from(current + 1), now + 1);
+            }
+            return expired.size() - expired_cursor - before;
+        }
+
+        // Runs the next collected timer, rescheduling intervals at `now() + interval`.
+        // Returns false once the expired batch is exhausted.
+        template <typename Clock>
+        bool run_next(Clock &&now)
+        {
+            while (expired_cursor < expired.size())
+            {
+                uint32_t index = expired[expired_cursor++];
+                if (nodes[index].state == State::Cancelled)
+                {
+                    release(index);
+                    continue;
+                }
+
+                // Move the task out: the callback may schedule timers and grow `nodes`
+                nodes[index].state = State::Running;
+                Task task = std::move(nodes[index].task);
+                try
+                {
+                    task();
+                }
+                catch (...)
+                {
+                    finish(index, std::move(task), now);
+                    throw;
+                }
+                finish(index, std::move(task), now);
+                return true;
+            }
+            expired.clear();
+            expired_cursor = 0;
+            return false;
+        }
+
+        // The next tick at which `collect` has work (an expiry or a cascade)
+        std::optional<Tick> next_event() const noexcept
+        {
+            if (expired_cursor < expired.size())
+                return current;
+            if (live == 0)
+                return std::nullopt;
+            Tick next = next_event_from(current);
+            return next == NEVER ? std::nullopt : std::optional<Tick>(next);
+        }
+
+    private:
+        static constexpr uint32_t NONE = UINT32_MAX;
+        static constexpr unsigned INDEX_BITS = 20;
+        static constexpr Id INDEX_MASK = (Id{1} << INDEX_BITS) - 1;
+        static constexpr Tick NEVER = UINT64_MAX;
+
+        enum class State : uint8_t
+        {
+            Free,
+            Scheduled, // linked into a wheel slot
+            Expired,   // in the expired batch
+            Running,
+            Cancelled, // cleared while expired or running; released by run_next
+        };
+
+        struct Node
+        {
+            Task task;
+            Tick due = 0;
+            Tick interval = 0;
+            uint64_t seq = 0;
+            uint32_t next = NONE; // slot list, or free list while Free
+            uint32_t prev = NONE;
+            uint32_t generation = 0; // wraps at 2^32, matching the id packing
+            uint8_t level = 0;
+            uint8_t slot = 0;
+            State state = State::Free;
+        };
+
+        std::vector<Node> nodes;
+        uint32_t free_head = NONE;
+        size_t live = 0;
+        uint64_t next_seq = 0;
+
+        uint32_t heads[LEVELS][SLOTS];
+        uint64_t occupied[LEVELS] = {};
+        Tick current = 0; // first tick not yet processed
+
+        std::vector<uint32_t> expired;
+        size_t expired_cursor = 0;
+
+        static Id make_id(uint32_t index, uint32_t generation) noexcept
+        {
+            return (static_cast<Id>(generation) << INDEX_BITS) | (index + 1);
+        }
+
+        static unsigned slot_of(Tick tick, unsigned level) noexcept
+        {
+            return static_cast<unsigned>(tick >> (level * SLOT_BITS)) & (SLOTS - 1);
+        }
+
+        uint32_t allocate_node()
+        {
+            if (free_head != NONE)
+            {
+                uint32_t index = free_head;
+                free_head = nodes[index].next;
+                return index;
+            }
+            if (nodes.size() >= INDEX_MASK)
+                throw std::length_error("too many active timers");
+            nodes.emplace_back();
+            return static_cast<uint32_t>(nodes.size() - 1);
+        }
+
+        void release(uint32_t index) noexcept
+        {
+            Node &node = nodes[index];
+            node.task.reset();
+            node.state = State::Free;
+            ++node.generation;
+            node.next = free_head;
+            free_head = index;
+            --live;
+        }
+
+        void finish(uint32_t index, Task &&task, auto &now)
+        {
+            Node &node = nodes[index];
+            if (node.state == State::Running && node.interval > 0)
+            {
+                node.task = std::move(task);
+                node.due = now() + node.interval;
+                node.state = State::Scheduled;
+                place(index);
+            }
+            else
+            {
+                release(index);
+            }
+        }
+
+        // Links a node into the slot for its due tick relative to `current`
+        void place(uint32_t index) noexcept
+        {
+            Node &node = nodes[index];
+            Tick due = std::max(node.due, current);
+            unsigned level = 0;
+            while (level + 1 < LEVELS && (due >> ((level + 1) * SLOT_BITS)) != (current >> ((level + 1) * SLOT_BITS)))
+                ++level;
+            unsigned slot = slot_of(due, level);
+
+            node.level = static_cast<uint8_t>(level);
+            node.slot = static_cast<uint8_t>(slot);
+            node.prev = NONE;
+            node.next = heads[level][slot];
+            if (node.next != NONE)
+                nodes[node.next].prev = index;
+            heads[level][slot] = index;
+            occupied[level] |= uint64_t{1} << slot;
+        }
+
+        void unlink(uint32_t index) noexcept
+        {
+            Node &node = nodes[index];
+            if (node.prev != NONE)
+                nodes[node.prev].next = node.next;
+            else
+                heads[node.level][node.slot] = node.next;
+            if (node.next != NONE)
+                nodes[node.next].prev = node.prev;
+            if (heads[node.level][node.slot] == NONE)
+                occupied[node.level] &= ~(uint64_t{1} << node.slot);
+        }
+
+        uint32_t detach_slot(unsigned level, unsigned slot) noexcept
+        {
+            uint32_t head = heads[level][slot];
+            heads[level][slot] = NONE;
+            occupied[level] &= ~(uint64_t{1} << slot);
+            return head;
+        }
+
+        void process_tick(Tick tick)
+        {
+            // Higher levels first: their timers may land in a lower slot that starts now
+            for (unsigned level = LEVELS - 1; level > 0; --level)
+            {
+                if ((tick & ((Tick{1} << (level * SLOT_BITS)) - 1)) != 0)
+                    continue;
+                for (uint32_t index = detach_slot(level, slot_of(tick, level)); index != NONE;)
+                {
+                    uint32_t next = nodes[index].next;
+                    place(index);
+                    index = next;
+                }
+            }
+
+            size_t first = expired.size();
+            for (uint32_t index = detach_slot(0, slot_of(tick, 0)); index != NONE; index = nodes[index].next)
+            {
+                nodes[index].state = State::Expired;
+                expired.push_back(index);
+            }
+            if (expired.size() - first > 1)
+            {
+                std::sort(expired.begin() + first, expired.end(), [this](uint32_t a, uint32_t b)
+                          { return nodes[a].seq < nodes[b].seq; });
+            }
+        }
+
+        // Earliest tick >= `from` that expires a level-0 slot or cascades a higher one
+        Tick next_event_from(Tick from) const noexcept
+        {
+            Tick best = NEVER;
+            for (unsigned level = 0; level < LEVELS; ++level)
+            {
+                unsigned shift = level * SLOT_BITS;
+                uint64_t pending = occupied[level] & (~uint64_t{0} << slot_of(from, level));
+                if (pending == 0)
+                    continue;
+                unsigned slot = static_cast<unsigned>(std::countr_zero(pending));
+                Tick block = (from >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+                Tick tick = std::max(from, block + (static_cast<Tick>(slot) << shift));
+                best = std::min(best, tick);
+            }
+            return best;
+        }
+    };
+}
@@ -1,14 +1,57 @@
 #include "jspp.hpp"
 #include "values/array.hpp"
 #include "values/prototypes/array.hpp"
+#include "utils/prototype_table.hpp"
 
 namespace jspp {
 
 // --- JsArray Implementation ---
 
-JsArray::JsArray() : proto(Constants::Null), length(0) {}
-JsArray::JsArray(const std::vector<jspp::AnyValue> &items) : dense(items), proto(Constants::Null), length(items.size()) {}
-JsArray::JsArray(std::vector<jspp::AnyValue> &&items) : dense(std::move(items)), proto(Constants::Null), length(dense.size()) {}
+JsArray::JsArray() : HeapObject(JsType::Array), proto(Constants::Null), length(0) {}
+JsArray::JsArray(const std::vector<jspp::AnyValue> &items) : HeapObject(JsType::Array), dense(items), proto(Constants::Null), length(items.size())
+{
+    for (const auto &item : dense)
+        note_element(item);
+}
+JsArray::JsArray(std::vector<jspp::AnyValue> &&items) : HeapObject(JsType::Array), dense(std::move(items)), proto(Constants::Null), length(dense.size())
+{
+    for (const auto &item : dense)
+        note_element(item);
+}
+
+void JsArray::trace(HeapTracer visit)
+{
+    for (auto &value : dense)
+        visit(value);
+    for (auto &[idx, value] : sparse)
+        visit(value);
+    for (auto &[key, value] : props)
+        visit(value);
+    for (auto &[key, value] : symbol_props)
+        visit(value);
+    visit(proto);
+}
+
+void JsArray::note_element(const AnyValue &value) noexcept
+{
+    if (kind == ElementKind::PackedDouble && !value.is_number())
+        kind = ElementKind::PackedAny;
+    if (value.is_uninitialized())
+        kind = ElementKind::Holey;
+}
+
+void JsArray::clear_element(uint32_t idx)
+{
+    if (idx < dense.size())
+    {
+        dense[idx] = Constants::UNINITIALIZED;
+        kind = ElementKind::Holey;
+    }
+    else
+    {
+        sparse.erase(idx);
+    }
+}
 
 std::string JsArray::to_std_string() const
 {
@@ -229,16 +272,21 @@ jspp::AnyValue JsArray::set_property(uint32_t idx, const AnyValue &value)
     if (idx < dense.size())
     {
         dense[idx] = value;
+        note_element(value);
         return value;
     }
     else if (idx <= dense.size() + DENSE_GROW_THRESHOLD)
     {
+        if (idx > dense.size())
+            kind = ElementKind::Holey;
         dense.resize(idx + 1, Constants::UNINITIALIZED);
         dense[idx] = value;
+        note_element(value);
         return value;
     }
     else
     {
+        kind = ElementKind::Holey;
         sparse[idx] = value;
         return value;
     }
@@ -258,7 +306,7 @@ AnyValue &get_toString_fn()
 
 AnyValue &get_iterator_fn()
 {
-    static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, std::vector<AnyValue> _) -> jspp::JsIterator<jspp::AnyValue>
+    static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, CoroutineArgs) -> jspp::JsIterator<jspp::AnyValue>
                                                   {
                                                       auto arr = thisVal.as_array();
                                                       for (uint64_t idx = 0; idx < arr->length; ++idx)
@@ -294,11 +342,15 @@ AnyValue &get_length_desc()
         }
         uint64_t new_len = static_cast<uint64_t>(new_len_double);
 
-        // Truncate dense part
+        // Truncate dense part; growing past it leaves holes
         if (new_len < self->dense.size())
         {
             self->dense.resize(new_len);
         }
+        else if (new_len > self->dense.size())
+        {
+            self->kind = ElementKind::Holey;
+        }
 
         // Remove sparse elements beyond the new length
         for (auto it = self->sparse.begin(); it != self->sparse.end();)
@@ -375,6 +427,13 @@ AnyValue &get_shift_fn()
                                                      }
                                                      AnyValue first_val = self->get_property(0u);
 
+                                                     if (self->is_packed())
+                                                     {
+                                                         self->dense.erase(self->dense.begin());
+                                                         self->length--;
+                                                         return first_val;
+                                                     }
+
                                                      // Shift all elements to the left
                                                      for (uint64_t i = 0; i < self->length - 1; ++i)
                                                      {
@@ -508,6 +567,19 @@ AnyValue &get_includes_fn()
                                                      else k = len + n;
                                                      if (k < 0) k = 0;
 
+                                                     if (self->is_packed_double())
+                                                     {
+                                                         if (!searchElement.is_number()) return Constants::FALSE;
+                                                         double needle = searchElement.as_double();
+                                                         bool nan = std::isnan(needle);
+                                                         for (uint64_t i = static_cast<uint64_t>(k); i < self->length; ++i)
+                                                         {
+                                                             double element = self->dense[i].as_double();
+                                                             if (element == needle || (nan && std::isnan(element))) return Constants::TRUE;
+                                                         }
+                                                         return Constants::FALSE;
+                                                     }
+
                                                      for (uint64_t i = static_cast<uint64_t>(k); i < self->length; ++i)
                                                      {
                                                          AnyValue element = self->get_property(static_cast<uint32_t>(i));
@@ -534,6 +606,25 @@ AnyValue &get_indexOf_fn()
                                                      else k = len + n;
                                                      if (k < 0) k = 0;
 
+                                                     if (self->is_packed_double())
+                                                     {
+                                                         if (!searchElement.is_number()) return AnyValue::make_number(-1);
+                                                         double needle = searchElement.as_double();
+                                                         for (uint64_t i = static_cast<uint64_t>(k); i < self->length; ++i)
+                                                         {
+                                                             if (self->dense[i].as_double() == needle) return AnyValue::make_number(i);
+                                                         }
+                                                         return AnyValue::make_number(-1);
+                                                     }
+                                                     if (self->is_packed())
+                                                     {
+                                                         for (uint64_t i = static_cast<uint64_t>(k); i < self->length; ++i)
+                                                         {
+                                                             if (is_strictly_equal_to_native(self->dense[i], searchElement)) return AnyValue::make_number(i);
+                                                         }
+                                                         return AnyValue::make_number(-1);
+                                                     }
+
                                                      for (uint64_t i = static_cast<uint64_t>(k); i < self->length; ++i)
                                                      {
                                                          if (self->has_property(std::to_string(i))) {
@@ -561,6 +652,15 @@ AnyValue &get_lastIndexOf_fn()
                                                      
                                                      if (k < 0) return AnyValue::make_number(-1);
 
+                                                     if (self->is_packed())
+                                                     {
+                                                         for (int64_t i = static_cast<int64_t>(k); i >= 0; --i)
+                                                         {
+                                                             if (is_strictly_equal_to_native(self->dense[i], searchElement)) return AnyValue::make_number(i);
+                                                         }
+                                                         return AnyValue::make_number(-1);
+                                                     }
+
                                                      for (int64_t i = static_cast<int64_t>(k); i >= 0; --i)
                                                      {
                                                          if (self->has_property(std::to_string(i))) {
@@ -670,7 +770,7 @@ AnyValue &get_findLastIndex_fn()
 
 AnyValue &get_values_fn()
 {
-    static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, std::vector<AnyValue> _) -> jspp::JsIterator<jspp::AnyValue>
+    static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, CoroutineArgs) -> jspp::JsIterator<jspp::AnyValue>
                                                   {
                                                       auto arr = thisVal.as_array();
                                                       for (uint64_t idx = 0; idx < arr->length; ++idx)
@@ -684,7 +784,7 @@ AnyValue &get_values_fn()
 
 AnyValue &get_keys_fn()
 {
-    static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, std::vector<AnyValue> _) -> jspp::JsIterator<jspp::AnyValue>
+    static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, CoroutineArgs) -> jspp::JsIterator<jspp::AnyValue>
                                                   { 
                                                       auto self = thisVal.as_array();
                                                       for (uint64_t i = 0; i < self->length; ++i) {
@@ -697,7 +797,7 @@ AnyValue &get_keys_fn()
 
 AnyValue &get_entries_fn()
 {
-    static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, std::vector<AnyValue> _) -> jspp::JsIterator<jspp::AnyValue>
+    static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, CoroutineArgs) -> jspp::JsIterator<jspp::AnyValue>
                                                   { 
                                                       auto self = thisVal.as_array();
                                                       for (uint64_t i = 0; i < self->length; ++i) {
@@ -978,6 +1078,13 @@ AnyValue &get_fill_fn()
                                                      double final;
                                                      if (end >= 0) final = end; else final = len + end;
                                                      if (final > len) final = len;
+
+                                                     if (self->is_packed() && k < final)
+                                                     {
+                                                         std::fill(self->dense.begin() + static_cast<ptrdiff_t>(k), self->dense.begin() + static_cast<ptrdiff_t>(final), value);
+                                                         self->note_element(value);
+                                                         return thisVal;
+                                                     }
                                                      
                                                      for (uint64_t i = static_cast<uint64_t>(k); i < static_cast<uint64_t>(final); ++i) {
                                                          self->set_property(static_cast<uint32_t>(i), value);
@@ -992,6 +1099,11 @@ AnyValue &get_reverse_fn()
     static AnyValue fn = AnyValue::make_function([](AnyValue thisVal, std::span<const AnyValue> args) -> AnyValue
                                                  {
                                                      auto self = thisVal.as_array();
+                                                     if (self->is_packed())
+                                                     {
+                                                         std::reverse(self->dense.begin(), self->dense.end());
+                                                         return thisVal;
+                                                     }
                                                      uint64_t len = self->length;
                                                      for (uint64_t i = 0; i < len / 2; ++i) {
                                                          uint64_t j = len - 1 - i;
@@ -1006,13 +1118,11 @@ AnyValue &get_reverse_fn()
                                                          } else if (hasI && !hasJ) {
                                                              AnyValue valI = self->get_property(static_cast<uint32_t>(i));
                                                              self->set_property(static_cast<uint32_t>(j), valI);
-                                                             if (i < self->dense.size()) self->dense[i] = Constants::UNINITIALIZED;
-                                                             else self->sparse.erase(static_cast<uint32_t>(i));
+                                                             self->clear_element(static_cast<uint32_t>(i));
                                                          } else if (!hasI && hasJ) {
                                                              AnyValue valJ = self->get_property(static_cast<uint32_t>(j));
                                                              self->set_property(static_cast<uint32_t>(i), valJ);
-                                                             if (j < self->dense.size()) self->dense[j] = Constants::UNINITIALIZED;
-                                                             else self->sparse.erase(static_cast<uint32_t>(j));
+                                                             self->clear_element(static_cast<uint32_t>(j));
                                                          }
                                                      }
                                                      return thisVal; },
@@ -1054,8 +1164,7 @@ AnyValue &get_sort_fn()
                                                          self->set_property(static_cast<uint32_t>(i), items[i]);
                                                      }
                                                      for (uint64_t i = items.size(); i < self->length; ++i) {
-                                                         if (i < self->dense.size()) self->dense[i] = Constants::UNINITIALIZED;
-                                                         else self->sparse.erase(static_cast<uint32_t>(i));
+                                                         self->clear_element(static_cast<uint32_t>(i));
                                                      }
                                                      
                                                      return thisVal; },
@@ -1103,13 +1212,13 @@ AnyValue &get_splice_fn()
                                                              if (self->has_property(std::to_string(from))) {
                                                                  self->set_property(static_cast<uint32_t>(to), self->get_property(static_cast<uint32_t>(from)));
                                                              } else {
-                                                                 if (to < self->dense.size()) self->dense[to] = Constants::UNINITIALIZED;
-                                                                 else self->sparse.erase(static_cast<uint32_t>(to));
+                                                                 self->clear_element(static_cast<uint32_t>(to));
                                                              }
                                                          }
+                                                         // Drop the vacated tail rather than leaving holes, so packed arrays stay packed
                                                          for (uint64_t i = len; i > len - deleteCount + insertCount; --i) {
                                                               uint64_t idx = i - 1;
-                                                              if (idx < self->dense.size()) self->dense[idx] = Constants::UNINITIALIZED;
+                                                              if (idx < self->dense.size()) self->dense.pop_back();
                                                               else self->sparse.erase(static_cast<uint32_t>(idx));
                                                          }
                                                      } else if (insertCount > deleteCount) {
@@ -1119,8 +1228,7 @@ AnyValue &get_splice_fn()
                                                               if (self->has_property(std::to_string(from))) {
                                                                  self->set_property(static_cast<uint32_t>(to), self->get_property(static_cast<uint32_t>(from)));
                                                              } else {
-                                                                 if (to < self->dense.size()) self->dense[to] = Constants::UNINITIALIZED;
-                                                                 else self->sparse.erase(static_cast<uint32_t>(to));
+                                                                 self->clear_element(static_cast<uint32_t>(to));
                                                              }
                                                          }
                                                      }
@@ -1166,8 +1274,7 @@ AnyValue &get_copyWithin_fn()
                                                              if (self->has_property(std::to_string(f))) {
                                                                  self->set_property(static_cast<uint32_t>(t), self->get_property(static_cast<uint32_t>(f)));
                                                              } else {
-                                                                 if (t < self->dense.size()) self->dense[t] = Constants::UNINITIALIZED;
-                                                                 else self->sparse.erase(static_cast<uint32_t>(t));
+                                                                 self->clear_element(static_cast<uint32_t>(t));
                                                              }
                                                          }
                                                      } else {
@@ -1177,8 +1284,7 @@ AnyValue &get_copyWithin_fn()
                                                              if (self->has_property(std::to_string(f))) {
                                                                  self->set_property(static_cast<uint32_t>(t), self->get_property(static_cast<uint32_t>(f)));
                                                              } else {
-                                                                 if (t < self->dense.size()) self->dense[t] = Constants::UNINITIALIZED;
-                                                                 else self->sparse.erase(static_cast<uint32_t>(t));
+                                                                 self->clear_element(static_cast<uint32_t>(t));
                                                              }
                                                          }
                                                      }
@@ -1193,13 +1299,22 @@ AnyValue &get_concat_fn()
                                                  {
                                                      auto self = thisVal.as_array();
                                                      std::vector<AnyValue> result;
-                                                     for (uint64_t i = 0; i < self->length; ++i) {
-                                                         if (self->has_property(std::to_string(i))) {
-                                                             result.push_back(self->get_property(static_cast<uint32_t>(i)));
-                                                         } else {
-                                                             result.push_back(Constants::UNINITIALIZED);
+                                                     auto append = [&result](JsArray *arr)
+                                                     {
+                                                         if (arr->is_packed())
+                                                         {
+                                                             result.insert(result.end(), arr->dense.begin(), arr->dense.end());
+                                                             return;
                                                          }
-                                                     }
+                                                         for (uint64_t i = 0; i < arr->length; ++i) {
+                                                             if (arr->has_property(std::to_string(i))) {
+                                                                 result.push_back(arr->get_property(static_cast<uint32_t>(i)));
+                                                             } else {
+                                                                 result.push_back(Constants::UNINITIALIZED);
+                                                             }
+                                                         }
+                                                     };
+                                                     append(self);
                                                      
                                                      for (const auto& item : args) {
                                                          bool spreadable = false;
@@ -1216,14 +1331,7 @@ AnyValue &get_concat_fn()
                                                          }
                                                          
                                                          if (spreadable && item.is_array()) {
-                                                             auto arr = item.as_array();
-                                                             for (uint64_t i = 0; i < arr->length; ++i) {
-                                                                 if (arr->has_property(std::to_string(i))) {
-                                                                     result.push_back(arr->get_property(static_cast<uint32_t>(i)));
-                                                                 } else {
-                                                                     result.push_back(Constants::UNINITIALIZED);
-                                                                 }
-                                                             }
+                                                             append(item.as_array());
                                                          } else {
                                                              result.push_back(item);
                                                          }
@@ -1245,6 +1353,12 @@ AnyValue &get_slice_fn()
                                                      double actualEnd = (end < 0) ? std::max(len + end, 0.0) : std::min(end, len);
                                                      
                                                      std::vector<AnyValue> result;
+                                                     if (self->is_packed())
+                                                     {
+                                                         if (actualStart < actualEnd)
+                                                             result.assign(self->dense.begin() + static_cast<ptrdiff_t>(actualStart), self->dense.begin() + static_cast<ptrdiff_t>(actualEnd));
+                                                         return AnyValue::make_array(std::move(result));
+                                                     }
                                                      for (uint64_t i = static_cast<uint64_t>(actualStart); i < static_cast<uint64_t>(actualEnd); ++i) {
                                                          if (self->has_property(std::to_string(i))) {
                                                              result.push_back(self->get_property(static_cast<uint32_t>(i)));
@@ -1338,52 +1452,56 @@ AnyValue &get_toLocaleString_fn()
 
 std::optional<AnyValue> get(const std::string &key)
 {
-    if (key == "toString") return get_toString_fn();
-    if (key == "length") return get_length_desc();
-    if (key == "push") return get_push_fn();
-    if (key == "pop") return get_pop_fn();
-    if (key == "shift") return get_shift_fn();
-    if (key == "unshift") return get_unshift_fn();
-    if (key == "join") return get_join_fn();
-    if (key == "forEach") return get_forEach_fn();
-    if (key == "at") return get_at_fn();
-    if (key == "includes") return get_includes_fn();
-    if (key == "indexOf") return get_indexOf_fn();
-    if (key == "lastIndexOf") return get_lastIndexOf_fn();
-    if (key == "find") return get_find_fn();
-    if (key == "findIndex") return get_findIndex_fn();
-    if (key == "findLast") return get_findLast_fn();
-    if (key == "findLastIndex") return get_findLastIndex_fn();
-    if (key == "values") return get_values_fn();
-    if (key == "keys") return get_keys_fn();
-    if (key == "entries") return get_entries_fn();
-    if (key == "map") return get_map_fn();
-    if (key == "filter") return get_filter_fn();
-    if (key == "every") return get_every_fn();
-    if (key == "some") return get_some_fn();
-    if (key == "reduce") return get_reduce_fn();
-    if (key == "reduceRight") return get_reduceRight_fn();
-    if (key == "flat") return get_flat_fn();
-    if (key == "flatMap") return get_flatMap_fn();
-    if (key == "fill") return get_fill_fn();
-    if (key == "reverse") return get_reverse_fn();
-    if (key == "sort") return get_sort_fn();
-    if (key == "splice") return get_splice_fn();
-    if (key == "copyWithin") return get_copyWithin_fn();
-    if (key == "concat") return get_concat_fn();
-    if (key == "slice") return get_slice_fn();
-    if (key == "toReversed") return get_toReversed_fn();
-    if (key == "toSorted") return get_toSorted_fn();
-    if (key == "toSpliced") return get_toSpliced_fn();
-    if (key == "with") return get_with_fn();
-    if (key == "toLocaleString") return get_toLocaleString_fn();
+    static constexpr PrototypeTable table(std::to_array<PrototypeEntry>({
+        PrototypeEntry{"toString", &get_toString_fn},
+        PrototypeEntry{"length", &get_length_desc},
+        PrototypeEntry{"push", &get_push_fn},
+        PrototypeEntry{"pop", &get_pop_fn},
+        PrototypeEntry{"shift", &get_shift_fn},
+        PrototypeEntry{"unshift", &get_unshift_fn},
+        PrototypeEntry{"join", &get_join_fn},
+        PrototypeEntry{"forEach", &get_forEach_fn},
+        PrototypeEntry{"at", &get_at_fn},
+        PrototypeEntry{"includes", &get_includes_fn},
+        PrototypeEntry{"indexOf", &get_indexOf_fn},
+        PrototypeEntry{"lastIndexOf", &get_lastIndexOf_fn},
+        PrototypeEntry{"find", &get_find_fn},
+        PrototypeEntry{"findIndex", &get_findIndex_fn},
+        PrototypeEntry{"findLast", &get_findLast_fn},
+        PrototypeEntry{"findLastIndex", &get_findLastIndex_fn},
+        PrototypeEntry{"values", &get_values_fn},
+        PrototypeEntry{"keys", &get_keys_fn},
+        PrototypeEntry{"entries", &get_entries_fn},
+        PrototypeEntry{"map", &get_map_fn},
+        PrototypeEntry{"filter", &get_filter_fn},
+        PrototypeEntry{"every", &get_every_fn},
+        PrototypeEntry{"some", &get_some_fn},
+        PrototypeEntry{"reduce", &get_reduce_fn},
+        PrototypeEntry{"reduceRight", &get_reduceRight_fn},
+        PrototypeEntry{"flat", &get_flat_fn},
+        PrototypeEntry{"flatMap", &get_flatMap_fn},
+        PrototypeEntry{"fill", &get_fill_fn},
+        PrototypeEntry{"reverse", &get_reverse_fn},
+        PrototypeEntry{"sort", &get_sort_fn},
+        PrototypeEntry{"splice", &get_splice_fn},
+        PrototypeEntry{"copyWithin", &get_copyWithin_fn},
+        PrototypeEntry{"concat", &get_concat_fn},
+        PrototypeEntry{"slice", &get_slice_fn},
+        PrototypeEntry{"toReversed", &get_toReversed_fn},
+        PrototypeEntry{"toSorted", &get_toSorted_fn},
+        PrototypeEntry{"toSpliced", &get_toSpliced_fn},
+        PrototypeEntry{"with", &get_with_fn},
+        PrototypeEntry{"toLocaleString", &get_toLocaleString_fn},
+    }));
+    if (auto fn = table.find(key))
+        return *fn;
     return std::nullopt;
 }
 
 std::optional<AnyValue> get(const AnyValue &key)
 {
     if (key.is_string())
-        return get(key.as_string()->value);
+        return get(key.as_string()->value());
 
     auto toStringTagSym = AnyValue::from_symbol(WellKnownSymbols::toStringTag);
     if (key == toStringTagSym) return get_toString_fn();
@@ -8,9 +8,19 @@ namespace jspp
     // Forward declaration of AnyValue
     class AnyValue;
 
+    // V8-style element kinds, ordered from most to least specific. An array only ever
+    // moves down this list; kernels use the kind to skip per-element hole and tag checks.
+    enum class ElementKind : uint8_t
+    {
+        PackedDouble, // every index below `length` lives in `dense` and holds a number
+        PackedAny,    // every index below `length` lives in `dense`, any value, no holes
+        Holey,        // may contain holes or sparse elements
+    };
+
     struct JsArray : HeapObject
     {
         std::vector<AnyValue> dense;                     // dense storage for small/contiguous indices
+        ElementKind kind = ElementKind::PackedDouble;
         std::unordered_map<uint32_t, AnyValue> sparse;   // sparse indices (very large indices)
         std::unordered_map<std::string, AnyValue> props; // non-index string properties
         std::map<AnyValue, AnyValue> symbol_props;
@@ -21,10 +31,18 @@ namespace jspp
         explicit JsArray(const std::vector<AnyValue> &items);
         explicit JsArray(std::vector<AnyValue> &&items);
 
-        JsType get_heap_type() const override { return JsType::Array; }
+        void trace(HeapTracer visit) override;
 
         std::string to_std_string() const;
 
+        bool is_packed() const noexcept { return kind != ElementKind::Holey; }
+        bool is_packed_double() const noexcept { return kind == ElementKind::PackedDouble; }
+
+        // Generalizes `kind` so it also covers `value` stored at a dense index
+        void note_element(const AnyValue &value) noexcept;
+        // Punches a hole at `idx`
+        void clear_element(uint32_t idx);
+
         bool has_property(const std::string &key) const;
         bool has_symbol_property(const AnyValue &key) const;
         AnyValue get_property(const std::string &key, const AnyValue &thisVal);
@@ -1,15 +1,17 @@
 #include "jspp.hpp"
 #include "values/async_iterator.hpp"
 #include "values/prototypes/async_iterator.hpp"
+#include "utils/prototype_table.hpp"
 
 namespace jspp {
 
 template <typename T>
-JsAsyncIterator<T>::JsAsyncIterator(handle_type h) : handle(h) {}
+JsAsyncIterator<T>::JsAsyncIterator(handle_type h) : HeapObject(JsType::AsyncIterator), handle(h) {}
 
 template <typename T>
 JsAsyncIterator<T>::JsAsyncIterator(JsAsyncIterator &&other) noexcept 
-    : handle(std::exchange(other.handle, nullptr)),
+    : HeapObject(JsType::AsyncIterator),
+      handle(std::exchange(other.handle, nullptr)),
       props(std::move(other.props)),
       symbol_props(std::move(other.symbol_props)) {}
 
@@ -134,9 +136,9 @@ JsPromise JsAsyncIterator<T>::next(const T &val)
 {
     JsPromise p;
     if (handle) {
-        if (handle.done()) p.resolve(AnyValue::make_object({{"value", Constants::UNDEFINED}, {"done", Constants::TRUE}}));
+        if (handle.done()) p.resolve(AnyValue::make_iterator_result(Constants::UNDEFINED, true));
         else { handle.promise().pending_calls.push({p, val}); resume_next(); }
-    } else p.resolve(AnyValue::make_object({{"value", Constants::UNDEFINED}, {"done", Constants::TRUE}}));
+    } else p.resolve(AnyValue::make_iterator_result(Constants::UNDEFINED, true));
     return p;
 }
 
@@ -229,15 +231,19 @@ AnyValue &get_next_fn()
 
 std::optional<AnyValue> get(const std::string &key)
 {
-    if (key == "toString") return get_toString_fn();
-    if (key == "next") return get_next_fn();
+    static constexpr PrototypeTable table(std::to_array<PrototypeEntry>({
+        PrototypeEntry{"toString", &get_toString_fn},
+        PrototypeEntry{"next", &get_next_fn},
+    }));
+    if (auto fn = table.find(key))
+        return *fn;
     return std::nullopt;
 }
 
 std::optional<AnyValue> get(const AnyValue &key)
 {
     if (key.is_string())
-        return get(key.as_string()->value);
+        return get(key.as_string()->value());
 
     if (key == AnyValue::from_symbol(WellKnownSymbols::toStringTag)) return get_toString_fn();
     if (key == AnyValue::from_symbol(WellKnownSymbols::asyncIterator)) return get_asyncIterator_fn();
@@ -15,8 +15,6 @@ namespace jspp
     class JsAsyncIterator : public HeapObject
     {
     public:
-        JsType get_heap_type() const override { return JsType::AsyncIterator; }
-
         struct promise_type
         {
             std::queue<std::pair<JsPromise, T>> pending_calls;
@@ -24,6 +22,9 @@ namespace jspp
             bool is_running = false;
             T current_input;
 
+            static void *operator new(std::size_t size) { return FrameAllocator::allocate(size); }
+            static void operator delete(void *ptr, std::size_t size) noexcept { FrameAllocator::deallocate(ptr, size); }
+
             JsAsyncIterator get_return_object();
             std::suspend_always initial_suspend() noexcept;
             std::suspend_always final_suspend() noexcept;
@@ -41,7 +42,7 @@ namespace jspp
                 if (!pending_calls.empty()) {
                     auto call = pending_calls.front();
                     pending_calls.pop();
-                    AnyValue result = AnyValue::make_object({{"value", std::forward<From>(from)}, {"done", Constants::FALSE}});
+                    AnyValue result = AnyValue::make_iterator_result(std::forward<From>(from), false);
                     call.first.resolve(result);
                 }
                 return YieldAwaiter{*this};
@@ -52,13 +53,13 @@ namespace jspp
                 if (!pending_calls.empty()) {
                     auto call = pending_calls.front();
                     pending_calls.pop();
-                    AnyValue result = AnyValue::make_object({{"value", std::forward<From>(from)}, {"done", Constants::TRUE}});
+                    AnyValue result = AnyValue::make_iterator_result(std::forward<From>(from), true);
                     call.first.resolve(result);
                 }
                 while (!pending_calls.empty()) {
                     auto call = pending_calls.front();
                     pending_calls.pop();
-                    AnyValue result = AnyValue::make_object({{"value", Constants::UNDEFINED}, {"done", Constants::TRUE}});
+                    AnyValue result = AnyValue::make_iterator_result(Constants::UNDEFINED, true);
                     call.first.resolve(result);
                 }
             }
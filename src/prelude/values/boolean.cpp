@@ -1,5 +1,6 @@
 #include "jspp.hpp"
 #include "values/prototypes/boolean.hpp"
+#include "utils/prototype_table.hpp"
 
 namespace jspp
 {
@@ -43,10 +44,12 @@ namespace jspp
 
         std::optional<AnyValue> get(const std::string &key)
         {
-            if (key == "toString")
-                return get_toString_fn();
-            if (key == "valueOf")
-                return get_valueOf_fn();
+            static constexpr PrototypeTable table(std::to_array<PrototypeEntry>({
+                PrototypeEntry{"toString", &get_toString_fn},
+                PrototypeEntry{"valueOf", &get_valueOf_fn},
+            }));
+            if (auto fn = table.find(key))
+                return *fn;
             return std::nullopt;
         }
 
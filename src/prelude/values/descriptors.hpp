@@ -15,9 +15,9 @@ namespace jspp
         bool configurable = true;
 
         DataDescriptor(AnyValue v, bool w, bool e, bool c) 
-            : value(v), writable(w), enumerable(e), configurable(c) {}
+            : HeapObject(JsType::DataDescriptor), value(v), writable(w), enumerable(e), configurable(c) {}
 
-        JsType get_heap_type() const override { return JsType::DataDescriptor; }
+        void trace(HeapTracer visit) override { visit(value); }
     };
 
     struct AccessorDescriptor : HeapObject
@@ -30,8 +30,6 @@ namespace jspp
         AccessorDescriptor(std::optional<std::function<AnyValue(const AnyValue &, std::span<const AnyValue>)>> g,
                            std::optional<std::function<AnyValue(const AnyValue &, std::span<const AnyValue>)>> s,
                            bool e, bool c)
-            : get(std::move(g)), set(std::move(s)), enumerable(e), configurable(c) {}
-
-        JsType get_heap_type() const override { return JsType::AccessorDescriptor; }
+            : HeapObject(JsType::AccessorDescriptor), get(std::move(g)), set(std::move(s)), enumerable(e), configurable(c) {}
     };
 }
\ No newline at end of file
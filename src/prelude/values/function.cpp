@@ -1,103 +1,159 @@
 #include "jspp.hpp"
 #include "values/function.hpp"
 #include "values/prototypes/function.hpp"
+#include "utils/prototype_table.hpp"
 
 namespace jspp {
 
 // --- JsFunction Implementation ---
 
-JsFunction::JsFunction(const JsFunctionCallable &c,
-                        std::optional<std::string> n,
-                        std::unordered_map<std::string, AnyValue> p,
-                        std::map<AnyValue, AnyValue> sp,
+JsFunction::JsFunction(JsFunctionCallable c,
+                        const char *n,
                         bool is_cls,
                         bool is_ctor)
-    : callable(c),
-        name(std::move(n)),
-        props(std::move(p)),
-        symbol_props(std::move(sp)),
-        proto(Constants::Null),
-        is_generator(callable.index() == 1),
-        is_async(callable.index() == 2),
+    : HeapObject(JsType::Function),
+        callable(std::move(c)),
+        kind(callable.kind()),
+        is_generator(kind == FunctionKind::Generator),
+        is_async(kind == FunctionKind::Async),
         is_class(is_cls),
-        is_constructor(is_ctor && !is_generator && !is_async)
+        is_constructor(is_ctor && !is_generator && !is_async),
+        lazy_prototype(false),
+        name(n),
+        proto(Constants::Null),
+        own_props(Constants::Null)
 {
 }
 
-JsFunction::JsFunction(const JsFunctionCallable &c,
+JsFunction::JsFunction(JsFunctionCallable c,
                         bool is_gen,
-                        std::optional<std::string> n,
-                        std::unordered_map<std::string, AnyValue> p,
-                        std::map<AnyValue, AnyValue> sp,
+                        const char *n,
                         bool is_cls,
                         bool is_ctor)
-    : callable(c),
-        name(std::move(n)),
-        props(std::move(p)),
-        symbol_props(std::move(sp)),
-        proto(Constants::Null),
+    : HeapObject(JsType::Function),
+        callable(std::move(c)),
+        kind(callable.kind()),
         is_generator(is_gen),
-        is_async(callable.index() == 2),
+        is_async(kind == FunctionKind::Async),
         is_class(is_cls),
-        is_constructor(is_ctor && !is_gen && !is_async)
+        is_constructor(is_ctor && !is_gen && !is_async),
+        lazy_prototype(false),
+        name(n),
+        proto(Constants::Null),
+        own_props(Constants::Null)
 {
 }
 
-JsFunction::JsFunction(const JsFunctionCallable &c,
+JsFunction::JsFunction(JsFunctionCallable c,
                         bool is_gen,
                         bool is_async_func,
-                        std::optional<std::string> n,
-                        std::unordered_map<std::string, AnyValue> p,
-                        std::map<AnyValue, AnyValue> sp,
+                        const char *n,
                         bool is_cls,
                         bool is_ctor)
-    : callable(c),
-        name(std::move(n)),
-        props(std::move(p)),
-        symbol_props(std::move(sp)),
-        proto(Constants::Null),
+    : HeapObject(JsType::Function),
+        callable(std::move(c)),
+        kind(callable.kind()),
         is_generator(is_gen),
         is_async(is_async_func),
         is_class(is_cls),
-        is_constructor(is_ctor && !is_gen && !is_async_func)
+        is_constructor(is_ctor && !is_gen && !is_async_func),
+        lazy_prototype(false),
+        name(n),
+        proto(Constants::Null),
+        own_props(Constants::Null)
 {
 }
 
+void JsFunction::trace(HeapTracer visit)
+{
+    visit(own_props);
+    visit(proto);
+    callable.trace(visit);
+}
+
 std::string JsFunction::to_std_string() const
 {
     std::string type_part = this->is_async ? "async function" : this->is_generator ? "function*"
                                                                                     : "function";
-    std::string name_part = this->name.value_or("");
+    std::string name_part = this->name ? this->name : "";
     return type_part + " " + name_part + "() { [native code] }";
 }
 
-AnyValue JsFunction::call(AnyValue thisVal, std::span<const AnyValue> args)
+JsObject *JsFunction::own_properties() const noexcept
 {
-    if (std::function<AnyValue(AnyValue, std::span<const AnyValue>)> *func = std::get_if<0>(&callable))
-    {
-        return (*func)(thisVal, args);
-    }
-    else if (std::function<jspp::JsIterator<jspp::AnyValue>(AnyValue, std::vector<AnyValue>)> *func = std::get_if<1>(&callable))
-    {
-        return AnyValue::from_iterator((*func)(thisVal, std::vector<AnyValue>(args.begin(), args.end())));
-    }
-    else if (std::function<jspp::JsPromise(AnyValue, std::vector<AnyValue>)> *func = std::get_if<2>(&callable))
-    {
-        return AnyValue::from_promise((*func)(thisVal, std::vector<AnyValue>(args.begin(), args.end())));
-    }
-    else if (std::function<jspp::JsAsyncIterator<jspp::AnyValue>(AnyValue, std::vector<AnyValue>)> *func = std::get_if<3>(&callable))
+    return own_props.is_object() ? own_props.as_object() : nullptr;
+}
+
+JsObject &JsFunction::materialize_properties()
+{
+    if (!own_props.is_object())
+        own_props = AnyValue::make_object({});
+    JsObject &props = *own_props.as_object();
+    if (lazy_prototype)
     {
-        return AnyValue::from_async_iterator((*func)(thisVal, std::vector<AnyValue>(args.begin(), args.end())));
+        // Creating it also closes the function <-> prototype cycle, which closures
+        // that never reach this point no longer pay for
+        lazy_prototype = false;
+        AnyValue self = AnyValue::from_ptr(this);
+        auto prototype = AnyValue::make_object({});
+        prototype.define_data_property("constructor", AnyValue::make_data_descriptor(self, true, false, false));
+        props.put_own_property("prototype", AnyValue::make_data_descriptor(prototype, false, false, false));
     }
-    else
+    return props;
+}
+
+AnyValue *JsFunction::find_own_property(const std::string &key)
+{
+    if (lazy_prototype && key == "prototype")
+        return materialize_properties().find_own_property(key);
+    JsObject *props = own_properties();
+    return props ? props->find_own_property(key) : nullptr;
+}
+
+AnyValue *JsFunction::find_own_symbol_property(const AnyValue &key)
+{
+    JsObject *props = own_properties();
+    if (!props)
+        return nullptr;
+    auto it = props->symbol_props.find(key);
+    return it != props->symbol_props.end() ? &it->second : nullptr;
+}
+
+bool JsFunction::has_own_property(const std::string &key) const
+{
+    if (lazy_prototype && key == "prototype")
+        return true;
+    JsObject *props = own_properties();
+    return props && props->has_own_property(key);
+}
+
+void JsFunction::put_own_property(const std::string &key, const AnyValue &value)
+{
+    // A pending `prototype` that is overwritten before it is read is never built
+    if (lazy_prototype && key == "prototype")
+        lazy_prototype = false;
+    materialize_properties().put_own_property(key, value);
+}
+
+void JsFunction::put_own_symbol_property(const AnyValue &key, const AnyValue &value)
+{
+    materialize_properties().symbol_props[key] = value;
+}
+
+bool JsFunction::delete_own_property(const std::string &key)
+{
+    if (lazy_prototype && key == "prototype")
     {
-        return Constants::UNDEFINED;
+        lazy_prototype = false;
+        return true;
     }
+    JsObject *props = own_properties();
+    return props && props->delete_own_property(key);
 }
 
 bool JsFunction::has_property(const std::string &key) const
 {
-    if (props.find(key) != props.end())
+    if (has_own_property(key))
         return true;
     if (!proto.is_null() && !proto.is_undefined())
     {
@@ -111,7 +167,8 @@ bool JsFunction::has_property(const std::string &key) const
 
 bool JsFunction::has_symbol_property(const AnyValue &key) const
 {
-    if (symbol_props.count(key))
+    JsObject *props = own_properties();
+    if (props && props->symbol_props.count(key))
         return true;
     if (!proto.is_null() && !proto.is_undefined())
     {
@@ -125,8 +182,8 @@ bool JsFunction::has_symbol_property(const AnyValue &key) const
 
 AnyValue JsFunction::get_property(const std::string &key, AnyValue thisVal)
 {
-    auto it = props.find(key);
-    if (it == props.end())
+    AnyValue *slot = find_own_property(key);
+    if (!slot)
     {
         if (!proto.is_null() && !proto.is_undefined())
         {
@@ -143,13 +200,13 @@ AnyValue JsFunction::get_property(const std::string &key, AnyValue thisVal)
         }
         return Constants::UNDEFINED;
     }
-    return AnyValue::resolve_property_for_read(it->second, thisVal, key);
+    return AnyValue::resolve_property_for_read(*slot, thisVal, key);
 }
 
 AnyValue JsFunction::get_symbol_property(const AnyValue &key, AnyValue thisVal)
 {
-    auto it = symbol_props.find(key);
-    if (it == symbol_props.end())
+    AnyValue *slot = find_own_symbol_property(key);
+    if (!slot)
     {
         if (!proto.is_null() && !proto.is_undefined())
         {
@@ -165,7 +222,7 @@ AnyValue JsFunction::get_symbol_property(const AnyValue &key, AnyValue thisVal)
         }
         return Constants::UNDEFINED;
     }
-    return AnyValue::resolve_property_for_read(it->second, thisVal, key.to_std_string());
+    return AnyValue::resolve_property_for_read(*slot, thisVal, key.to_std_string());
 }
 
 AnyValue JsFunction::set_property(const std::string &key, AnyValue value, AnyValue thisVal)
@@ -184,28 +241,26 @@ AnyValue JsFunction::set_property(const std::string &key, AnyValue value, AnyVal
         }
     }
 
-    auto it = props.find(key);
-    if (it != props.end())
+    if (AnyValue *slot = find_own_property(key))
     {
-        return AnyValue::resolve_property_for_write(it->second, thisVal, value, key);
+        return AnyValue::resolve_property_for_write(*slot, thisVal, value, key);
     }
     else
     {
-        props[key] = value;
+        materialize_properties().add_own_property(key, value);
         return value;
     }
 }
 
 AnyValue JsFunction::set_symbol_property(const AnyValue &key, AnyValue value, AnyValue thisVal)
 {
-    auto it = symbol_props.find(key);
-    if (it != symbol_props.end())
+    if (AnyValue *slot = find_own_symbol_property(key))
     {
-        return AnyValue::resolve_property_for_write(it->second, thisVal, value, key.to_std_string());
+        return AnyValue::resolve_property_for_write(*slot, thisVal, value, key.to_std_string());
     }
     else
     {
-        symbol_props[key] = value;
+        put_own_symbol_property(key, value);
         return value;
     }
 }
@@ -242,15 +297,19 @@ AnyValue &get_call_fn()
 
 std::optional<AnyValue> get(const std::string &key)
 {
-    if (key == "toString") return get_toString_fn();
-    if (key == "call") return get_call_fn();
+    static constexpr PrototypeTable table(std::to_array<PrototypeEntry>({
+        PrototypeEntry{"toString", &get_toString_fn},
+        PrototypeEntry{"call", &get_call_fn},
+    }));
+    if (auto fn = table.find(key))
+        return *fn;
     return std::nullopt;
 }
 
 std::optional<AnyValue> get(const AnyValue &key)
 {
     if (key.is_string())
-        return get(key.as_string()->value);
+        return get(key.as_string()->value());
 
     if (key == AnyValue::from_symbol(WellKnownSymbols::toStringTag)) return get_toString_fn();
     if (key == "call") return get_call_fn();
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "types.hpp"
-#include <optional>
+#include "utils/function_callable.hpp"
 
 namespace jspp
 {
@@ -11,46 +11,58 @@ namespace jspp
   struct JsFunction : HeapObject
   {
     JsFunctionCallable callable;
-    std::optional<std::string> name;
-    std::unordered_map<std::string, AnyValue> props;
-    std::map<AnyValue, AnyValue> symbol_props;
-    AnyValue proto;
+    FunctionKind kind; // what `callable` returns, copied out of its ops table
     bool is_generator;
     bool is_async;
     bool is_class;
     bool is_constructor;
+    // `prototype` is still to be created; materialize_properties() makes it on first touch
+    bool lazy_prototype;
+    const char *name; // string literal or interned, nullptr for anonymous functions
+    AnyValue proto;
+    // Own properties, kept in a plain JsObject so they share its shape tree, dictionary
+    // mode and symbol map. It is only allocated on first write: most closures are never
+    // decorated and stay a single allocation. Null until then.
+    AnyValue own_props;
 
     // ---- Constructor A: infer flags ----
-    JsFunction(const JsFunctionCallable &c,
-               std::optional<std::string> n = std::nullopt,
-               std::unordered_map<std::string, AnyValue> p = {},
-               std::map<AnyValue, AnyValue> sp = {},
+    JsFunction(JsFunctionCallable c,
+               const char *n = nullptr,
                bool is_cls = false,
                bool is_ctor = true);
 
     // ---- Constructor B: explicit generator flag (backward compat) ----
-    JsFunction(const JsFunctionCallable &c,
+    JsFunction(JsFunctionCallable c,
                bool is_gen,
-               std::optional<std::string> n = std::nullopt,
-               std::unordered_map<std::string, AnyValue> p = {},
-               std::map<AnyValue, AnyValue> sp = {},
+               const char *n = nullptr,
                bool is_cls = false,
                bool is_ctor = true);
 
     // ---- Constructor C: explicit async flag ----
-    JsFunction(const JsFunctionCallable &c,
+    JsFunction(JsFunctionCallable c,
                bool is_gen,
                bool is_async_func,
-               std::optional<std::string> n = std::nullopt,
-               std::unordered_map<std::string, AnyValue> p = {},
-               std::map<AnyValue, AnyValue> sp = {},
+               const char *n = nullptr,
                bool is_cls = false,
                bool is_ctor = true);
 
-    JsType get_heap_type() const override { return JsType::Function; }
-
     std::string to_std_string() const;
-    AnyValue call(AnyValue thisVal, std::span<const AnyValue> args);
+    void trace(HeapTracer visit) override;
+    AnyValue call(AnyValue thisVal, std::span<const AnyValue> args) { return callable(thisVal, args); }
+
+    // --- Own property storage ---
+    // The property object if one has been allocated, without creating it
+    JsObject *own_properties() const noexcept;
+    // The property object, allocated (with any pending `prototype`) if needed
+    JsObject &materialize_properties();
+    // Creates a pending `prototype` when that is the key asked for
+    AnyValue *find_own_property(const std::string &key);
+    AnyValue *find_own_symbol_property(const AnyValue &key);
+    bool has_own_property(const std::string &key) const;
+    // Overwrites the own slot for `key`, adding it if missing
+    void put_own_property(const std::string &key, const AnyValue &value);
+    void put_own_symbol_property(const AnyValue &key, const AnyValue &value);
+    bool delete_own_property(const std::string &key);
 
     bool has_property(const std::string &key) const;
     bool has_symbol_property(const AnyValue &key) const;
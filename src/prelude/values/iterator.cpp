@@ -1,16 +1,18 @@
 #include "jspp.hpp"
 #include "values/iterator.hpp"
 #include "values/prototypes/iterator.hpp"
+#include "utils/prototype_table.hpp"
 
 namespace jspp
 {
 
     template <typename T>
-    JsIterator<T>::JsIterator(handle_type h) : handle(h) {}
+    JsIterator<T>::JsIterator(handle_type h) : HeapObject(JsType::Iterator), handle(h) {}
 
     template <typename T>
     JsIterator<T>::JsIterator(JsIterator &&other) noexcept
-        : handle(std::exchange(other.handle, nullptr)),
+        : HeapObject(JsType::Iterator),
+          handle(std::exchange(other.handle, nullptr)),
           props(std::move(other.props)),
           symbol_props(std::move(other.symbol_props)) {}
 
@@ -62,7 +64,7 @@ namespace jspp
         if (handle.promise().exception_)
             std::rethrow_exception(handle.promise().exception_);
         bool is_done = handle.done();
-        return {handle.promise().current_value, is_done};
+        return {std::move(handle.promise().current_value), is_done};
     }
 
     template <typename T>
@@ -208,7 +210,7 @@ namespace jspp
                                                          {
                                                      AnyValue val = args.empty() ? Constants::UNDEFINED : args[0];
                                                      auto res = thisVal.as_iterator()->next(val);
-                                                     return AnyValue::make_object({{"value", res.value.value_or(Constants::UNDEFINED)}, {"done", AnyValue::make_boolean(res.done)}}); },
+                                                     return AnyValue::make_iterator_result(std::move(res.value).value_or(Constants::UNDEFINED), res.done); },
                                                          "next");
             return fn;
         }
@@ -219,7 +221,7 @@ namespace jspp
                                                          {
                                                      AnyValue val = args.empty() ? Constants::UNDEFINED : args[0];
                                                      auto res = thisVal.as_iterator()->return_(val);
-                                                     return AnyValue::make_object({{"value", res.value.value_or(Constants::UNDEFINED)}, {"done", AnyValue::make_boolean(res.done)}}); },
+                                                     return AnyValue::make_iterator_result(std::move(res.value).value_or(Constants::UNDEFINED), res.done); },
                                                          "return");
             return fn;
         }
@@ -230,7 +232,7 @@ namespace jspp
                                                          {
                                                      AnyValue err = args.empty() ? Constants::UNDEFINED : args[0];
                                                      auto res = thisVal.as_iterator()->throw_(err);
-                                                     return AnyValue::make_object({{"value", res.value.value_or(Constants::UNDEFINED)}, {"done", AnyValue::make_boolean(res.done)}}); },
+                                                     return AnyValue::make_iterator_result(std::move(res.value).value_or(Constants::UNDEFINED), res.done); },
                                                          "throw");
             return fn;
         }
@@ -245,7 +247,7 @@ namespace jspp
 
         AnyValue &get_drop_fn()
         {
-            static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, std::vector<AnyValue> args) -> JsIterator<AnyValue>
+            static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, CoroutineArgs args) -> JsIterator<AnyValue>
                                                           { 
                                                     auto self = thisVal.as_iterator();
                                                     size_t skip_count = 0;
@@ -271,7 +273,7 @@ namespace jspp
 
         AnyValue &get_take_fn()
         {
-            static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, std::vector<AnyValue> args) -> JsIterator<AnyValue>
+            static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, CoroutineArgs args) -> JsIterator<AnyValue>
                                                           { 
                                                     auto self = thisVal.as_iterator();
                                                     size_t take_count = 0;
@@ -324,29 +326,25 @@ namespace jspp
 
         std::optional<AnyValue> get(const std::string &key)
         {
-            if (key == "toString")
-                return get_toString_fn();
-            if (key == "next")
-                return get_next_fn();
-            if (key == "return")
-                return get_return_fn();
-            if (key == "throw")
-                return get_throw_fn();
-            if (key == "toArray")
-                return get_toArray_fn();
-            if (key == "drop")
-                return get_drop_fn();
-            if (key == "take")
-                return get_take_fn();
-            if (key == "some")
-                return get_some_fn();
+            static constexpr PrototypeTable table(std::to_array<PrototypeEntry>({
+                PrototypeEntry{"toString", &get_toString_fn},
+                PrototypeEntry{"next", &get_next_fn},
+                PrototypeEntry{"return", &get_return_fn},
+                PrototypeEntry{"throw", &get_throw_fn},
+                PrototypeEntry{"toArray", &get_toArray_fn},
+                PrototypeEntry{"drop", &get_drop_fn},
+                PrototypeEntry{"take", &get_take_fn},
+                PrototypeEntry{"some", &get_some_fn},
+            }));
+            if (auto fn = table.find(key))
+                return *fn;
             return std::nullopt;
         }
 
         std::optional<AnyValue> get(const AnyValue &key)
         {
             if (key.is_string())
-                return get(key.as_string()->value);
+                return get(key.as_string()->value());
 
             if (key == AnyValue::from_symbol(WellKnownSymbols::toStringTag))
                 return get_toString_fn();
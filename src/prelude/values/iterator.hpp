@@ -21,8 +21,6 @@ namespace jspp
             bool done;
         };
 
-        JsType get_heap_type() const override { return JsType::Iterator; }
-
         struct promise_type
         {
             std::optional<T> current_value;
@@ -32,6 +30,10 @@ namespace jspp
             std::exception_ptr pending_exception = nullptr;
             bool pending_return = false;
 
+            // Frames come from the coroutine frame pools instead of the global heap
+            static void *operator new(std::size_t size) { return FrameAllocator::allocate(size); }
+            static void operator delete(void *ptr, std::size_t size) noexcept { FrameAllocator::deallocate(ptr, size); }
+
             JsIterator get_return_object();
             std::suspend_always initial_suspend() noexcept;
             std::suspend_always final_suspend() noexcept;
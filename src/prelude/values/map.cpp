@@ -0,0 +1,312 @@
+#include "jspp.hpp"
+#include "values/map.hpp"
+#include "values/prototypes/map.hpp"
+#include "utils/prototype_table.hpp"
+
+namespace jspp {
+
+JsIterator<AnyValue> iterate_collection(AnyValue owner, OrderedHashTable &table, CollectionIteration kind)
+{
+    OrderedHashTable::Pin pin(table);
+    for (size_t i = 0; i < table.extent(); ++i)
+    {
+        const auto *entry = table.at(i);
+        if (!entry)
+            continue;
+        switch (kind)
+        {
+        case CollectionIteration::Keys:
+            co_yield entry->key;
+            break;
+        case CollectionIteration::Values:
+            co_yield entry->value;
+            break;
+        case CollectionIteration::Entries:
+        {
+            std::vector<AnyValue> pair;
+            pair.reserve(2);
+            pair.push_back(entry->key);
+            pair.push_back(owner.is_set() ? entry->key : entry->value); // a Set's entries are [value, value]
+            co_yield AnyValue::make_array(std::move(pair));
+            break;
+        }
+        }
+    }
+    co_return Constants::UNDEFINED;
+}
+
+// --- JsMap Implementation ---
+
+JsMap::JsMap() : HeapObject(JsType::Map), proto(Constants::Null) {}
+JsMap::JsMap(AnyValue p) : HeapObject(JsType::Map), proto(std::move(p)) {}
+
+void JsMap::trace(HeapTracer visit)
+{
+    table.trace(visit);
+    for (auto &[key, value] : props)
+        visit(value);
+    for (auto &[key, value] : symbol_props)
+        visit(value);
+    visit(proto);
+}
+
+std::string JsMap::to_std_string() const
+{
+    return "[object Map]";
+}
+
+bool JsMap::has_property(const std::string &key) const
+{
+    if (props.find(key) != props.end())
+        return true;
+    if (!proto.is_null() && !proto.is_undefined())
+    {
+        if (proto.has_property(key))
+            return true;
+    }
+    if (MapPrototypes::get(key).has_value())
+        return true;
+    return false;
+}
+
+bool JsMap::has_symbol_property(const AnyValue &key) const
+{
+    if (symbol_props.count(key))
+        return true;
+    if (!proto.is_null() && !proto.is_undefined())
+    {
+        if (proto.has_property(key))
+            return true;
+    }
+    if (MapPrototypes::get(key).has_value())
+        return true;
+    return false;
+}
+
+AnyValue JsMap::get_property(const std::string &key, const AnyValue &thisVal)
+{
+    auto it = props.find(key);
+    if (it != props.end())
+        return AnyValue::resolve_property_for_read(it->second, thisVal, key);
+
+    if (!proto.is_null() && !proto.is_undefined())
+    {
+        if (proto.has_property(key))
+            return proto.get_property_with_receiver(key, thisVal);
+    }
+
+    auto proto_it = MapPrototypes::get(key);
+    if (proto_it.has_value())
+        return AnyValue::resolve_property_for_read(proto_it.value(), thisVal, key);
+    return Constants::UNDEFINED;
+}
+
+AnyValue JsMap::get_symbol_property(const AnyValue &key, const AnyValue &thisVal)
+{
+    auto it = symbol_props.find(key);
+    if (it != symbol_props.end())
+        return AnyValue::resolve_property_for_read(it->second, thisVal, key.to_std_string());
+
+    if (!proto.is_null() && !proto.is_undefined())
+    {
+        if (proto.has_property(key))
+            return proto.get_symbol_property_with_receiver(key, thisVal);
+    }
+
+    auto proto_it = MapPrototypes::get(key);
+    if (proto_it.has_value())
+        return AnyValue::resolve_property_for_read(proto_it.value(), thisVal, key.to_std_string());
+    return Constants::UNDEFINED;
+}
+
+AnyValue JsMap::set_property(const std::string &key, const AnyValue &value, const AnyValue &thisVal)
+{
+    auto proto_it = MapPrototypes::get(key);
+    if (proto_it.has_value() && proto_it.value().is_accessor_descriptor())
+        return AnyValue::resolve_property_for_write(proto_it.value(), thisVal, value, key);
+
+    auto it = props.find(key);
+    if (it != props.end())
+        return AnyValue::resolve_property_for_write(it->second, thisVal, value, key);
+    props[key] = value;
+    return value;
+}
+
+AnyValue JsMap::set_symbol_property(const AnyValue &key, const AnyValue &value, const AnyValue &thisVal)
+{
+    auto it = symbol_props.find(key);
+    if (it != symbol_props.end())
+        return AnyValue::resolve_property_for_write(it->second, thisVal, value, key.to_std_string());
+    symbol_props[key] = value;
+    return value;
+}
+
+// --- MapPrototypes Implementation ---
+
+namespace MapPrototypes {
+
+static JsMap *this_map(const AnyValue &thisVal, const char *method)
+{
+    if (!thisVal.is_map()) [[unlikely]]
+        throw Exception::make_exception(std::string("Method Map.prototype.") + method + " called on incompatible receiver " + thisVal.to_std_string(), "TypeError");
+    return thisVal.as_map();
+}
+
+static const AnyValue &arg_or_undefined(std::span<const AnyValue> args, size_t i)
+{
+    return i < args.size() ? args[i] : Constants::UNDEFINED;
+}
+
+AnyValue &get_get_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_map(thisVal, "get");
+                                                     auto slot = self->table.find(arg_or_undefined(args, 0));
+                                                     return slot ? *slot : Constants::UNDEFINED; },
+                                                 "get", false);
+    return fn;
+}
+
+AnyValue &get_set_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_map(thisVal, "set");
+                                                     self->table.set(arg_or_undefined(args, 0), arg_or_undefined(args, 1));
+                                                     return thisVal; },
+                                                 "set", false);
+    return fn;
+}
+
+AnyValue &get_has_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_map(thisVal, "has");
+                                                     return AnyValue::make_boolean(self->table.contains(arg_or_undefined(args, 0))); },
+                                                 "has", false);
+    return fn;
+}
+
+AnyValue &get_delete_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_map(thisVal, "delete");
+                                                     return AnyValue::make_boolean(self->table.erase(arg_or_undefined(args, 0))); },
+                                                 "delete", false);
+    return fn;
+}
+
+AnyValue &get_clear_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue>) -> AnyValue
+                                                 {
+                                                     this_map(thisVal, "clear")->table.clear();
+                                                     return Constants::UNDEFINED; },
+                                                 "clear", false);
+    return fn;
+}
+
+AnyValue &get_forEach_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_map(thisVal, "forEach");
+                                                     if (args.empty() || !args[0].is_function())
+                                                     {
+                                                         throw Exception::make_exception(arg_or_undefined(args, 0).to_std_string() + " is not a function", "TypeError");
+                                                     }
+                                                     auto callback = args[0].as_function();
+                                                     const AnyValue &thisArg = arg_or_undefined(args, 1);
+                                                     self->table.for_each([&](const AnyValue &key, const AnyValue &value)
+                                                                          {
+                                                                              const AnyValue cbArgs[] = {value, key, thisVal};
+                                                                              callback->call(thisArg, cbArgs); });
+                                                     return Constants::UNDEFINED; },
+                                                 "forEach", false);
+    return fn;
+}
+
+AnyValue &get_keys_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue>) -> AnyValue
+                                                 {
+                                                     auto self = this_map(thisVal, "keys");
+                                                     return AnyValue::from_iterator(iterate_collection(thisVal, self->table, CollectionIteration::Keys)); },
+                                                 "keys", false);
+    return fn;
+}
+
+AnyValue &get_values_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue>) -> AnyValue
+                                                 {
+                                                     auto self = this_map(thisVal, "values");
+                                                     return AnyValue::from_iterator(iterate_collection(thisVal, self->table, CollectionIteration::Values)); },
+                                                 "values", false);
+    return fn;
+}
+
+AnyValue &get_entries_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue>) -> AnyValue
+                                                 {
+                                                     auto self = this_map(thisVal, "entries");
+                                                     return AnyValue::from_iterator(iterate_collection(thisVal, self->table, CollectionIteration::Entries)); },
+                                                 "entries", false);
+    return fn;
+}
+
+AnyValue &get_size_desc()
+{
+    static auto getter = [](const AnyValue &thisVal, std::span<const AnyValue>) -> AnyValue
+    {
+        return AnyValue::make_number(static_cast<double>(this_map(thisVal, "size")->table.size()));
+    };
+    static AnyValue desc = AnyValue::make_accessor_descriptor(getter, std::nullopt, false, true);
+    return desc;
+}
+
+AnyValue &get_toString_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &, std::span<const AnyValue>) -> AnyValue
+                                                 { return AnyValue::make_string("[object Map]"); },
+                                                 "toString", false);
+    return fn;
+}
+
+std::optional<AnyValue> get(const std::string &key)
+{
+    static constexpr PrototypeTable table(std::to_array<PrototypeEntry>({
+        PrototypeEntry{"get", &get_get_fn},
+        PrototypeEntry{"set", &get_set_fn},
+        PrototypeEntry{"has", &get_has_fn},
+        PrototypeEntry{"delete", &get_delete_fn},
+        PrototypeEntry{"clear", &get_clear_fn},
+        PrototypeEntry{"forEach", &get_forEach_fn},
+        PrototypeEntry{"keys", &get_keys_fn},
+        PrototypeEntry{"values", &get_values_fn},
+        PrototypeEntry{"entries", &get_entries_fn},
+        PrototypeEntry{"size", &get_size_desc},
+        PrototypeEntry{"toString", &get_toString_fn},
+    }));
+    if (auto fn = table.find(key))
+        return *fn;
+    return std::nullopt;
+}
+
+std::optional<AnyValue> get(const AnyValue &key)
+{
+    if (key.is_string())
+        return get(key.as_string()->value());
+
+    if (key == AnyValue::from_symbol(WellKnownSymbols::iterator)) return get_entries_fn();
+
+    return std::nullopt;
+}
+
+} // namespace MapPrototypes
+
+} // namespace jspp
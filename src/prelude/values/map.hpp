@@ -0,0 +1,45 @@
+#pragma once
+
+#include "types.hpp"
+#include "values/ordered_hash_table.hpp"
+#include <optional>
+
+namespace jspp
+{
+    // Forward declaration of AnyValue
+    class AnyValue;
+
+    // What a Map or Set iterator yields for each entry
+    enum class CollectionIteration : uint8_t
+    {
+        Keys,
+        Values,
+        Entries, // [key, value] pairs
+    };
+
+    // Walks `table` by entry index, so one coroutine frame serves the whole iteration and
+    // entries added or deleted while it is suspended are seen the way the spec requires.
+    // `owner` is the Map or Set holding `table` and is kept alive by the iterator.
+    JsIterator<AnyValue> iterate_collection(AnyValue owner, OrderedHashTable &table, CollectionIteration kind);
+
+    struct JsMap : HeapObject
+    {
+        OrderedHashTable table;
+        std::unordered_map<std::string, AnyValue> props;
+        std::map<AnyValue, AnyValue> symbol_props;
+        AnyValue proto;
+
+        JsMap();
+        explicit JsMap(AnyValue proto);
+
+        void trace(HeapTracer visit) override;
+
+        std::string to_std_string() const;
+        bool has_property(const std::string &key) const;
+        bool has_symbol_property(const AnyValue &key) const;
+        AnyValue get_property(const std::string &key, const AnyValue &thisVal);
+        AnyValue get_symbol_property(const AnyValue &key, const AnyValue &thisVal);
+        AnyValue set_property(const std::string &key, const AnyValue &value, const AnyValue &thisVal);
+        AnyValue set_symbol_property(const AnyValue &key, const AnyValue &value, const AnyValue &thisVal);
+    };
+}
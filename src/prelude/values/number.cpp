@@ -1,5 +1,6 @@
 #include "jspp.hpp"
 #include "values/prototypes/number.hpp"
+#include "utils/prototype_table.hpp"
 
 namespace jspp
 {
@@ -192,18 +193,16 @@ namespace jspp
 
         std::optional<AnyValue> get(const std::string &key)
         {
-            if (key == "toExponential")
-                return get_toExponential_fn();
-            if (key == "toFixed")
-                return get_toFixed_fn();
-            if (key == "toPrecision")
-                return get_toPrecision_fn();
-            if (key == "toString")
-                return get_toString_fn();
-            if (key == "valueOf")
-                return get_valueOf_fn();
-            if (key == "toLocaleString")
-                return get_toLocaleString_fn();
+            static constexpr PrototypeTable table(std::to_array<PrototypeEntry>({
+                PrototypeEntry{"toExponential", &get_toExponential_fn},
+                PrototypeEntry{"toFixed", &get_toFixed_fn},
+                PrototypeEntry{"toPrecision", &get_toPrecision_fn},
+                PrototypeEntry{"toString", &get_toString_fn},
+                PrototypeEntry{"valueOf", &get_valueOf_fn},
+                PrototypeEntry{"toLocaleString", &get_toLocaleString_fn},
+            }));
+            if (auto fn = table.find(key))
+                return *fn;
             return std::nullopt;
         }
 
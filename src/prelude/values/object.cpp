@@ -1,34 +1,164 @@
 #include "jspp.hpp"
 #include "values/object.hpp"
 #include "values/prototypes/object.hpp"
+#include "utils/prototype_table.hpp"
 
 namespace jspp
 {
 
     // --- JsObject Implementation ---
 
-    JsObject::JsObject() : shape(Shape::empty_shape()), proto(Constants::Null) {}
+    JsObject::JsObject() : HeapObject(JsType::Object), shape(Shape::empty_shape()), proto(Constants::Null) {}
 
-    JsObject::JsObject(std::initializer_list<std::pair<std::string, AnyValue>> p, AnyValue pr) : proto(pr)
+    JsObject::JsObject(std::initializer_list<std::pair<std::string, AnyValue>> p, AnyValue pr) : HeapObject(JsType::Object), proto(pr)
     {
         shape = Shape::empty_shape();
         storage.reserve(p.size());
         for (const auto &pair : p)
-        {
-            shape = shape->transition(pair.first);
-            storage.push_back(pair.second);
-        }
+            add_own_property(PropertyKey(pair.first), pair.second);
     }
 
-    JsObject::JsObject(const std::map<std::string, AnyValue> &p, AnyValue pr) : proto(pr)
+    JsObject::JsObject(const std::map<std::string, AnyValue> &p, AnyValue pr) : HeapObject(JsType::Object), proto(pr)
     {
         shape = Shape::empty_shape();
         storage.reserve(p.size());
         for (const auto &pair : p)
+            add_own_property(PropertyKey(pair.first), pair.second);
+    }
+
+    void JsObject::trace(HeapTracer visit)
+    {
+        for (auto &value : storage)
+            visit(value);
+        if (dictionary)
+            dictionary->for_each([visit](const std::string &, AnyValue &value)
+                                 { visit(value); });
+        for (auto &[key, value] : symbol_props)
+            visit(value);
+        visit(proto);
+    }
+
+    AnyValue *JsObject::find_own_property(const std::string &key)
+    {
+        if (dictionary)
+            return dictionary->find(key);
+        auto offset = shape->get_offset(key);
+        return offset.has_value() ? &storage[offset.value()] : nullptr;
+    }
+
+    AnyValue *JsObject::find_own_property(PropertyKey key)
+    {
+        if (dictionary)
+            return dictionary->find(key);
+        auto offset = shape->get_offset(key);
+        return offset.has_value() ? &storage[offset.value()] : nullptr;
+    }
+
+    const AnyValue *JsObject::find_own_property(const std::string &key) const
+    {
+        if (dictionary)
+            return dictionary->find(key);
+        auto offset = shape->get_offset(key);
+        return offset.has_value() ? &storage[offset.value()] : nullptr;
+    }
+
+    const AnyValue *JsObject::find_own_property(PropertyKey key) const
+    {
+        if (dictionary)
+            return dictionary->find(key);
+        auto offset = shape->get_offset(key);
+        return offset.has_value() ? &storage[offset.value()] : nullptr;
+    }
+
+    void JsObject::add_own_property(const std::string &key, const AnyValue &value)
+    {
+        if (!dictionary)
+        {
+            uint32_t count = shape->property_count();
+            const Atom *atom = PropertyKey::find(key);
+            if (count >= DICTIONARY_MODE_THRESHOLD || (!atom && count >= COMPUTED_KEY_THRESHOLD))
+            {
+                enter_dictionary_mode();
+            }
+            else
+            {
+                shape = shape->transition(atom ? PropertyKey(atom) : PropertyKey(key));
+                storage.push_back(value);
+                return;
+            }
+        }
+        dictionary->insert(key, value);
+    }
+
+    void JsObject::add_own_property(PropertyKey key, const AnyValue &value)
+    {
+        if (!dictionary && shape->property_count() >= DICTIONARY_MODE_THRESHOLD)
+            enter_dictionary_mode();
+
+        if (dictionary)
         {
-            shape = shape->transition(pair.first);
-            storage.push_back(pair.second);
+            dictionary->insert(key, value);
+            return;
         }
+        shape = shape->transition(key);
+        storage.push_back(value);
+    }
+
+    void JsObject::put_own_property(const std::string &key, const AnyValue &value)
+    {
+        if (auto slot = find_own_property(key))
+            *slot = value;
+        else
+            add_own_property(key, value);
+    }
+
+    void JsObject::put_own_property(PropertyKey key, const AnyValue &value)
+    {
+        if (auto slot = find_own_property(key))
+            *slot = value;
+        else
+            add_own_property(key, value);
+    }
+
+    bool JsObject::delete_own_property(const std::string &key)
+    {
+        if (!dictionary)
+        {
+            if (!shape->get_offset(key).has_value())
+                return false;
+            enter_dictionary_mode();
+        }
+        return dictionary->erase(key);
+    }
+
+    bool JsObject::delete_own_property(PropertyKey key)
+    {
+        if (!dictionary)
+        {
+            if (!shape->get_offset(key).has_value())
+                return false;
+            enter_dictionary_mode();
+        }
+        return dictionary->erase(key);
+    }
+
+    size_t JsObject::own_property_count() const
+    {
+        return dictionary ? dictionary->size() : shape->property_count();
+    }
+
+    void JsObject::enter_dictionary_mode()
+    {
+        if (dictionary)
+            return;
+        auto dict = std::make_unique<PropertyDictionary>();
+        dict->reserve(storage.size() * 2);
+        for (uint32_t offset = 0; offset < shape->property_count(); ++offset)
+            dict->insert(shape->key_at(offset), storage[offset]);
+        dictionary = std::move(dict);
+        shape = nullptr;
+        storage.clear();
+        storage.shrink_to_fit();
     }
 
     std::string JsObject::to_std_string() const
@@ -36,19 +166,21 @@ namespace jspp
         return "[Object Object]";
     }
 
-    bool JsObject::has_property(const std::string &key) const
-    {
-        if (deleted_keys.count(key))
-            return false;
+    bool JsObject::has_property(const std::string &key) const { return has_property_impl(key); }
+    bool JsObject::has_property(PropertyKey key) const { return has_property_impl(key); }
 
-        if (shape->get_offset(key).has_value())
+    template <typename Key>
+    bool JsObject::has_property_impl(const Key &key) const
+    {
+        const std::string &name = key;
+        if (has_own_property(key))
             return true;
         if (!proto.is_null() && !proto.is_undefined())
         {
-            if (proto.has_property(key))
+            if (proto.has_property(name))
                 return true;
         }
-        if (ObjectPrototypes::get(key).has_value())
+        if (ObjectPrototypes::get(name).has_value())
             return true;
         return false;
     }
@@ -67,30 +199,34 @@ namespace jspp
         return false;
     }
 
-    AnyValue JsObject::get_property(const std::string &key, const AnyValue &thisVal)
-    {
-        if (deleted_keys.count(key))
-            return Constants::UNDEFINED;
+    AnyValue JsObject::get_property(const std::string &key, const AnyValue &thisVal) { return get_property_impl(key, thisVal); }
+    AnyValue JsObject::get_property(PropertyKey key, const AnyValue &thisVal) { return get_property_impl(key, thisVal); }
 
-        auto offset = shape->get_offset(key);
-        if (!offset.has_value())
+    // Own lookups use the overload for `Key`; the prototype chain and built-in
+    // prototype tables are keyed by name.
+    template <typename Key>
+    AnyValue JsObject::get_property_impl(const Key &key, const AnyValue &thisVal)
+    {
+        const std::string &name = key;
+        auto slot = find_own_property(key);
+        if (!slot)
         {
             if (!proto.is_null() && !proto.is_undefined())
             {
-                if (proto.has_property(key))
+                if (proto.has_property(name))
                 {
-                    return proto.get_property_with_receiver(key, thisVal);
+                    return proto.get_property_with_receiver(name, thisVal);
                 }
             }
 
-            auto proto_it = ObjectPrototypes::get(key);
+            auto proto_it = ObjectPrototypes::get(name);
             if (proto_it.has_value())
             {
-                return AnyValue::resolve_property_for_read(proto_it.value(), thisVal, key);
+                return AnyValue::resolve_property_for_read(proto_it.value(), thisVal, name);
             }
             return Constants::UNDEFINED;
         }
-        return AnyValue::resolve_property_for_read(storage[offset.value()], thisVal, key);
+        return AnyValue::resolve_property_for_read(*slot, thisVal, name);
     }
 
     AnyValue JsObject::get_symbol_property(const AnyValue &key, const AnyValue &thisVal)
@@ -115,34 +251,35 @@ namespace jspp
         return AnyValue::resolve_property_for_read(it->second, thisVal, key.to_std_string());
     }
 
-    AnyValue JsObject::set_property(const std::string &key, const AnyValue &value, const AnyValue &thisVal)
+    AnyValue JsObject::set_property(const std::string &key, const AnyValue &value, const AnyValue &thisVal) { return set_property_impl(key, value, thisVal); }
+    AnyValue JsObject::set_property(PropertyKey key, const AnyValue &value, const AnyValue &thisVal) { return set_property_impl(key, value, thisVal); }
+
+    template <typename Key>
+    AnyValue JsObject::set_property_impl(const Key &key, const AnyValue &value, const AnyValue &thisVal)
     {
-        auto proto_it = ObjectPrototypes::get(key);
+        const std::string &name = key;
+        auto proto_it = ObjectPrototypes::get(name);
         if (proto_it.has_value())
         {
             auto proto_value = proto_it.value();
             if (proto_value.is_accessor_descriptor())
             {
-                return AnyValue::resolve_property_for_write(proto_value, thisVal, value, key);
+                return AnyValue::resolve_property_for_write(proto_value, thisVal, value, name);
             }
             if (proto_value.is_data_descriptor() && !proto_value.as_data_descriptor()->writable)
             {
-                return AnyValue::resolve_property_for_write(proto_value, thisVal, value, key);
+                return AnyValue::resolve_property_for_write(proto_value, thisVal, value, name);
             }
         }
 
-        if (deleted_keys.count(key))
-            deleted_keys.erase(key);
-
-        auto offset = shape->get_offset(key);
-        if (offset.has_value())
+        auto slot = find_own_property(key);
+        if (slot)
         {
-            return AnyValue::resolve_property_for_write(storage[offset.value()], thisVal, value, key);
+            return AnyValue::resolve_property_for_write(*slot, thisVal, value, name);
         }
         else
         {
-            shape = shape->transition(key);
-            storage.push_back(value);
+            add_own_property(key, value);
             return value;
         }
     }
@@ -176,17 +313,18 @@ namespace jspp
 
         std::optional<AnyValue> get(const std::string &key)
         {
-            if (key == "toString")
-            {
-                return get_toString_fn();
-            }
+            static constexpr PrototypeTable table(std::to_array<PrototypeEntry>({
+                PrototypeEntry{"toString", &get_toString_fn},
+            }));
+            if (auto fn = table.find(key))
+                return *fn;
             return std::nullopt;
         }
 
         std::optional<AnyValue> get(const AnyValue &key)
         {
             if (key.is_string())
-                return get(key.as_string()->value);
+                return get(key.as_string()->value());
 
             if (key == AnyValue::from_symbol(WellKnownSymbols::toStringTag))
             {
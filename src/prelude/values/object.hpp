@@ -2,8 +2,9 @@
 
 #include "types.hpp"
 #include "shape.hpp"
+#include "property_dictionary.hpp"
 #include <vector>
-#include <unordered_set>
+#include <memory>
 
 namespace jspp
 {
@@ -12,24 +13,79 @@ namespace jspp
 
     struct JsObject : HeapObject
     {
-        std::shared_ptr<Shape> shape;
+        // Objects with more own keys than this, or that have had a key deleted,
+        // switch to dictionary mode instead of growing the shape tree.
+        static constexpr uint32_t DICTIONARY_MODE_THRESHOLD = 64;
+        // A key added by name that was never interned is a computed key. Past this many
+        // properties the object switches to dictionary mode rather than interning it,
+        // so objects used as maps don't grow the atom table and shape tree forever.
+        static constexpr uint32_t COMPUTED_KEY_THRESHOLD = 16;
+
+        // Fast mode: `shape` maps keys to offsets in `storage`.
+        // Dictionary mode: `dictionary` holds all string-keyed properties and `shape` is null.
+        Shape *shape;
         std::vector<AnyValue> storage;
+        std::unique_ptr<PropertyDictionary> dictionary;
         AnyValue proto;
-        std::unordered_set<std::string> deleted_keys;
         std::map<AnyValue, AnyValue> symbol_props;
 
         JsObject();
         JsObject(std::initializer_list<std::pair<std::string, AnyValue>> p, AnyValue pr);
         JsObject(const std::map<std::string, AnyValue> &p, AnyValue pr);
 
-        JsType get_heap_type() const override { return JsType::Object; }
+        void trace(HeapTracer visit) override;
+
+        bool is_dictionary_mode() const noexcept { return dictionary != nullptr; }
+
+        // --- Own string-keyed property storage ---
+        // The PropertyKey overloads look keys up in the shape by atom without hashing the name.
+        AnyValue *find_own_property(const std::string &key);
+        AnyValue *find_own_property(PropertyKey key);
+        const AnyValue *find_own_property(const std::string &key) const;
+        const AnyValue *find_own_property(PropertyKey key) const;
+        bool has_own_property(const std::string &key) const { return find_own_property(key) != nullptr; }
+        bool has_own_property(PropertyKey key) const { return find_own_property(key) != nullptr; }
+        // Adds a property that is known not to exist yet
+        void add_own_property(const std::string &key, const AnyValue &value);
+        void add_own_property(PropertyKey key, const AnyValue &value);
+        // Overwrites the own slot for `key`, adding it if missing
+        void put_own_property(const std::string &key, const AnyValue &value);
+        void put_own_property(PropertyKey key, const AnyValue &value);
+        bool delete_own_property(const std::string &key);
+        bool delete_own_property(PropertyKey key);
+        size_t own_property_count() const;
+        void enter_dictionary_mode();
+
+        // Visits own string-keyed properties in insertion order
+        template <typename Fn>
+        void for_each_own_property(Fn &&fn) const
+        {
+            if (dictionary)
+            {
+                dictionary->for_each(fn);
+                return;
+            }
+            for (uint32_t offset = 0; offset < shape->property_count(); ++offset)
+                fn(shape->key_at(offset), storage[offset]);
+        }
 
         std::string to_std_string() const;
         bool has_property(const std::string &key) const;
+        bool has_property(PropertyKey key) const;
         bool has_symbol_property(const AnyValue &key) const;
         AnyValue get_property(const std::string &key, const AnyValue &thisVal);
+        AnyValue get_property(PropertyKey key, const AnyValue &thisVal);
         AnyValue get_symbol_property(const AnyValue &key, const AnyValue &thisVal);
         AnyValue set_property(const std::string &key, const AnyValue &value, const AnyValue &thisVal);
+        AnyValue set_property(PropertyKey key, const AnyValue &value, const AnyValue &thisVal);
         AnyValue set_symbol_property(const AnyValue &key, const AnyValue &value, const AnyValue &thisVal);
+
+    private:
+        template <typename Key>
+        bool has_property_impl(const Key &key) const;
+        template <typename Key>
+        AnyValue get_property_impl(const Key &key, const AnyValue &thisVal);
+        template <typename Key>
+        AnyValue set_property_impl(const Key &key, const AnyValue &value, const AnyValue &thisVal);
     };
 }
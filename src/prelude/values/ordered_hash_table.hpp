@@ -0,0 +1,279 @@
+#pragma once
+
+#include "types.hpp"
+#include "values/string.hpp"
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace jspp
+{
+    // Insertion-ordered open-addressing hash table keyed by SameValueZero, backing Map and Set.
+    //
+    // Same layout as PropertyDictionary: entries are appended in insertion order and `slots`
+    // is a linear-probing index into them. Keys hash straight from the AnyValue, so nothing
+    // is ever converted to a property-name string: numbers hash their double bits (-0 is
+    // stored as +0, and every NaN as the positive quiet NaN, since a runtime 0/0 and the
+    // NaN literal differ in their sign bit), strings use the hash cached on the JsString,
+    // and every other value hashes by identity.
+    //
+    // A deleted entry stays behind as a tombstone so that entry indices, which iterators
+    // use as cursors, stay valid. Tombstones are only compacted away while no cursor is
+    // open; otherwise the table grows instead.
+    class OrderedHashTable
+    {
+    public:
+        struct Entry
+        {
+            AnyValue key;
+            AnyValue value;
+            size_t hash;
+            bool deleted = false;
+        };
+
+        // Keeps entry indices stable for as long as it lives
+        class Pin
+        {
+        public:
+            explicit Pin(OrderedHashTable &t) noexcept : table(t) { ++table.pins; }
+            ~Pin() { --table.pins; }
+            Pin(const Pin &) = delete;
+            Pin &operator=(const Pin &) = delete;
+
+        private:
+            OrderedHashTable &table;
+        };
+
+        size_t size() const noexcept { return live; }
+
+        // Number of entry positions including tombstones; cursors run from 0 up to this
+        size_t extent() const noexcept { return entries.size(); }
+
+        // The live entry at `index`, or nullptr for a tombstone
+        const Entry *at(size_t index) const noexcept
+        {
+            const Entry &entry = entries[index];
+            return entry.deleted ? nullptr : &entry;
+        }
+
+        AnyValue *find(const AnyValue &key)
+        {
+            size_t slot = find_slot(key, hash_key(key));
+            return slot == NOT_FOUND ? nullptr : &entries[slots[slot]].value;
+        }
+
+        bool contains(const AnyValue &key) const
+        {
+            return find_slot(key, hash_key(key)) != NOT_FOUND;
+        }
+
+        // Inserts `key` or overwrites its value in place, keeping its original position
+        void set(const AnyValue &key, const AnyValue &value)
+        {
+            size_t hash = hash_key(key);
+            size_t slot = find_slot(key, hash);
+            if (slot != NOT_FOUND)
+            {
+                entries[slots[slot]].value = value;
+                return;
+            }
+
+            if (needs_growth(entries.size() + 1))
+                rehash((live + 1) * 2);
+
+            size_t mask = slots.size() - 1;
+            size_t i = hash & mask;
+            while (slots[i] != EMPTY)
+                i = (i + 1) & mask;
+
+            slots[i] = static_cast<uint32_t>(entries.size());
+            entries.push_back(Entry{normalize_key(key), value, hash});
+            ++live;
+        }
+
+        bool erase(const AnyValue &key)
+        {
+            size_t slot = find_slot(key, hash_key(key));
+            if (slot == NOT_FOUND)
+                return false;
+
+            auto &entry = entries[slots[slot]];
+            entry.deleted = true;
+            entry.key = Constants::UNDEFINED; // release key and value now, keep the tombstone
+            entry.value = Constants::UNDEFINED;
+            --live;
+            return true;
+        }
+
+        void clear()
+        {
+            if (pins == 0)
+            {
+                entries.clear();
+                slots.clear();
+            }
+            else
+            {
+                // Open cursors must see the cleared entries as gone and continue past them
+                for (auto &entry : entries)
+                {
+                    entry.deleted = true;
+                    entry.key = Constants::UNDEFINED;
+                    entry.value = Constants::UNDEFINED;
+                }
+            }
+            live = 0;
+        }
+
+        // Visits live entries in insertion order, including entries `fn` adds on the way.
+        // The entry is copied out first since `fn` may grow the table.
+        template <typename Fn>
+        void for_each(Fn &&fn)
+        {
+            Pin pin(*this);
+            for (size_t i = 0; i < entries.size(); ++i)
+            {
+                if (entries[i].deleted)
+                    continue;
+                AnyValue key = entries[i].key;
+                AnyValue value = entries[i].value;
+                fn(key, value);
+            }
+        }
+
+        void trace(HeapTracer visit)
+        {
+            for (auto &entry : entries)
+            {
+                visit(entry.key);
+                visit(entry.value);
+            }
+        }
+
+    private:
+        static constexpr uint32_t EMPTY = UINT32_MAX;
+        static constexpr size_t NOT_FOUND = SIZE_MAX;
+        static constexpr size_t MIN_CAPACITY = 8;
+
+        std::vector<Entry> entries;
+        std::vector<uint32_t> slots;
+        size_t live = 0;
+        uint32_t pins = 0;
+
+        static AnyValue normalize_key(const AnyValue &key) noexcept
+        {
+            if (key.is_number())
+            {
+                double d = key.as_double();
+                if (d == 0)
+                    return AnyValue::make_number(0.0);
+                if (std::isnan(d))
+                    return AnyValue::make_number(std::numeric_limits<double>::quiet_NaN());
+            }
+            return key;
+        }
+
+        // Not noexcept: hashing or comparing a rope key flattens it
+        static size_t hash_key(const AnyValue &key)
+        {
+            uint64_t bits;
+            if (key.is_number())
+            {
+                double d = key.as_double();
+                if (d == 0)
+                    d = 0.0;
+                else if (std::isnan(d))
+                    d = std::numeric_limits<double>::quiet_NaN();
+                bits = std::bit_cast<uint64_t>(d);
+            }
+            else if (key.is_string())
+            {
+                return key.as_string()->hash();
+            }
+            else if (key.is_heap_object())
+            {
+                bits = reinterpret_cast<uintptr_t>(key.get_ptr());
+            }
+            else
+            {
+                bits = (static_cast<uint64_t>(key.get_type()) << 1) | (key.is_boolean() && key.as_boolean());
+            }
+            // splitmix64 finalizer: small integers and aligned pointers differ only in bits
+            // the slot mask would otherwise drop
+            bits ^= bits >> 30;
+            bits *= 0xBF58476D1CE4E5B9ULL;
+            bits ^= bits >> 27;
+            bits *= 0x94D049BB133111EBULL;
+            bits ^= bits >> 31;
+            return static_cast<size_t>(bits);
+        }
+
+        static bool same_value_zero(const AnyValue &a, const AnyValue &b)
+        {
+            if (a == b) // identical bits: same number, same heap object or same primitive
+                return true;
+            if (a.is_number())
+            {
+                if (!b.is_number())
+                    return false;
+                double x = a.as_double(), y = b.as_double();
+                return x == y || (std::isnan(x) && std::isnan(y));
+            }
+            if (a.is_string())
+                return b.is_string() && a.as_string()->value() == b.as_string()->value();
+            return false;
+        }
+
+        // Keep the load factor (including tombstones) at or below 3/4.
+        bool needs_growth(size_t used) const noexcept { return used * 4 > slots.size() * 3; }
+
+        size_t find_slot(const AnyValue &key, size_t hash) const
+        {
+            if (slots.empty())
+                return NOT_FOUND;
+            size_t mask = slots.size() - 1;
+            for (size_t i = hash & mask; slots[i] != EMPTY; i = (i + 1) & mask)
+            {
+                const auto &entry = entries[slots[i]];
+                if (!entry.deleted && entry.hash == hash && same_value_zero(entry.key, key))
+                    return i;
+            }
+            return NOT_FOUND;
+        }
+
+        // Drops tombstones unless pinned, then rebuilds the slot index with room for
+        // `count` live entries (plus the tombstones that had to stay).
+        void rehash(size_t count)
+        {
+            if (live != entries.size())
+            {
+                if (pins == 0)
+                {
+                    std::erase_if(entries, [](const Entry &e)
+                                  { return e.deleted; });
+                }
+                else
+                {
+                    count += entries.size() - live;
+                }
+            }
+
+            size_t capacity = MIN_CAPACITY;
+            while (capacity * 3 < count * 4 + 4)
+                capacity <<= 1;
+
+            slots.assign(capacity, EMPTY);
+            size_t mask = capacity - 1;
+            for (size_t idx = 0; idx < entries.size(); ++idx)
+            {
+                if (entries[idx].deleted)
+                    continue;
+                size_t i = entries[idx].hash & mask;
+                while (slots[i] != EMPTY)
+                    i = (i + 1) & mask;
+                slots[i] = static_cast<uint32_t>(idx);
+            }
+        }
+    };
+}
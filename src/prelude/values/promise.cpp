@@ -1,6 +1,7 @@
 #include "jspp.hpp"
 #include "values/promise.hpp"
 #include "values/prototypes/promise.hpp"
+#include "utils/prototype_table.hpp"
 
 namespace jspp {
 
@@ -33,9 +34,51 @@ PromiseState::~PromiseState()
     }
 }
 
+void PromiseState::settle(PromiseStatus outcome, const AnyValue &value)
+{
+    if (status != PromiseStatus::Pending)
+        return;
+    status = outcome;
+    result = value;
+
+    auto reactions = std::move(outcome == PromiseStatus::Fulfilled ? onFulfilled : onRejected);
+    onFulfilled.clear();
+    onRejected.clear();
+    if (reactions.empty())
+        return;
+
+    // One job for the whole list keeps the order separate jobs would run in: anything
+    // a reaction queues still runs after the reactions registered alongside it
+    jspp::Scheduler::instance().enqueue([reactions = std::move(reactions), value]() mutable
+                                        {
+                                            for (auto &reaction : reactions)
+                                                reaction(value); });
+}
+
+void PromiseState::trace(HeapTracer visit)
+{
+    visit(result);
+    for (auto &reaction : onFulfilled)
+        reaction.trace(visit);
+    for (auto &reaction : onRejected)
+        reaction.trace(visit);
+}
+
 // --- JsPromise Implementation ---
 
-JsPromise::JsPromise() : state(std::make_shared<PromiseState>()) {}
+JsPromise::JsPromise() : HeapObject(JsType::Promise), state(std::make_shared<PromiseState>()) {}
+
+void JsPromise::trace(HeapTracer visit)
+{
+    for (auto &[key, value] : props)
+        visit(value);
+    for (auto &[key, value] : symbol_props)
+        visit(value);
+    // The state is shared with coroutine frames and reaction callbacks; its result and
+    // reactions are only this object's references when nothing else holds the state.
+    if (state && state.use_count() == 1)
+        state->trace(visit);
+}
 
 void JsPromise::resolve(AnyValue value)
 {
@@ -54,70 +97,28 @@ void JsPromise::resolve(AnyValue value)
         auto weak_state = std::weak_ptr<PromiseState>(state);
 
         p->then(
-            [weak_state](AnyValue v)
+            [weak_state](const AnyValue &v)
             {
                 if (auto s = weak_state.lock())
-                {
-                    s->status = PromiseStatus::Fulfilled;
-                    s->result = v;
-                    auto callbacks = s->onFulfilled;
-                    s->onFulfilled.clear();
-                    s->onRejected.clear();
-                    for (auto &cb : callbacks)
-                        jspp::Scheduler::instance().enqueue([cb, v]()
-                                                            { cb(v); });
-                }
+                    s->settle(PromiseStatus::Fulfilled, v);
             },
-            [weak_state](AnyValue r)
+            [weak_state](const AnyValue &r)
             {
                 if (auto s = weak_state.lock())
-                {
-                    s->status = PromiseStatus::Rejected;
-                    s->result = r;
-                    auto callbacks = s->onRejected;
-                    s->onFulfilled.clear();
-                    s->onRejected.clear();
-                    for (auto &cb : callbacks)
-                        jspp::Scheduler::instance().enqueue([cb, r]()
-                                                            { cb(r); });
-                }
+                    s->settle(PromiseStatus::Rejected, r);
             });
         return;
     }
 
-    state->status = PromiseStatus::Fulfilled;
-    state->result = value;
-
-    auto callbacks = state->onFulfilled;
-    state->onFulfilled.clear();
-    state->onRejected.clear();
-
-    for (auto &cb : callbacks)
-    {
-        jspp::Scheduler::instance().enqueue([cb, value]()
-                                            { cb(value); });
-    }
+    state->settle(PromiseStatus::Fulfilled, value);
 }
 
 void JsPromise::reject(AnyValue reason)
 {
-    if (state->status != PromiseStatus::Pending)
-        return;
-    state->status = PromiseStatus::Rejected;
-    state->result = reason;
-
-    auto callbacks = state->onRejected;
-    state->onFulfilled.clear();
-    state->onRejected.clear();
-
-    for (auto &cb : callbacks)
-    {
-        jspp::Scheduler::instance().enqueue([cb, reason]()
-                                            { cb(reason); });
-    }
+    state->settle(PromiseStatus::Rejected, reason);
 }
 
-void JsPromise::then(std::function<void(AnyValue)> onFulfilled, std::function<void(AnyValue)> onRejected)
+void JsPromise::then(PromiseReaction onFulfilled, PromiseReaction onRejected)
 {
     state->handled = true;
     if (state->status == PromiseStatus::Fulfilled)
@@ -125,7 +126,7 @@ void JsPromise::then(std::function<void(AnyValue)> onFulfilled, std::function<vo
         if (onFulfilled)
         {
             AnyValue val = state->result;
-            jspp::Scheduler::instance().enqueue([onFulfilled, val]()
+            jspp::Scheduler::instance().enqueue([onFulfilled = std::move(onFulfilled), val]() mutable
                                                 { onFulfilled(val); });
         }
     }
@@ -134,16 +135,16 @@ void JsPromise::then(std::function<void(AnyValue)> onFulfilled, std::function<vo
         if (onRejected)
         {
             AnyValue val = state->result;
-            jspp::Scheduler::instance().enqueue([onRejected, val]()
+            jspp::Scheduler::instance().enqueue([onRejected = std::move(onRejected), val]() mutable
                                                 { onRejected(val); });
         }
     }
     else
     {
         if (onFulfilled)
-            state->onFulfilled.push_back(onFulfilled);
+            state->onFulfilled.push_back(std::move(onFulfilled));
         if (onRejected)
-            state->onRejected.push_back(onRejected);
+            state->onRejected.push_back(std::move(onRejected));
     }
 }
 
@@ -300,6 +301,58 @@ AnyValue AnyValueAwaiter::await_resume()
 
 namespace PromisePrototypes {
 
+namespace {
+
+// One side of a reaction registered by `then`: runs the handler on the settled value
+// and settles the derived promise with its outcome. Without a handler the value
+// passes through, settling the derived promise the same way.
+struct ThenReaction
+{
+    std::shared_ptr<PromiseState> derived;
+    AnyValue handler;
+    PromiseStatus side;
+
+    void operator()(const AnyValue &value)
+    {
+        if (!handler.is_function())
+        {
+            derived->settle(side, value);
+            return;
+        }
+        try
+        {
+            const AnyValue cbArgs[] = {value};
+            auto res = handler.call(Constants::UNDEFINED, cbArgs, side == PromiseStatus::Fulfilled ? "onFulfilled" : "onRejected");
+            if (res.is_promise())
+            {
+                auto target = derived;
+                res.as_promise()->then(
+                    [target](const AnyValue &v)
+                    { target->settle(PromiseStatus::Fulfilled, v); },
+                    [target](const AnyValue &e)
+                    { target->settle(PromiseStatus::Rejected, e); });
+            }
+            else
+            {
+                derived->settle(PromiseStatus::Fulfilled, res);
+            }
+        }
+        catch (const Exception &e)
+        {
+            derived->settle(PromiseStatus::Rejected, e.data);
+        }
+        catch (...)
+        {
+            derived->settle(PromiseStatus::Rejected, AnyValue::make_string("Unknown error"));
+        }
+    }
+
+    // The handler is what usually closes a cycle back to the promise
+    void trace(HeapTracer visit) { visit(handler); }
+};
+
+} // namespace
+
 AnyValue &get_then_fn()
 {
     static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
@@ -311,109 +364,8 @@ AnyValue &get_then_fn()
                                                      JsPromise newPromise;
                                                      AnyValue newPromiseVal = AnyValue::make_promise(newPromise);
 
-                                                     auto newPromiseState = newPromise.state;
-                                                     auto resolveNew = [newPromiseState](const AnyValue &v)
-                                                     {
-                                                         if (newPromiseState->status != PromiseStatus::Pending)
-                                                             return;
-                                                         newPromiseState->status = PromiseStatus::Fulfilled;
-                                                         newPromiseState->result = v;
-                                                         auto callbacks = newPromiseState->onFulfilled;
-                                                         newPromiseState->onFulfilled.clear();
-                                                         newPromiseState->onRejected.clear();
-                                                         for (auto &cb : callbacks)
-                                                             jspp::Scheduler::instance().enqueue([cb, v]()
-                                                                                                 { cb(v); });
-                                                     };
-                                                     auto rejectNew = [newPromiseState](const AnyValue &r)
-                                                     {
-                                                         if (newPromiseState->status != PromiseStatus::Pending)
-                                                             return;
-                                                         newPromiseState->status = PromiseStatus::Rejected;
-                                                         newPromiseState->result = r;
-                                                         auto callbacks = newPromiseState->onRejected;
-                                                         newPromiseState->onFulfilled.clear();
-                                                         newPromiseState->onRejected.clear();
-                                                         for (auto &cb : callbacks)
-                                                             jspp::Scheduler::instance().enqueue([cb, r]()
-                                                                                                 { cb(r); });
-                                                     };
-
-                                                     auto resolveHandler = [resolveNew, rejectNew, onFulfilled](const AnyValue &val) mutable
-                                                     {
-                                                         if (onFulfilled.is_function())
-                                                         {
-                                                             try
-                                                             {
-                                                                 const AnyValue cbArgs[] = {val};
-                                                                 auto res = onFulfilled.call(Constants::UNDEFINED, cbArgs, "onFulfilled");
-                                                                 if (res.is_promise())
-                                                                 {
-                                                                     auto chained = res.as_promise();
-                                                                     chained->then(
-                                                                         [resolveNew](const AnyValue &v)
-                                                                         { resolveNew(v); },
-                                                                         [rejectNew](const AnyValue &e)
-                                                                         { rejectNew(e); });
-                                                                 }
-                                                                 else
-                                                                 {
-                                                                     resolveNew(res);
-                                                                 }
-                                                             }
-                                                             catch (const Exception &e)
-                                                             {
-                                                                 rejectNew(e.data);
-                                                             }
-                                                             catch (...)
-                                                             {
-                                                                 rejectNew(AnyValue::make_string("Unknown error"));
-                                                             }
-                                                         }
-                                                         else
-                                                         {
-                                                             resolveNew(val);
-                                                         }
-                                                     };
-
-                                                     auto rejectHandler = [resolveNew, rejectNew, onRejected](const AnyValue &reason) mutable
-                                                     {
-                                                         if (onRejected.is_function())
-                                                         {
-                                                             try
-                                                             {
-                                                                 const AnyValue cbArgs[] = {reason};
-                                                                 auto res = onRejected.call(Constants::UNDEFINED, cbArgs, "onRejected");
-                                                                 if (res.is_promise())
-                                                                 {
-                                                                     auto chained = res.as_promise();
-                                                                     chained->then(
-                                                                         [resolveNew](const AnyValue &v)
-                                                                         { resolveNew(v); },
-                                                                         [rejectNew](const AnyValue &e)
-                                                                         { rejectNew(e); });
-                                                                 }
-                                                                 else
-                                                                 {
-                                                                     resolveNew(res);
-                                                                 }
-                                                             }
-                                                             catch (const Exception &e)
-                                                             {
-                                                                 rejectNew(e.data);
-                                                             }
-                                                             catch (...)
-                                                             {
-                                                                 rejectNew(AnyValue::make_string("Unknown error"));
-                                                             }
-                                                         }
-                                                         else
-                                                         {
-                                                             rejectNew(reason);
-                                                         }
-                                                     };
-
-                                                     self->then(resolveHandler, rejectHandler);
+                                                     self->then(ThenReaction{newPromise.state, onFulfilled, PromiseStatus::Fulfilled},
+                                                                ThenReaction{newPromise.state, onRejected, PromiseStatus::Rejected});
                                                      return newPromiseVal; },
                                                  "then");
     return fn;
@@ -462,9 +414,13 @@ AnyValue &get_finally_fn()
 
 std::optional<AnyValue> get(const std::string &key)
 {
-    if (key == "then") return get_then_fn();
-    if (key == "catch") return get_catch_fn();
-    if (key == "finally") return get_finally_fn();
+    static constexpr PrototypeTable table(std::to_array<PrototypeEntry>({
+        PrototypeEntry{"then", &get_then_fn},
+        PrototypeEntry{"catch", &get_catch_fn},
+        PrototypeEntry{"finally", &get_finally_fn},
+    }));
+    if (auto fn = table.find(key))
+        return *fn;
     return std::nullopt;
 }
 
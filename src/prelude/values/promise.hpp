@@ -2,6 +2,7 @@
 
 #include "types.hpp"
 #include "any_value.hpp"
+#include "utils/promise_reaction.hpp"
 #include <vector>
 #include <functional>
 #include <memory>
@@ -21,13 +22,20 @@ namespace jspp
     {
         PromiseStatus status = PromiseStatus::Pending;
         AnyValue result; // Value if fulfilled, reason if rejected
-        std::vector<std::function<void(const AnyValue&)>> onFulfilled;
-        std::vector<std::function<void(const AnyValue&)>> onRejected;
+        std::vector<PromiseReaction> onFulfilled;
+        std::vector<PromiseReaction> onRejected;
         
         bool handled = false;
 
         PromiseState(); // Defined in helpers
         ~PromiseState(); // Defined in helpers
+
+        // Settles a pending state and queues the matching reactions as one microtask,
+        // which runs them in registration order; settling twice does nothing.
+        void settle(PromiseStatus outcome, const AnyValue& value);
+
+        // Visits the result and every value the pending reactions hold
+        void trace(HeapTracer visit);
     };
 
     struct JsPromisePromiseType; // Forward declaration
@@ -42,12 +50,12 @@ namespace jspp
 
         JsPromise();
 
-        JsType get_heap_type() const override { return JsType::Promise; }
+        void trace(HeapTracer visit) override;
 
         // --- Promise Logic ---
         void resolve(AnyValue value);
         void reject(AnyValue reason);
-        void then(std::function<void(AnyValue)> onFulfilled, std::function<void(AnyValue)> onRejected = nullptr);
+        void then(PromiseReaction onFulfilled, PromiseReaction onRejected = {});
         
         // --- Methods ---
         std::string to_std_string() const;
@@ -63,6 +71,9 @@ namespace jspp
     struct JsPromisePromiseType {
         JsPromise promise;
 
+        static void* operator new(std::size_t size) { return FrameAllocator::allocate(size); }
+        static void operator delete(void* ptr, std::size_t size) noexcept { FrameAllocator::deallocate(ptr, size); }
+
         JsPromise get_return_object() { return promise; }
         std::suspend_never initial_suspend() { return {}; }
         std::suspend_never final_suspend() noexcept { return {}; }
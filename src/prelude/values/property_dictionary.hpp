@@ -0,0 +1,161 @@
+#pragma once
+
+#include "types.hpp"
+#include "property_key.hpp"
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace jspp
+{
+    // Insertion-ordered open-addressing hash table backing JsObject in dictionary mode.
+    // Entries are appended in insertion order; `slots` is a linear-probing index into them.
+    // A deleted entry stays referenced from its slot as a tombstone until the next rehash.
+    class PropertyDictionary
+    {
+    public:
+        struct Entry
+        {
+            std::string key;
+            AnyValue value;
+            size_t hash;
+            bool deleted = false;
+        };
+
+        size_t size() const noexcept { return live; }
+
+        void reserve(size_t count)
+        {
+            entries.reserve(count);
+            if (needs_growth(count))
+                rehash(count);
+        }
+
+        // Overloads taking a PropertyKey reuse the atom's hash, which is the hash of its name.
+        AnyValue *find(const std::string &key) { return find(key, hash_key(key)); }
+        AnyValue *find(PropertyKey key) { return find(key.str(), key.hash()); }
+        const AnyValue *find(const std::string &key) const { return find(key, hash_key(key)); }
+        const AnyValue *find(PropertyKey key) const { return find(key.str(), key.hash()); }
+
+        AnyValue *find(const std::string &key, size_t hash)
+        {
+            size_t slot = find_slot(key, hash);
+            return slot == NOT_FOUND ? nullptr : &entries[slots[slot]].value;
+        }
+
+        const AnyValue *find(const std::string &key, size_t hash) const
+        {
+            size_t slot = find_slot(key, hash);
+            return slot == NOT_FOUND ? nullptr : &entries[slots[slot]].value;
+        }
+
+        // Appends a new entry; the caller guarantees `key` is not present.
+        AnyValue *insert(const std::string &key, const AnyValue &value) { return insert(key, hash_key(key), value); }
+        AnyValue *insert(PropertyKey key, const AnyValue &value) { return insert(key.str(), key.hash(), value); }
+
+        AnyValue *insert(const std::string &key, size_t hash, const AnyValue &value)
+        {
+            if (needs_growth(entries.size() + 1))
+                rehash((live + 1) * 2);
+
+            size_t mask = slots.size() - 1;
+            size_t i = hash & mask;
+            while (slots[i] != EMPTY)
+                i = (i + 1) & mask;
+
+            slots[i] = static_cast<uint32_t>(entries.size());
+            entries.push_back(Entry{key, value, hash});
+            ++live;
+            return &entries.back().value;
+        }
+
+        bool erase(const std::string &key) { return erase(key, hash_key(key)); }
+        bool erase(PropertyKey key) { return erase(key.str(), key.hash()); }
+
+        bool erase(const std::string &key, size_t hash)
+        {
+            size_t slot = find_slot(key, hash);
+            if (slot == NOT_FOUND)
+                return false;
+
+            auto &entry = entries[slots[slot]];
+            entry.deleted = true;
+            entry.value = Constants::UNDEFINED; // release the value now, keep the tombstone
+            --live;
+            return true;
+        }
+
+        // Visits live entries in insertion order.
+        template <typename Fn>
+        void for_each(Fn &&fn) const
+        {
+            for (const auto &entry : entries)
+            {
+                if (!entry.deleted)
+                    fn(entry.key, entry.value);
+            }
+        }
+
+        template <typename Fn>
+        void for_each(Fn &&fn)
+        {
+            for (auto &entry : entries)
+            {
+                if (!entry.deleted)
+                    fn(entry.key, entry.value);
+            }
+        }
+
+    private:
+        static constexpr uint32_t EMPTY = UINT32_MAX;
+        static constexpr size_t NOT_FOUND = SIZE_MAX;
+        static constexpr size_t MIN_CAPACITY = 8;
+
+        std::vector<Entry> entries;
+        std::vector<uint32_t> slots;
+        size_t live = 0;
+
+        static size_t hash_key(const std::string &key) noexcept { return std::hash<std::string>{}(key); }
+
+        // Keep the load factor (including tombstones) at or below 3/4.
+        bool needs_growth(size_t used) const noexcept { return used * 4 > slots.size() * 3; }
+
+        size_t find_slot(const std::string &key, size_t hash) const
+        {
+            if (slots.empty())
+                return NOT_FOUND;
+            size_t mask = slots.size() - 1;
+            for (size_t i = hash & mask; slots[i] != EMPTY; i = (i + 1) & mask)
+            {
+                const auto &entry = entries[slots[i]];
+                if (!entry.deleted && entry.hash == hash && entry.key == key)
+                    return i;
+            }
+            return NOT_FOUND;
+        }
+
+        // Drops tombstones and rebuilds the slot index with room for `count` live entries.
+        void rehash(size_t count)
+        {
+            if (live != entries.size())
+            {
+                std::erase_if(entries, [](const Entry &e)
+                              { return e.deleted; });
+            }
+
+            size_t capacity = MIN_CAPACITY;
+            while (capacity * 3 < count * 4 + 4)
+                capacity <<= 1;
+
+            slots.assign(capacity, EMPTY);
+            size_t mask = capacity - 1;
+            for (size_t idx = 0; idx < entries.size(); ++idx)
+            {
+                size_t i = entries[idx].hash & mask;
+                while (slots[i] != EMPTY)
+                    i = (i + 1) & mask;
+                slots[i] = static_cast<uint32_t>(idx);
+            }
+        }
+    };
+}
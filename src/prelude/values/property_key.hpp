@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <functional>
+
+namespace jspp {
+
+// An interned property name. Every distinct name has exactly one Atom, which lives
+// for the rest of the program, so equal keys compare by pointer and the hash is
+// computed once at interning time.
+struct Atom {
+    std::string name;
+    size_t hash;
+};
+
+// Hash and equality for tables keyed by atoms that can also be probed with a plain
+// name. Both hashes agree because an atom's hash is the hash of its name.
+struct AtomHash {
+    using is_transparent = void;
+    size_t operator()(const Atom* atom) const noexcept { return atom->hash; }
+    size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+};
+
+struct AtomEqual {
+    using is_transparent = void;
+    bool operator()(const Atom* a, const Atom* b) const noexcept { return a == b; }
+    bool operator()(const Atom* atom, std::string_view name) const noexcept { return atom->name == name; }
+    bool operator()(std::string_view name, const Atom* atom) const noexcept { return atom->name == name; }
+};
+
+class PropertyKey {
+public:
+    explicit PropertyKey(std::string_view name) : atom(intern(name)) {}
+    explicit PropertyKey(const char* name) : atom(intern(name)) {}
+    explicit PropertyKey(const std::string& name) : atom(intern(name)) {}
+    // Wraps an atom already returned by find()
+    explicit PropertyKey(const Atom* interned) noexcept : atom(interned) {}
+
+    // The interned key for `name` if one exists, without creating it.
+    // A name that was never interned cannot be a key of any shape.
+    static const Atom* find(std::string_view name) {
+        auto& t = table();
+        auto it = t.find(name);
+        return it != t.end() ? it->second.get() : nullptr;
+    }
+
+    const Atom* get() const noexcept { return atom; }
+    const std::string& str() const noexcept { return atom->name; }
+    size_t hash() const noexcept { return atom->hash; }
+
+    // Lets a key flow into the std::string-based property API without a copy
+    operator const std::string&() const noexcept { return atom->name; }
+
+    bool operator==(const PropertyKey& other) const noexcept { return atom == other.atom; }
+
+private:
+    const Atom* atom;
+
+    using Table = std::unordered_map<std::string_view, std::unique_ptr<Atom>>;
+
+    // Never destroyed: atoms are referenced from shapes and statics that outlive main
+    static Table& table() {
+        static Table* t = new Table();
+        return *t;
+    }
+
+    static const Atom* intern(std::string_view name) {
+        auto& t = table();
+        auto it = t.find(name);
+        if (it != t.end()) return it->second.get();
+        size_t h = std::hash<std::string_view>{}(name);
+        auto atom = std::unique_ptr<Atom>(new Atom{std::string(name), h});
+        const Atom* result = atom.get();
+        t.emplace(std::string_view(result->name), std::move(atom));
+        return result;
+    }
+};
+
+}
+
+template <>
+struct std::hash<jspp::PropertyKey> {
+    size_t operator()(const jspp::PropertyKey& key) const noexcept { return key.hash(); }
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "types.hpp"
+#include <optional>
+
+namespace jspp
+{
+    class AnyValue;
+
+    namespace MapPrototypes
+    {
+        AnyValue &get_get_fn();
+        AnyValue &get_set_fn();
+        AnyValue &get_has_fn();
+        AnyValue &get_delete_fn();
+        AnyValue &get_clear_fn();
+        AnyValue &get_forEach_fn();
+        AnyValue &get_keys_fn();
+        AnyValue &get_values_fn();
+        AnyValue &get_entries_fn();
+        AnyValue &get_size_desc();
+        AnyValue &get_toString_fn();
+
+        std::optional<AnyValue> get(const std::string &key);
+        std::optional<AnyValue> get(const AnyValue &key);
+    }
+}
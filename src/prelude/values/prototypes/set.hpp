@@ -0,0 +1,32 @@
+#pragma once
+
+#include "types.hpp"
+#include <optional>
+
+namespace jspp
+{
+    class AnyValue;
+
+    namespace SetPrototypes
+    {
+        AnyValue &get_add_fn();
+        AnyValue &get_has_fn();
+        AnyValue &get_delete_fn();
+        AnyValue &get_clear_fn();
+        AnyValue &get_forEach_fn();
+        AnyValue &get_values_fn();
+        AnyValue &get_entries_fn();
+        AnyValue &get_size_desc();
+        AnyValue &get_union_fn();
+        AnyValue &get_intersection_fn();
+        AnyValue &get_difference_fn();
+        AnyValue &get_symmetricDifference_fn();
+        AnyValue &get_isSubsetOf_fn();
+        AnyValue &get_isSupersetOf_fn();
+        AnyValue &get_isDisjointFrom_fn();
+        AnyValue &get_toString_fn();
+
+        std::optional<AnyValue> get(const std::string &key);
+        std::optional<AnyValue> get(const AnyValue &key);
+    }
+}
@@ -0,0 +1,505 @@
+#include "jspp.hpp"
+#include "values/set.hpp"
+#include "values/prototypes/set.hpp"
+#include "utils/prototype_table.hpp"
+
+namespace jspp {
+
+// --- JsSet Implementation ---
+
+JsSet::JsSet() : HeapObject(JsType::Set), proto(Constants::Null) {}
+JsSet::JsSet(AnyValue p) : HeapObject(JsType::Set), proto(std::move(p)) {}
+
+void JsSet::trace(HeapTracer visit)
+{
+    table.trace(visit);
+    for (auto &[key, value] : props)
+        visit(value);
+    for (auto &[key, value] : symbol_props)
+        visit(value);
+    visit(proto);
+}
+
+std::string JsSet::to_std_string() const
+{
+    return "[object Set]";
+}
+
+bool JsSet::has_property(const std::string &key) const
+{
+    if (props.find(key) != props.end())
+        return true;
+    if (!proto.is_null() && !proto.is_undefined())
+    {
+        if (proto.has_property(key))
+            return true;
+    }
+    if (SetPrototypes::get(key).has_value())
+        return true;
+    return false;
+}
+
+bool JsSet::has_symbol_property(const AnyValue &key) const
+{
+    if (symbol_props.count(key))
+        return true;
+    if (!proto.is_null() && !proto.is_undefined())
+    {
+        if (proto.has_property(key))
+            return true;
+    }
+    if (SetPrototypes::get(key).has_value())
+        return true;
+    return false;
+}
+
+AnyValue JsSet::get_property(const std::string &key, const AnyValue &thisVal)
+{
+    auto it = props.find(key);
+    if (it != props.end())
+        return AnyValue::resolve_property_for_read(it->second, thisVal, key);
+
+    if (!proto.is_null() && !proto.is_undefined())
+    {
+        if (proto.has_property(key))
+            return proto.get_property_with_receiver(key, thisVal);
+    }
+
+    auto proto_it = SetPrototypes::get(key);
+    if (proto_it.has_value())
+        return AnyValue::resolve_property_for_read(proto_it.value(), thisVal, key);
+    return Constants::UNDEFINED;
+}
+
+AnyValue JsSet::get_symbol_property(const AnyValue &key, const AnyValue &thisVal)
+{
+    auto it = symbol_props.find(key);
+    if (it != symbol_props.end())
+        return AnyValue::resolve_property_for_read(it->second, thisVal, key.to_std_string());
+
+    if (!proto.is_null() && !proto.is_undefined())
+    {
+        if (proto.has_property(key))
+            return proto.get_symbol_property_with_receiver(key, thisVal);
+    }
+
+    auto proto_it = SetPrototypes::get(key);
+    if (proto_it.has_value())
+        return AnyValue::resolve_property_for_read(proto_it.value(), thisVal, key.to_std_string());
+    return Constants::UNDEFINED;
+}
+
+AnyValue JsSet::set_property(const std::string &key, const AnyValue &value, const AnyValue &thisVal)
+{
+    auto proto_it = SetPrototypes::get(key);
+    if (proto_it.has_value() && proto_it.value().is_accessor_descriptor())
+        return AnyValue::resolve_property_for_write(proto_it.value(), thisVal, value, key);
+
+    auto it = props.find(key);
+    if (it != props.end())
+        return AnyValue::resolve_property_for_write(it->second, thisVal, value, key);
+    props[key] = value;
+    return value;
+}
+
+AnyValue JsSet::set_symbol_property(const AnyValue &key, const AnyValue &value, const AnyValue &thisVal)
+{
+    auto it = symbol_props.find(key);
+    if (it != symbol_props.end())
+        return AnyValue::resolve_property_for_write(it->second, thisVal, value, key.to_std_string());
+    symbol_props[key] = value;
+    return value;
+}
+
+// --- SetPrototypes Implementation ---
+
+namespace SetPrototypes {
+
+static JsSet *this_set(const AnyValue &thisVal, const char *method)
+{
+    if (!thisVal.is_set()) [[unlikely]]
+        throw Exception::make_exception(std::string("Method Set.prototype.") + method + " called on incompatible receiver " + thisVal.to_std_string(), "TypeError");
+    return thisVal.as_set();
+}
+
+static const AnyValue &arg_or_undefined(std::span<const AnyValue> args, size_t i)
+{
+    return i < args.size() ? args[i] : Constants::UNDEFINED;
+}
+
+// The `other` argument of the set-algebra methods (GetSetRecord). Sets and Maps are read
+// straight from their tables; any other object goes through its size/has/keys members.
+class SetRecord
+{
+public:
+    SetRecord(const AnyValue &other, const char *method) : obj(other)
+    {
+        if (other.is_set())
+            table = &other.as_set()->table;
+        else if (other.is_map())
+            table = &other.as_map()->table;
+        if (table)
+        {
+            size = static_cast<double>(table->size());
+            return;
+        }
+
+        if (!other.is_object() && !other.is_array() && !other.is_function())
+            throw Exception::make_exception(std::string("Set.prototype.") + method + ": " + other.to_std_string() + " is not an object", "TypeError");
+        AnyValue rawSize = other.get_own_property("size");
+        size = rawSize.is_number() ? rawSize.as_double() : std::nan("");
+        if (std::isnan(size))
+            throw Exception::make_exception(std::string("Set.prototype.") + method + ": 'size' is not a number", "TypeError");
+        has = other.get_own_property("has");
+        if (!has.is_function())
+            throw Exception::make_exception(std::string("Set.prototype.") + method + ": 'has' is not a function", "TypeError");
+        keys = other.get_own_property("keys");
+        if (!keys.is_function())
+            throw Exception::make_exception(std::string("Set.prototype.") + method + ": 'keys' is not a function", "TypeError");
+    }
+
+    double size = 0;
+
+    bool contains(const AnyValue &key) const
+    {
+        if (table)
+            return table->contains(key);
+        const AnyValue hasArgs[] = {key};
+        return is_truthy(has.call(obj, hasArgs, "has"));
+    }
+
+    // Visits the keys of `other`; stops early once `fn` returns false
+    template <typename Fn>
+    void for_each_key(Fn &&fn) const
+    {
+        if (table)
+        {
+            OrderedHashTable::Pin pin(*table);
+            for (size_t i = 0; i < table->extent(); ++i)
+            {
+                const auto *entry = table->at(i);
+                if (!entry)
+                    continue;
+                AnyValue key = entry->key;
+                if (!fn(key))
+                    return;
+            }
+            return;
+        }
+        AnyValue iter = keys.call(obj, {}, "keys");
+        AnyValue next = iter.get_own_property("next");
+        AnyValue value;
+        while (Access::iterator_step(iter, next, value))
+        {
+            if (!fn(value))
+                return;
+        }
+    }
+
+private:
+    AnyValue obj;
+    OrderedHashTable *table = nullptr;
+    AnyValue has;
+    AnyValue keys;
+};
+
+static AnyValue copy_set(const JsSet *self)
+{
+    auto result = AnyValue::make_set();
+    auto &table = result.as_set()->table;
+    for (size_t i = 0; i < self->table.extent(); ++i)
+    {
+        if (const auto *entry = self->table.at(i))
+            table.set(entry->key, Constants::UNDEFINED);
+    }
+    return result;
+}
+
+AnyValue &get_add_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "add");
+                                                     self->table.set(arg_or_undefined(args, 0), Constants::UNDEFINED);
+                                                     return thisVal; },
+                                                 "add", false);
+    return fn;
+}
+
+AnyValue &get_has_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "has");
+                                                     return AnyValue::make_boolean(self->table.contains(arg_or_undefined(args, 0))); },
+                                                 "has", false);
+    return fn;
+}
+
+AnyValue &get_delete_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "delete");
+                                                     return AnyValue::make_boolean(self->table.erase(arg_or_undefined(args, 0))); },
+                                                 "delete", false);
+    return fn;
+}
+
+AnyValue &get_clear_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue>) -> AnyValue
+                                                 {
+                                                     this_set(thisVal, "clear")->table.clear();
+                                                     return Constants::UNDEFINED; },
+                                                 "clear", false);
+    return fn;
+}
+
+AnyValue &get_forEach_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "forEach");
+                                                     if (args.empty() || !args[0].is_function())
+                                                     {
+                                                         throw Exception::make_exception(arg_or_undefined(args, 0).to_std_string() + " is not a function", "TypeError");
+                                                     }
+                                                     auto callback = args[0].as_function();
+                                                     const AnyValue &thisArg = arg_or_undefined(args, 1);
+                                                     self->table.for_each([&](const AnyValue &key, const AnyValue &)
+                                                                          {
+                                                                              const AnyValue cbArgs[] = {key, key, thisVal};
+                                                                              callback->call(thisArg, cbArgs); });
+                                                     return Constants::UNDEFINED; },
+                                                 "forEach", false);
+    return fn;
+}
+
+AnyValue &get_values_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue>) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "values");
+                                                     return AnyValue::from_iterator(iterate_collection(thisVal, self->table, CollectionIteration::Keys)); },
+                                                 "values", false);
+    return fn;
+}
+
+AnyValue &get_entries_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue>) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "entries");
+                                                     return AnyValue::from_iterator(iterate_collection(thisVal, self->table, CollectionIteration::Entries)); },
+                                                 "entries", false);
+    return fn;
+}
+
+AnyValue &get_size_desc()
+{
+    static auto getter = [](const AnyValue &thisVal, std::span<const AnyValue>) -> AnyValue
+    {
+        return AnyValue::make_number(static_cast<double>(this_set(thisVal, "size")->table.size()));
+    };
+    static AnyValue desc = AnyValue::make_accessor_descriptor(getter, std::nullopt, false, true);
+    return desc;
+}
+
+AnyValue &get_union_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "union");
+                                                     SetRecord other(arg_or_undefined(args, 0), "union");
+                                                     auto result = copy_set(self);
+                                                     auto &table = result.as_set()->table;
+                                                     other.for_each_key([&](const AnyValue &key)
+                                                                        { table.set(key, Constants::UNDEFINED); return true; });
+                                                     return result; },
+                                                 "union", false);
+    return fn;
+}
+
+AnyValue &get_intersection_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "intersection");
+                                                     SetRecord other(arg_or_undefined(args, 0), "intersection");
+                                                     auto result = AnyValue::make_set();
+                                                     auto &table = result.as_set()->table;
+                                                     if (static_cast<double>(self->table.size()) <= other.size)
+                                                     {
+                                                         self->table.for_each([&](const AnyValue &key, const AnyValue &)
+                                                                              {
+                                                                                  if (other.contains(key))
+                                                                                      table.set(key, Constants::UNDEFINED); });
+                                                     }
+                                                     else
+                                                     {
+                                                         other.for_each_key([&](const AnyValue &key)
+                                                                            {
+                                                                                if (self->table.contains(key))
+                                                                                    table.set(key, Constants::UNDEFINED);
+                                                                                return true; });
+                                                     }
+                                                     return result; },
+                                                 "intersection", false);
+    return fn;
+}
+
+AnyValue &get_difference_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "difference");
+                                                     SetRecord other(arg_or_undefined(args, 0), "difference");
+                                                     auto result = copy_set(self);
+                                                     auto &table = result.as_set()->table;
+                                                     if (static_cast<double>(self->table.size()) <= other.size)
+                                                     {
+                                                         self->table.for_each([&](const AnyValue &key, const AnyValue &)
+                                                                              {
+                                                                                  if (other.contains(key))
+                                                                                      table.erase(key); });
+                                                     }
+                                                     else
+                                                     {
+                                                         other.for_each_key([&](const AnyValue &key)
+                                                                            { table.erase(key); return true; });
+                                                     }
+                                                     return result; },
+                                                 "difference", false);
+    return fn;
+}
+
+AnyValue &get_symmetricDifference_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "symmetricDifference");
+                                                     SetRecord other(arg_or_undefined(args, 0), "symmetricDifference");
+                                                     auto result = copy_set(self);
+                                                     auto &table = result.as_set()->table;
+                                                     other.for_each_key([&](const AnyValue &key)
+                                                                        {
+                                                                            if (self->table.contains(key))
+                                                                                table.erase(key);
+                                                                            else
+                                                                                table.set(key, Constants::UNDEFINED);
+                                                                            return true; });
+                                                     return result; },
+                                                 "symmetricDifference", false);
+    return fn;
+}
+
+AnyValue &get_isSubsetOf_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "isSubsetOf");
+                                                     SetRecord other(arg_or_undefined(args, 0), "isSubsetOf");
+                                                     if (static_cast<double>(self->table.size()) > other.size)
+                                                         return Constants::FALSE;
+                                                     bool subset = true;
+                                                     OrderedHashTable::Pin pin(self->table);
+                                                     for (size_t i = 0; subset && i < self->table.extent(); ++i)
+                                                     {
+                                                         if (const auto *entry = self->table.at(i))
+                                                             subset = other.contains(AnyValue(entry->key));
+                                                     }
+                                                     return AnyValue::make_boolean(subset); },
+                                                 "isSubsetOf", false);
+    return fn;
+}
+
+AnyValue &get_isSupersetOf_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "isSupersetOf");
+                                                     SetRecord other(arg_or_undefined(args, 0), "isSupersetOf");
+                                                     if (static_cast<double>(self->table.size()) < other.size)
+                                                         return Constants::FALSE;
+                                                     bool superset = true;
+                                                     other.for_each_key([&](const AnyValue &key)
+                                                                        { return superset = self->table.contains(key); });
+                                                     return AnyValue::make_boolean(superset); },
+                                                 "isSupersetOf", false);
+    return fn;
+}
+
+AnyValue &get_isDisjointFrom_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
+                                                 {
+                                                     auto self = this_set(thisVal, "isDisjointFrom");
+                                                     SetRecord other(arg_or_undefined(args, 0), "isDisjointFrom");
+                                                     bool disjoint = true;
+                                                     if (static_cast<double>(self->table.size()) <= other.size)
+                                                     {
+                                                         OrderedHashTable::Pin pin(self->table);
+                                                         for (size_t i = 0; disjoint && i < self->table.extent(); ++i)
+                                                         {
+                                                             if (const auto *entry = self->table.at(i))
+                                                                 disjoint = !other.contains(AnyValue(entry->key));
+                                                         }
+                                                     }
+                                                     else
+                                                     {
+                                                         other.for_each_key([&](const AnyValue &key)
+                                                                            { return disjoint = !self->table.contains(key); });
+                                                     }
+                                                     return AnyValue::make_boolean(disjoint); },
+                                                 "isDisjointFrom", false);
+    return fn;
+}
+
+AnyValue &get_toString_fn()
+{
+    static AnyValue fn = AnyValue::make_function([](const AnyValue &, std::span<const AnyValue>) -> AnyValue
+                                                 { return AnyValue::make_string("[object Set]"); },
+                                                 "toString", false);
+    return fn;
+}
+
+std::optional<AnyValue> get(const std::string &key)
+{
+    static constexpr PrototypeTable table(std::to_array<PrototypeEntry>({
+        PrototypeEntry{"add", &get_add_fn},
+        PrototypeEntry{"has", &get_has_fn},
+        PrototypeEntry{"delete", &get_delete_fn},
+        PrototypeEntry{"clear", &get_clear_fn},
+        PrototypeEntry{"forEach", &get_forEach_fn},
+        PrototypeEntry{"values", &get_values_fn},
+        PrototypeEntry{"keys", &get_values_fn},
+        PrototypeEntry{"entries", &get_entries_fn},
+        PrototypeEntry{"size", &get_size_desc},
+        PrototypeEntry{"union", &get_union_fn},
+        PrototypeEntry{"intersection", &get_intersection_fn},
+        PrototypeEntry{"difference", &get_difference_fn},
+        PrototypeEntry{"symmetricDifference", &get_symmetricDifference_fn},
+        PrototypeEntry{"isSubsetOf", &get_isSubsetOf_fn},
+        PrototypeEntry{"isSupersetOf", &get_isSupersetOf_fn},
+        PrototypeEntry{"isDisjointFrom", &get_isDisjointFrom_fn},
+        PrototypeEntry{"toString", &get_toString_fn},
+    }));
+    if (auto fn = table.find(key))
+        return *fn;
+    return std::nullopt;
+}
+
+std::optional<AnyValue> get(const AnyValue &key)
+{
+    if (key.is_string())
+        return get(key.as_string()->value());
+
+    if (key == AnyValue::from_symbol(WellKnownSymbols::iterator)) return get_values_fn();
+
+    return std::nullopt;
+}
+
+} // namespace SetPrototypes
+
+} // namespace jspp
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "types.hpp"
+#include "values/map.hpp"
+#include <optional>
+
+namespace jspp
+{
+    // Forward declaration of AnyValue
+    class AnyValue;
+
+    struct JsSet : HeapObject
+    {
+        OrderedHashTable table; // values are unused; a Set only stores keys
+        std::unordered_map<std::string, AnyValue> props;
+        std::map<AnyValue, AnyValue> symbol_props;
+        AnyValue proto;
+
+        JsSet();
+        explicit JsSet(AnyValue proto);
+
+        void trace(HeapTracer visit) override;
+
+        std::string to_std_string() const;
+        bool has_property(const std::string &key) const;
+        bool has_symbol_property(const AnyValue &key) const;
+        AnyValue get_property(const std::string &key, const AnyValue &thisVal);
+        AnyValue get_symbol_property(const AnyValue &key, const AnyValue &thisVal);
+        AnyValue set_property(const std::string &key, const AnyValue &value, const AnyValue &thisVal);
+        AnyValue set_symbol_property(const AnyValue &key, const AnyValue &value, const AnyValue &thisVal);
+    };
+}
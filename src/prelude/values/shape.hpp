@@ -1,52 +1,133 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <memory>
 #include <optional>
 #include <span>
+#include "property_key.hpp"
 
 namespace jspp {
 
+// Shapes form a transition tree rooted at empty_shape(). Every shape is owned by
+// its parent's transition list and lives as long as the root, so objects hold a
+// plain `Shape*` and no reference counting happens on creation or transition.
 class Shape {
 public:
-    // Map property name -> storage index
-    std::unordered_map<std::string, uint32_t> property_offsets;
-    // Map property name -> next Shape (transitions)
-    std::unordered_map<std::string, std::shared_ptr<Shape>> transitions;
-    
-    // For fast enumeration (Object.keys)
-    std::vector<std::string> property_names; 
+    // Shapes with at most this many properties/transitions are searched linearly.
+    static constexpr uint32_t INLINE_LOOKUP_LIMIT = 8;
+
+    // Key storage shared along a transition chain. A shape with `count` properties
+    // owns the prefix keys[0, count); children extend the same table in place when
+    // they are the first to grow it, so building an N-property object is O(N).
+    // Keys are atoms, so lookups by key compare pointers; a lookup by name probes
+    // the same index directly and never touches the atom table.
+    struct KeyTable {
+        std::vector<const Atom*> keys;
+        std::unordered_map<const Atom*, uint32_t, AtomHash, AtomEqual> index;
+
+        void append(const Atom* name) {
+            keys.push_back(name);
+            index.emplace(name, static_cast<uint32_t>(keys.size() - 1));
+        }
+    };
+
+    Shape() : owned_table(std::make_unique<KeyTable>()), table(owned_table.get()) {}
+    Shape(const Shape&) = delete;
+    Shape& operator=(const Shape&) = delete;
 
     // Singleton empty shape
-    static std::shared_ptr<Shape> empty_shape() {
-        static auto shape = std::make_shared<Shape>();
-        return shape;
+    static Shape* empty_shape() {
+        static Shape shape;
+        return &shape;
+    }
+
+    Shape* get_parent() const noexcept { return parent; }
+    uint32_t property_count() const noexcept { return count; }
+    const std::string& key_at(uint32_t offset) const { return table->keys[offset]->name; }
+    const Atom* atom_at(uint32_t offset) const { return table->keys[offset]; }
+
+    std::optional<uint32_t> get_offset(PropertyKey key) const {
+        const Atom* name = key.get();
+        if (count <= INLINE_LOOKUP_LIMIT) {
+            for (uint32_t i = 0; i < count; ++i) {
+                if (table->keys[i] == name) return i;
+            }
+            return std::nullopt;
+        }
+        auto it = table->index.find(name);
+        // Entries past `count` belong to descendants sharing this table
+        if (it != table->index.end() && it->second < count) return it->second;
+        return std::nullopt;
     }
 
     std::optional<uint32_t> get_offset(const std::string& name) const {
-        auto it = property_offsets.find(name);
-        if (it != property_offsets.end()) return it->second;
+        if (count <= INLINE_LOOKUP_LIMIT) {
+            for (uint32_t i = 0; i < count; ++i) {
+                if (table->keys[i]->name == name) return i;
+            }
+            return std::nullopt;
+        }
+        auto it = table->index.find(std::string_view(name));
+        if (it != table->index.end() && it->second < count) return it->second;
         return std::nullopt;
     }
 
-    std::shared_ptr<Shape> transition(const std::string& name) {
-        auto it = transitions.find(name);
-        if (it != transitions.end()) return it->second;
-
-        // Create new shape
-        auto new_shape = std::make_shared<Shape>();
-        new_shape->property_offsets = this->property_offsets;
-        new_shape->property_names = this->property_names;
-        
-        uint32_t new_offset = static_cast<uint32_t>(new_shape->property_offsets.size());
-        new_shape->property_offsets[name] = new_offset;
-        new_shape->property_names.push_back(name);
-
-        transitions[name] = new_shape;
-        return new_shape;
+    // Interns `name`, so the key lives for the rest of the program
+    Shape* transition(const std::string& name) { return transition(PropertyKey(name)); }
+
+    Shape* transition(PropertyKey key) {
+        const Atom* name = key.get();
+        if (Shape* existing = find_transition(name)) return existing;
+
+        auto child = std::unique_ptr<Shape>(new Shape(this));
+        if (table->keys.size() == count) {
+            child->table = table;
+        } else {
+            // Another branch already extended the shared table; fork our prefix
+            child->owned_table = std::make_unique<KeyTable>();
+            child->table = child->owned_table.get();
+            for (uint32_t i = 0; i < count; ++i) child->table->append(table->keys[i]);
+        }
+        child->table->append(name);
+
+        Shape* result = child.get();
+        transitions.push_back(std::move(child));
+        if (transitions.size() > INLINE_LOOKUP_LIMIT) {
+            if (transition_index.empty()) {
+                for (const auto& t : transitions) transition_index.emplace(t->last_key(), t.get());
+            } else {
+                transition_index.emplace(result->last_key(), result);
+            }
+        }
+        return result;
     }
+
+private:
+    explicit Shape(Shape* p) : parent(p), count(p->count + 1) {}
+
+    const Atom* last_key() const { return table->keys[count - 1]; }
+
+    Shape* find_transition(const Atom* name) const {
+        if (transition_index.empty()) {
+            for (const auto& t : transitions) {
+                if (t->last_key() == name) return t.get();
+            }
+            return nullptr;
+        }
+        auto it = transition_index.find(name);
+        return it != transition_index.end() ? it->second : nullptr;
+    }
+
+    Shape* parent = nullptr;
+    uint32_t count = 0;
+    // The shape that created a table owns it; descendants sharing it are destroyed first
+    std::unique_ptr<KeyTable> owned_table;
+    KeyTable* table = nullptr;
+    std::vector<std::unique_ptr<Shape>> transitions;
+    std::unordered_map<const Atom*, Shape*> transition_index;
 };
 
 }
@@ -1,14 +1,148 @@
 #include "jspp.hpp"
 #include "values/string.hpp"
 #include "values/prototypes/string.hpp"
+#include "utils/prototype_table.hpp"
+#include <array>
 
 namespace jspp {
 
 // --- JsString Implementation ---
 
+JsString::JsString(const JsString *l, const JsString *r) noexcept
+    : HeapObject(JsType::String), left(l), right(r), len(l->len + r->len)
+{
+    l->ref();
+    r->ref();
+}
+
+JsString::~JsString()
+{
+    if (left)
+        release_children(left, right);
+}
+
+void JsString::release_children(const JsString *l, const JsString *r)
+{
+    auto owns_rope = [](const JsString *s)
+    { return s->left && s->ref_count == 1; };
+    if (!owns_rope(l) && !owns_rope(r))
+    {
+        l->deref();
+        r->deref();
+        return;
+    }
+
+    // Dropping the last reference to a long chain of nodes would recurse once per
+    // level; a node about to die hands its children to this loop instead.
+    std::vector<const JsString *> pending{r, l};
+    while (!pending.empty())
+    {
+        const JsString *node = pending.back();
+        pending.pop_back();
+        if (owns_rope(node))
+        {
+            pending.push_back(node->right);
+            pending.push_back(node->left);
+            node->left = nullptr;
+            node->right = nullptr;
+        }
+        node->deref();
+    }
+}
+
+void JsString::flatten() const
+{
+    std::string out;
+    std::vector<const JsString *> pending{right};
+
+    // A flat left half that nothing else references is extended in place, so code
+    // that appends and reads in turn still only copies each character once
+    if (!left->left && left->ref_count == 1)
+        out = std::move(left->flat);
+    else
+        pending.push_back(left);
+    out.reserve(len);
+
+    while (!pending.empty())
+    {
+        const JsString *node = pending.back();
+        pending.pop_back();
+        if (node->left)
+        {
+            pending.push_back(node->right);
+            pending.push_back(node->left);
+        }
+        else
+        {
+            out += node->flat;
+        }
+    }
+
+    flat = std::move(out);
+    const JsString *l = left;
+    const JsString *r = right;
+    left = nullptr;
+    right = nullptr;
+    release_children(l, r);
+}
+
+AnyValue JsString::concat(const AnyValue &lhs, const AnyValue &rhs)
+{
+    const JsString *l = lhs.as_string();
+    const JsString *r = rhs.as_string();
+    if (r->len == 0)
+        return lhs;
+    if (l->len == 0)
+        return rhs;
+
+    size_t total = l->len + r->len;
+    if (total < ROPE_MIN_LENGTH)
+    {
+        std::string out;
+        out.reserve(total);
+        out += l->value();
+        out += r->value();
+        return AnyValue::make_string(std::move(out));
+    }
+    return AnyValue::from_ptr(new JsString(l, r));
+}
+
+// Created on first use and never released: the table's reference keeps every count
+// above zero, so the strings outlive any value that points at them.
+static const std::array<JsString *, 256> &single_byte_strings()
+{
+    static const std::array<JsString *, 256> table = []
+    {
+        std::array<JsString *, 256> strings;
+        for (size_t c = 0; c < strings.size(); ++c)
+        {
+            strings[c] = new JsString(std::string(1, static_cast<char>(c)));
+            strings[c]->ref();
+        }
+        return strings;
+    }();
+    return table;
+}
+
+AnyValue JsString::from_char(unsigned char c)
+{
+    return AnyValue::from_string(single_byte_strings()[c]);
+}
+
+AnyValue JsString::empty()
+{
+    static JsString *const empty_string = []
+    {
+        auto *s = new JsString();
+        s->ref();
+        return s;
+    }();
+    return AnyValue::from_string(empty_string);
+}
+
 std::string JsString::to_std_string() const
 {
-    return value;
+    return value();
 }
 
 AnyValue JsString::get_property(const std::string &key, const AnyValue &thisVal)
@@ -28,9 +162,9 @@ AnyValue JsString::get_property(const std::string &key, const AnyValue &thisVal)
 
 AnyValue JsString::get_property(uint32_t idx)
 {
-    if (idx < value.length())
+    if (idx < len)
     {
-        return AnyValue::make_string(std::string(1, value[idx]));
+        return from_char(static_cast<unsigned char>(value()[idx]));
     }
     return Constants::UNDEFINED;
 }
@@ -42,17 +176,17 @@ namespace StringPrototypes {
 AnyValue &get_toString_fn()
 {
     static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
-                                                 { return AnyValue::make_string(thisVal.as_string()->value); },
+                                                 { return AnyValue::make_string(thisVal.as_string()->value()); },
                                                  "toString");
     return fn;
 }
 
 AnyValue &get_iterator_fn()
 {
-    static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, std::vector<AnyValue> _) -> jspp::JsIterator<jspp::AnyValue>
+    static AnyValue fn = AnyValue::make_generator([](AnyValue thisVal, CoroutineArgs) -> jspp::JsIterator<jspp::AnyValue>
                                                   {
                                                       auto self = thisVal.as_string();
-                                                      const std::string &value = self->value;
+                                                      const std::string &value = self->value();
                                                       for (size_t i = 0; i < value.length();)
                                                       {
                                                           unsigned char c = static_cast<unsigned char>(value[i]);
@@ -69,7 +203,10 @@ AnyValue &get_iterator_fn()
                                                           if (i + len > value.length())
                                                               len = value.length() - i;
 
-                                                          co_yield AnyValue::make_string(value.substr(i, len));
+                                                          if (len == 1)
+                                                              co_yield JsString::from_char(c);
+                                                          else
+                                                              co_yield AnyValue::make_string(value.substr(i, len));
                                                           i += len;
                                                       }
                                                       co_return AnyValue::make_undefined(); },
@@ -80,7 +217,7 @@ AnyValue &get_iterator_fn()
 AnyValue &get_length_desc()
 {
     static auto getter = [](const AnyValue &thisVal, std::span<const AnyValue>) -> AnyValue
-    { return AnyValue::make_number(thisVal.as_string()->value.length()); };
+    { return AnyValue::make_number(thisVal.as_string()->length()); };
     static auto setter = [](const AnyValue &thisVal, std::span<const AnyValue>) -> AnyValue
     { return Constants::UNDEFINED; };
     static AnyValue desc = AnyValue::make_accessor_descriptor(getter, setter, false, false);
@@ -94,11 +231,11 @@ AnyValue &get_charAt_fn()
                                                      auto self = thisVal.as_string();
                                                      double pos = args.empty() ? 0 : Operators_Private::ToNumber(args[0]);
                                                      int index = static_cast<int>(pos);
-                                                     if (index < 0 || index >= self->value.length())
+                                                     if (index < 0 || static_cast<size_t>(index) >= self->length())
                                                      {
-                                                         return AnyValue::make_string("");
+                                                         return JsString::empty();
                                                      }
-                                                     return AnyValue::make_string(std::string(1, self->value[index])); },
+                                                     return JsString::from_char(static_cast<unsigned char>(self->value()[index])); },
                                                  "charAt");
     return fn;
 }
@@ -107,7 +244,7 @@ AnyValue &get_concat_fn()
 {
     static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
                                                  {
-                                                     std::string result = thisVal.as_string()->value;
+                                                     std::string result = thisVal.as_string()->value();
                                                      for (const auto &arg : args)
                                                      {
                                                          result += arg.to_std_string();
@@ -125,14 +262,14 @@ AnyValue &get_endsWith_fn()
                                                      if (args.empty())
                                                          return Constants::FALSE;
                                                      std::string search = args[0].to_std_string();
-                                                     size_t end_pos = (args.size() > 1 && !args[1].is_undefined()) ? static_cast<size_t>(Operators_Private::ToNumber(args[1])) : self->value.length();
+                                                     size_t end_pos = (args.size() > 1 && !args[1].is_undefined()) ? static_cast<size_t>(Operators_Private::ToNumber(args[1])) : self->value().length();
 
-                                                     if (end_pos > self->value.length())
-                                                         end_pos = self->value.length();
+                                                     if (end_pos > self->value().length())
+                                                         end_pos = self->value().length();
                                                      if (search.length() > end_pos)
                                                          return Constants::FALSE;
 
-                                                     return AnyValue::make_boolean(self->value.substr(end_pos - search.length(), search.length()) == search); },
+                                                     return AnyValue::make_boolean(self->value().substr(end_pos - search.length(), search.length()) == search); },
                                                  "endsWith");
     return fn;
 }
@@ -147,7 +284,7 @@ AnyValue &get_includes_fn()
                                                      std::string search = args[0].to_std_string();
                                                      size_t pos = (args.size() > 1) ? static_cast<size_t>(Operators_Private::ToNumber(args[1])) : 0;
 
-                                                     return AnyValue::make_boolean(self->value.find(search, pos) != std::string::npos); },
+                                                     return AnyValue::make_boolean(self->value().find(search, pos) != std::string::npos); },
                                                  "includes");
     return fn;
 }
@@ -161,7 +298,7 @@ AnyValue &get_indexOf_fn()
                                                          return AnyValue::make_number(-1);
                                                      std::string search = args[0].to_std_string();
                                                      size_t pos = (args.size() > 1) ? static_cast<size_t>(Operators_Private::ToNumber(args[1])) : 0;
-                                                     size_t result = self->value.find(search, pos);
+                                                     size_t result = self->value().find(search, pos);
                                                      return result == std::string::npos ? AnyValue::make_number(-1) : AnyValue::make_number(result); },
                                                  "indexOf");
     return fn;
@@ -176,7 +313,7 @@ AnyValue &get_lastIndexOf_fn()
                                                          return AnyValue::make_number(-1);
                                                      std::string search = args[0].to_std_string();
                                                      size_t pos = (args.size() > 1 && !args[1].is_undefined()) ? static_cast<size_t>(Operators_Private::ToNumber(args[1])) : std::string::npos;
-                                                     size_t result = self->value.rfind(search, pos);
+                                                     size_t result = self->value().rfind(search, pos);
                                                      return result == std::string::npos ? AnyValue::make_number(-1) : AnyValue::make_number(result); },
                                                  "lastIndexOf");
     return fn;
@@ -188,10 +325,10 @@ AnyValue &get_padEnd_fn()
                                                  {
                                                      auto self = thisVal.as_string();
                                                      size_t target_length = args.empty() ? 0 : static_cast<size_t>(Operators_Private::ToNumber(args[0]));
-                                                     if (self->value.length() >= target_length)
-                                                         return AnyValue::make_string(self->value);
+                                                     if (self->value().length() >= target_length)
+                                                         return AnyValue::make_string(self->value());
                                                      std::string pad_string = (args.size() > 1 && !args[1].is_undefined() && !args[1].to_std_string().empty()) ? args[1].to_std_string() : " ";
-                                                     std::string result = self->value;
+                                                     std::string result = self->value();
                                                      while (result.length() < target_length)
                                                      {
                                                          result += pad_string;
@@ -207,15 +344,15 @@ AnyValue &get_padStart_fn()
                                                  {
                                                      auto self = thisVal.as_string();
                                                      size_t target_length = args.empty() ? 0 : static_cast<size_t>(Operators_Private::ToNumber(args[0]));
-                                                     if (self->value.length() >= target_length)
-                                                         return AnyValue::make_string(self->value);
+                                                     if (self->value().length() >= target_length)
+                                                         return AnyValue::make_string(self->value());
                                                      std::string pad_string = (args.size() > 1 && !args[1].is_undefined() && !args[1].to_std_string().empty()) ? args[1].to_std_string() : " ";
                                                      std::string padding;
-                                                     while (padding.length() < target_length - self->value.length())
+                                                     while (padding.length() < target_length - self->value().length())
                                                      {
                                                          padding += pad_string;
                                                      }
-                                                     return AnyValue::make_string(padding.substr(0, target_length - self->value.length()) + self->value); },
+                                                     return AnyValue::make_string(padding.substr(0, target_length - self->value().length()) + self->value()); },
                                                  "padStart");
     return fn;
 }
@@ -234,7 +371,7 @@ AnyValue &get_repeat_fn()
                                                      std::string result = "";
                                                      for (int i = 0; i < count; ++i)
                                                      {
-                                                         result += self->value;
+                                                         result += self->value();
                                                      }
                                                      return AnyValue::make_string(result); },
                                                  "repeat");
@@ -247,10 +384,10 @@ AnyValue &get_replace_fn()
                                                  {
                                                      auto self = thisVal.as_string();
                                                      if (args.size() < 2)
-                                                         return AnyValue::make_string(self->value);
+                                                         return AnyValue::make_string(self->value());
                                                      std::string search = args[0].to_std_string();
                                                      std::string replacement = args[1].to_std_string();
-                                                     std::string result = self->value;
+                                                     std::string result = self->value();
                                                      size_t pos = result.find(search);
                                                      if (pos != std::string::npos)
                                                      {
@@ -267,12 +404,12 @@ AnyValue &get_replaceAll_fn()
                                                  {
                                                      auto self = thisVal.as_string();
                                                      if (args.size() < 2)
-                                                         return AnyValue::make_string(self->value);
+                                                         return AnyValue::make_string(self->value());
                                                      std::string search = args[0].to_std_string();
                                                      if (search.empty())
-                                                         return AnyValue::make_string(self->value);
+                                                         return AnyValue::make_string(self->value());
                                                      std::string replacement = args[1].to_std_string();
-                                                     std::string result = self->value;
+                                                     std::string result = self->value();
                                                      size_t pos = result.find(search);
                                                      while (pos != std::string::npos)
                                                      {
@@ -289,7 +426,7 @@ AnyValue &get_slice_fn()
     static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
                                                  {
                                                      auto self = thisVal.as_string();
-                                                     int len = self->value.length();
+                                                     int len = self->value().length();
                                                      int start = args.empty() ? 0 : Operators_Private::ToInt32(args[0]);
                                                      int end = (args.size() < 2 || args[1].is_undefined()) ? len : Operators_Private::ToInt32(args[1]);
 
@@ -303,7 +440,7 @@ AnyValue &get_slice_fn()
 
                                                      if (start >= end)
                                                          return AnyValue::make_string("");
-                                                     return AnyValue::make_string(self->value.substr(start, end - start)); },
+                                                     return AnyValue::make_string(self->value().substr(start, end - start)); },
                                                  "slice");
     return fn;
 }
@@ -318,14 +455,14 @@ AnyValue &get_split_fn()
 
                                                      if (separator.empty())
                                                      {
-                                                         for (char c : (self->value))
+                                                         for (char c : (self->value()))
                                                          {
-                                                             result_vec.push_back(AnyValue::make_string(std::string(1, c)));
+                                                             result_vec.push_back(JsString::from_char(static_cast<unsigned char>(c)));
                                                          }
                                                      }
                                                      else
                                                      {
-                                                         std::string temp = (self->value);
+                                                         std::string temp = (self->value());
                                                          size_t pos = 0;
                                                          while ((pos = temp.find(separator)) != std::string::npos)
                                                          {
@@ -348,10 +485,10 @@ AnyValue &get_startsWith_fn()
                                                          return Constants::FALSE;
                                                      std::string search = args[0].to_std_string();
                                                      size_t pos = (args.size() > 1) ? static_cast<size_t>(Operators_Private::ToNumber(args[1])) : 0;
-                                                     if (pos > self->value.length())
-                                                         pos = self->value.length();
+                                                     if (pos > self->value().length())
+                                                         pos = self->value().length();
 
-                                                     return AnyValue::make_boolean(self->value.rfind(search, pos) == pos); },
+                                                     return AnyValue::make_boolean(self->value().rfind(search, pos) == pos); },
                                                  "startsWith");
     return fn;
 }
@@ -361,7 +498,7 @@ AnyValue &get_substring_fn()
     static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
                                                  {
                                                      auto self = thisVal.as_string();
-                                                     int len = self->value.length();
+                                                     int len = self->value().length();
                                                      int start = args.empty() ? 0 : Operators_Private::ToInt32(args[0]);
                                                      int end = (args.size() < 2 || args[1].is_undefined()) ? len : Operators_Private::ToInt32(args[1]);
 
@@ -374,7 +511,7 @@ AnyValue &get_substring_fn()
                                                      start = std::min(len, start);
                                                      end = std::min(len, end);
 
-                                                     return AnyValue::make_string(self->value.substr(start, end - start)); },
+                                                     return AnyValue::make_string(self->value().substr(start, end - start)); },
                                                  "substring");
     return fn;
 }
@@ -383,7 +520,7 @@ AnyValue &get_toLowerCase_fn()
 {
     static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
                                                  {
-                                                     std::string result = thisVal.as_string()->value;
+                                                     std::string result = thisVal.as_string()->value();
                                                      std::transform(result.begin(), result.end(), result.begin(),
                                                                     [](unsigned char c)
                                                                     { return std::tolower(c); });
@@ -396,7 +533,7 @@ AnyValue &get_toUpperCase_fn()
 {
     static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
                                                  {
-                                                     std::string result = thisVal.as_string()->value;
+                                                     std::string result = thisVal.as_string()->value();
                                                      std::transform(result.begin(), result.end(), result.begin(),
                                                                     [](unsigned char c)
                                                                     { return std::toupper(c); });
@@ -410,7 +547,7 @@ AnyValue &get_trim_fn()
     static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
                                                  {
                                                      const char *whitespace = " \t\n\r\f\v";
-                                                     std::string result = thisVal.as_string()->value;
+                                                     std::string result = thisVal.as_string()->value();
                                                      result.erase(0, result.find_first_not_of(whitespace));
                                                      result.erase(result.find_last_not_of(whitespace) + 1);
                                                      return AnyValue::make_string(result); },
@@ -423,7 +560,7 @@ AnyValue &get_trimEnd_fn()
     static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
                                                  {
                                                      const char *whitespace = " \t\n\r\f\v";
-                                                     std::string result = thisVal.as_string()->value;
+                                                     std::string result = thisVal.as_string()->value();
                                                      result.erase(result.find_last_not_of(whitespace) + 1);
                                                      return AnyValue::make_string(result); },
                                                  "trimEnd");
@@ -435,7 +572,7 @@ AnyValue &get_trimStart_fn()
     static AnyValue fn = AnyValue::make_function([](const AnyValue &thisVal, std::span<const AnyValue> args) -> AnyValue
                                                  {
                                                      const char *whitespace = " \t\n\r\f\v";
-                                                     std::string result = thisVal.as_string()->value;
+                                                     std::string result = thisVal.as_string()->value();
                                                      result.erase(0, result.find_first_not_of(whitespace));
                                                      return AnyValue::make_string(result); },
                                                  "trimStart");
@@ -444,35 +581,40 @@ AnyValue &get_trimStart_fn()
 
 std::optional<AnyValue> get(const std::string &key)
 {
-    if (key == "toString" || key == "valueOf") return get_toString_fn();
-    if (key == "length") return get_length_desc();
-    if (key == "charAt") return get_charAt_fn();
-    if (key == "concat") return get_concat_fn();
-    if (key == "endsWith") return get_endsWith_fn();
-    if (key == "includes") return get_includes_fn();
-    if (key == "indexOf") return get_indexOf_fn();
-    if (key == "lastIndexOf") return get_lastIndexOf_fn();
-    if (key == "padEnd") return get_padEnd_fn();
-    if (key == "padStart") return get_padStart_fn();
-    if (key == "repeat") return get_repeat_fn();
-    if (key == "replace") return get_replace_fn();
-    if (key == "replaceAll") return get_replaceAll_fn();
-    if (key == "slice") return get_slice_fn();
-    if (key == "split") return get_split_fn();
-    if (key == "startsWith") return get_startsWith_fn();
-    if (key == "substring") return get_substring_fn();
-    if (key == "toLowerCase") return get_toLowerCase_fn();
-    if (key == "toUpperCase") return get_toUpperCase_fn();
-    if (key == "trim") return get_trim_fn();
-    if (key == "trimEnd") return get_trimEnd_fn();
-    if (key == "trimStart") return get_trimStart_fn();
+    static constexpr PrototypeTable table(std::to_array<PrototypeEntry>({
+        PrototypeEntry{"toString", &get_toString_fn},
+        PrototypeEntry{"valueOf", &get_toString_fn},
+        PrototypeEntry{"length", &get_length_desc},
+        PrototypeEntry{"charAt", &get_charAt_fn},
+        PrototypeEntry{"concat", &get_concat_fn},
+        PrototypeEntry{"endsWith", &get_endsWith_fn},
+        PrototypeEntry{"includes", &get_includes_fn},
+        PrototypeEntry{"indexOf", &get_indexOf_fn},
+        PrototypeEntry{"lastIndexOf", &get_lastIndexOf_fn},
+        PrototypeEntry{"padEnd", &get_padEnd_fn},
+        PrototypeEntry{"padStart", &get_padStart_fn},
+        PrototypeEntry{"repeat", &get_repeat_fn},
+        PrototypeEntry{"replace", &get_replace_fn},
+        PrototypeEntry{"replaceAll", &get_replaceAll_fn},
+        PrototypeEntry{"slice", &get_slice_fn},
+        PrototypeEntry{"split", &get_split_fn},
+        PrototypeEntry{"startsWith", &get_startsWith_fn},
+        PrototypeEntry{"substring", &get_substring_fn},
+        PrototypeEntry{"toLowerCase", &get_toLowerCase_fn},
+        PrototypeEntry{"toUpperCase", &get_toUpperCase_fn},
+        PrototypeEntry{"trim", &get_trim_fn},
+        PrototypeEntry{"trimEnd", &get_trimEnd_fn},
+        PrototypeEntry{"trimStart", &get_trimStart_fn},
+    }));
+    if (auto fn = table.find(key))
+        return *fn;
     return std::nullopt;
 }
 
 std::optional<AnyValue> get(const AnyValue &key)
 {
     if (key.is_string())
-        return get(key.as_string()->value);
+        return get(key.as_string()->value());
 
     if (key == AnyValue::from_symbol(WellKnownSymbols::toStringTag)) return get_toString_fn();
     if (key == AnyValue::from_symbol(WellKnownSymbols::iterator)) return get_iterator_fn();
@@ -9,18 +9,66 @@ namespace jspp
     // Forward declaration of AnyValue
     class AnyValue;
 
+    // A string is either flat, holding its characters, or a rope: a concatenation node
+    // that references its two halves and builds the characters on first use. Repeated
+    // `s += chunk` therefore allocates one node per step instead of copying `s` each
+    // time, and the copy happens once when the result is finally read.
     struct JsString : HeapObject
     {
-        std::string value;
+        // Shorter concatenations are copied straight away; a node would cost as much
+        static constexpr size_t ROPE_MIN_LENGTH = 64;
 
-        JsString() = default;
-        explicit JsString(const std::string &s) : value(s) {}
+        mutable size_t hash_cache = 0; // 0 until first requested; string values never change
 
-        JsType get_heap_type() const override { return JsType::String; }
+        JsString() : HeapObject(JsType::String) {}
+        explicit JsString(const std::string &s) : HeapObject(JsType::String), flat(s), len(flat.size()) {}
+        explicit JsString(std::string &&s) noexcept : HeapObject(JsType::String), flat(std::move(s)), len(flat.size()) {}
+        // Rope node over `l` followed by `r`; takes a reference to both
+        JsString(const JsString *l, const JsString *r) noexcept;
+        ~JsString() override;
+
+        // The characters, flattening a rope in place first
+        const std::string &value() const
+        {
+            if (left)
+                flatten();
+            return flat;
+        }
+
+        // Length in bytes, known without flattening
+        size_t length() const noexcept { return len; }
+        bool is_rope() const noexcept { return left != nullptr; }
+
+        // Flattens a rope first, so this can allocate (and throw)
+        size_t hash() const
+        {
+            if (hash_cache == 0)
+                hash_cache = std::hash<std::string>{}(value()) | 1;
+            return hash_cache;
+        }
+
+        // `lhs + rhs` for two string values
+        static AnyValue concat(const AnyValue &lhs, const AnyValue &rhs);
+
+        // Shared immortal strings for each single byte and for "", so indexing, charAt,
+        // iteration and split("") hand out an existing string instead of allocating.
+        // Short values need no cache: std::string keeps them inside this object.
+        static AnyValue from_char(unsigned char c);
+        static AnyValue empty();
 
         std::string to_std_string() const;
 
         AnyValue get_property(const std::string &key, const AnyValue &thisVal);
         AnyValue get_property(uint32_t idx);
+
+    private:
+        mutable std::string flat;
+        // Both set for a rope, both null once flat
+        mutable const JsString *left = nullptr;
+        mutable const JsString *right = nullptr;
+        size_t len = 0;
+
+        void flatten() const;
+        static void release_children(const JsString *l, const JsString *r);
     };
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 #include "jspp.hpp"
 #include "values/symbol.hpp"
 #include "values/prototypes/symbol.hpp"
+#include "utils/prototype_table.hpp"
 
 namespace jspp {
 
@@ -66,16 +67,20 @@ AnyValue &get_description_desc()
 
 std::optional<AnyValue> get(const std::string &key)
 {
-    if (key == "toString") return get_toString_fn();
-    if (key == "valueOf") return get_valueOf_fn();
-    if (key == "description") return get_description_desc();
+    static constexpr PrototypeTable table(std::to_array<PrototypeEntry>({
+        PrototypeEntry{"toString", &get_toString_fn},
+        PrototypeEntry{"valueOf", &get_valueOf_fn},
+        PrototypeEntry{"description", &get_description_desc},
+    }));
+    if (auto fn = table.find(key))
+        return *fn;
     return std::nullopt;
 }
 
 std::optional<AnyValue> get(const AnyValue &key)
 {
     if (key.is_string())
-        return get(key.as_string()->value);
+        return get(key.as_string()->value());
 
     if (key == AnyValue::from_symbol(WellKnownSymbols::toStringTag)) return get_toString_fn();
     if (key == "valueOf") return get_valueOf_fn();
@@ -17,8 +17,6 @@ namespace jspp
         std::string description;
         std::string key; // Internal unique key used for AnyValue property maps
 
-        JsType get_heap_type() const override { return JsType::Symbol; }
-
         // --- Registries ---
 
         // 1. Global Symbol Registry (for Symbol.for/keyFor)
@@ -43,7 +41,7 @@ namespace jspp
         // --- Constructors ---
 
         // Standard Constructor (creates unique symbol)
-        JsSymbol(const std::string &desc) : description(desc)
+        JsSymbol(const std::string &desc) : HeapObject(JsType::Symbol), description(desc)
         {
             static std::atomic<uint64_t> id_counter{0};
             // Ensure unique internal key for property storage
@@ -55,7 +53,7 @@ namespace jspp
 
         // Constructor for Well-Known Symbols (fixed keys)
         JsSymbol(const std::string &desc, const std::string &fixed_key)
-            : description(desc), key(fixed_key)
+            : HeapObject(JsType::Symbol), description(desc), key(fixed_key)
         {
             // Register this key as a valid symbol key
             internal_keys_registry().insert(key);
@@ -0,0 +1,32 @@
+// Number-only arrays take the unboxed fast paths
+const nums = [];
+for (let i = 0; i < 10; i++) {
+    nums.push(i * 1.5);
+}
+console.log("indexOf:", nums.indexOf(4.5), nums.indexOf(100), nums.indexOf("3"));
+console.log("includes:", nums.includes(13.5), [1, NaN].includes(NaN), [NaN].indexOf(NaN));
+console.log("lastIndexOf:", [1, 2, 1, 2].lastIndexOf(1));
+
+// Copying and rearranging keep the element kind
+const copy = nums.slice(2, 5);
+console.log("slice:", copy);
+console.log("reverse:", copy.reverse());
+console.log("fill:", [1, 2, 3, 4].fill(0, 1, 3));
+console.log("concat:", copy.concat([1], "x"));
+
+// Storing a non-number keeps the array packed but generic
+const mixed = [1, 2, 3];
+mixed[1] = "two";
+console.log("mixed:", mixed.indexOf("two"), mixed.includes(3), mixed);
+
+// Holes must survive the fast paths
+const holey = [1, 2, 3];
+holey[5] = 6;
+console.log("holey:", holey.indexOf(undefined), holey.includes(undefined), holey.slice(2).length, 3 in holey.slice(2));
+delete nums[0];
+console.log("deleted:", nums.indexOf(0), 0 in nums, nums.length);
+
+// Removing elements shifts the rest down
+const queue = [1, 2, 3, 4, 5];
+queue.splice(1, 2);
+console.log("splice:", queue, queue.shift(), queue, queue.length);
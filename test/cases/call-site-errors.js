@@ -0,0 +1,18 @@
+console.log("--- Call Site Errors ---");
+
+function report(fn) {
+  try {
+    fn();
+  } catch (e) {
+    console.log(e.name + ": " + e.message);
+  }
+}
+
+const notFn = 42;
+report(() => notFn());
+report(() => new notFn());
+report(() => {
+  for (const x of notFn) {
+    console.log(x);
+  }
+});
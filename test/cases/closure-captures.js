@@ -0,0 +1,86 @@
+// Captured variables live in a shared environment record: every closure sees the same binding
+function makeCounter() {
+    let count = 0;
+    return {
+        inc: () => ++count,
+        get: () => count,
+    };
+}
+const counter = makeCounter();
+counter.inc();
+counter.inc();
+console.log(counter.get());
+
+// Each loop iteration gets its own `let` binding
+const fns = [];
+for (let i = 0; i < 3; i++) {
+    fns.push(() => i * 10);
+}
+console.log(fns.map((f) => f()).join(","));
+
+// Closures created inside a loop keep capturing outer state
+let total = 0;
+for (let round = 0; round < 3; round++) {
+    const scale = round + 1;
+    total += [1, 2, 3].map((x) => x * scale).reduce((a, b) => a + b, 0);
+}
+console.log(total);
+
+// A closure that outlives its frame and is reassigned through
+function makeAccumulator(start) {
+    let value = start;
+    function add(n) {
+        value += n;
+        return add;
+    }
+    add.read = () => value;
+    return add;
+}
+const acc = makeAccumulator(5);
+acc(1)(2)(3);
+console.log(acc.read());
+
+// for...of and for...in bindings are fresh on every iteration
+const ofFns = [];
+for (const v of ["a", "b", "c"]) {
+    ofFns.push(() => v);
+}
+console.log("for-of:", ofFns.map((f) => f()).join(""));
+const inFns = [];
+for (const k in { x: 1, y: 2 }) {
+    inFns.push(() => k);
+}
+console.log("for-in:", inFns.map((f) => f()).join(""));
+
+// Captured parameters and catch bindings
+function adder(base) {
+    return (n) => base + n;
+}
+console.log("param:", adder(40)(2));
+try {
+    throw new Error("boom");
+} catch (e) {
+    const show = () => e.message;
+    console.log("catch:", show());
+}
+
+// A named function expression refers to itself by its own name
+const fact = function f(n) {
+    return n <= 1 ? 1 : n * f(n - 1);
+};
+console.log("named:", fact(5));
+
+// Several bindings of one scope are shared by every closure over it
+function pair() {
+    let a = 1;
+    let b = 2;
+    const swap = () => {
+        const t = a;
+        a = b;
+        b = t;
+    };
+    const read = () => a + "," + b;
+    swap();
+    return read();
+}
+console.log("pair:", pair());
@@ -0,0 +1,39 @@
+// Generators and async functions keep their own copy of the arguments
+function* pairs(a, b = "b-default", ...rest) {
+    yield a;
+    yield b;
+    yield rest;
+}
+console.log([...pairs()]);
+console.log([...pairs(1)]);
+console.log([...pairs(1, 2, 3, 4, 5, 6, 7)]);
+
+// Arguments are read after the caller's values have gone out of scope
+function makeLazy() {
+    const items = ["x", "y", "z"];
+    return pairs(...items);
+}
+const lazy = makeLazy();
+console.log(lazy.next().value, lazy.next().value, lazy.next().value);
+
+async function sum(first, ...others) {
+    await null;
+    return others.reduce((acc, v) => acc + v, first);
+}
+
+async function main() {
+    console.log(await sum(1));
+    console.log(await sum(1, 2, 3, 4, 5, 6, 7, 8));
+    const results = [];
+    for (let i = 0; i < 1000; i++) results.push(sum(i, i));
+    const all = await Promise.all(results);
+    console.log(all.length, all[999]);
+
+    async function* countdown(from, step = 1) {
+        for (let i = from; i > 0; i -= step) yield i;
+    }
+    const seen = [];
+    for await (const v of countdown(6, 2)) seen.push(v);
+    console.log(seen);
+}
+main();
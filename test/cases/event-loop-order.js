@@ -0,0 +1,22 @@
+// Microtasks run before the next timer callback
+setTimeout(() => {
+    console.log("timer A");
+    Promise.resolve().then(() => console.log("microtask from A"));
+}, 10);
+setTimeout(() => {
+    console.log("timer B");
+}, 10);
+
+// Cleared timers never run, including ones cleared by an earlier callback
+const doomed = setTimeout(() => console.log("doomed"), 20);
+setTimeout(() => clearTimeout(doomed), 5);
+
+let ticks = 0;
+const interval = setInterval(() => {
+    ticks++;
+    console.log("interval", ticks);
+    if (ticks === 3) clearInterval(interval);
+}, 30);
+
+Promise.resolve().then(() => console.log("first microtask"));
+console.log("sync");
@@ -0,0 +1,80 @@
+// Arrays
+const nums = [1, 2, 3, 4];
+let sum = 0;
+for (const n of nums) sum += n;
+console.log("sum:", sum);
+
+// Holes read as undefined
+const holey = [1, , 3];
+for (const v of holey) console.log("holey:", v);
+
+// Growing and shrinking the array while iterating
+const grow = [1, 2];
+for (const v of grow) {
+    if (grow.length < 5) grow.push(v * 10);
+    console.log("grow:", v);
+}
+const shrink = [1, 2, 3, 4, 5];
+for (const v of shrink) {
+    shrink.pop();
+    console.log("shrink:", v);
+}
+
+// Strings, including multi-byte characters
+for (const ch of "añ€😀b") console.log("char:", ch);
+let empty = 0;
+for (const ch of "") empty++;
+console.log("empty:", empty);
+
+// continue, break and labels
+for (const v of [1, 2, 3, 4, 5, 6]) {
+    if (v % 2 === 0) continue;
+    if (v > 4) break;
+    console.log("odd:", v);
+}
+outer: for (const a of [1, 2, 3]) {
+    for (const b of "xyz") {
+        if (b === "y") continue outer;
+        if (a === 3) break outer;
+        console.log("pair:", a, b);
+    }
+}
+
+// Assigning to an existing binding, and closures capturing the element
+let last;
+for (last of ["p", "q"]);
+console.log("last:", last);
+const fns = [];
+for (const v of [7, 8]) fns.push(() => v);
+console.log("captured:", fns[0](), fns[1]());
+
+// A replaced iterator is honoured
+const custom = [1, 2, 3];
+custom[Symbol.iterator] = function* () {
+    yield "custom";
+};
+for (const v of custom) console.log("patched:", v);
+
+// Other iterables still use the protocol
+for (const [k, v] of new Map([["a", 1]])) console.log("map:", k, v);
+function* gen() {
+    yield 1;
+    yield 2;
+}
+for (const v of gen()) {
+    if (v === 1) continue;
+    console.log("gen:", v);
+}
+const iterable = {
+    [Symbol.iterator]() {
+        let i = 0;
+        return { next: () => ({ value: i, done: i++ >= 2 }) };
+    },
+};
+for (const v of iterable) console.log("object:", v);
+
+try {
+    for (const v of 5) console.log(v);
+} catch (e) {
+    console.log(e instanceof TypeError);
+}
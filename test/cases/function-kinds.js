@@ -0,0 +1,37 @@
+// Plain, generator, async and class bodies behind the same function value
+function add(a, b, c) {
+    return [a, b, c, arguments.length];
+}
+console.log(add(1));
+console.log(add(1, 2, 3, 4));
+
+function* pairs(...items) {
+    for (let i = 0; i + 1 < items.length; i += 2) yield [items[i], items[i + 1]];
+}
+for (const [k, v] of pairs("a", 1, "b", 2, "c")) console.log(k, v);
+
+async function double(x) {
+    return x * 2;
+}
+double(21).then((v) => console.log("async", v));
+
+class Point {
+    constructor(x, y) {
+        this.x = x;
+        this.y = y;
+    }
+}
+const p = new Point(3, 4);
+console.log(p.x + p.y);
+
+// A closure capturing more state than fits inline
+const a1 = 1, a2 = 2, a3 = 3, a4 = 4, a5 = 5, a6 = 6, a7 = 7, a8 = 8;
+const wide = () => a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8;
+console.log(wide());
+
+// Built-in callbacks receive (value, index, array) whatever the callee declares
+console.log([10, 20, 30].map((v, i, arr) => v + i + arr.length));
+console.log([10, 20, 30].map(function () { return arguments.length; }));
+console.log([1, 2, 3, 4].reduce((acc, v) => acc + v, 0));
+console.log([5, 1, 4].sort((x, y) => x - y));
+console.log([1, 2, 3].filter((v) => v !== 2), [1, 2, 3].some((v) => v > 2));
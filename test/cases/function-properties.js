@@ -0,0 +1,32 @@
+// Property storage on functions is only created once something is stored there
+function Counter() {
+    this.count = 0;
+}
+Counter.prototype.increment = function () {
+    this.count++;
+    return this.count;
+};
+const c = new Counter();
+c.increment();
+console.log(c.increment());
+console.log(Counter.prototype.constructor === Counter, c instanceof Counter);
+
+const tagged = () => 1;
+console.log(Object.keys(tagged).length);
+tagged.label = "first";
+tagged.calls = 3;
+console.log(tagged.label, tagged.calls);
+console.log(Object.keys(tagged));
+console.log(Object.hasOwn(tagged, "label"), Object.hasOwn(tagged, "missing"));
+delete tagged.label;
+console.log(tagged.label, Object.keys(tagged));
+
+// Closures created in a loop keep separate properties
+const makers = [];
+for (let i = 0; i < 3; i++) {
+    const f = () => i;
+    if (i === 1) f.marked = true;
+    makers.push(f);
+}
+console.log(makers.map((f) => f.marked === true));
+console.log(makers.map((f) => f()));
@@ -0,0 +1,37 @@
+console.log("--- Function Reassignment ---");
+
+function greet() {
+  return "hello";
+}
+
+const results = [];
+for (let i = 0; i < 3; i++) {
+  results.push(greet());
+  greet = function () {
+    return "bye";
+  };
+}
+console.log("Loop:", results.join(","));
+
+console.log("Hoisted:", square(4));
+function square(n) {
+  return n * n;
+}
+
+function counter() {
+  return 1;
+}
+function swap() {
+  counter = () => 2;
+}
+console.log("Before swap:", counter());
+swap();
+console.log("After swap:", counter());
+
+let handler = () => "first";
+const seen = [];
+for (let i = 0; i < 2; i++) {
+  seen.push(handler());
+  handler = () => "second";
+}
+console.log("Arrow:", seen.join(","));
@@ -0,0 +1,63 @@
+console.log("--- Inline Caches ---");
+
+class Point {
+  constructor(x, y) {
+    this.x = x;
+    this.y = y;
+  }
+  sum() {
+    return this.x + this.y;
+  }
+}
+
+class Point3 extends Point {
+  constructor(x, y, z) {
+    super(x, y);
+    this.z = z;
+  }
+  sum() {
+    return this.x + this.y + this.z;
+  }
+}
+
+let total = 0;
+for (let i = 0; i < 100; i++) {
+  const p = i % 2 === 0 ? new Point(i, 1) : new Point3(i, 1, 2);
+  total += p.sum();
+}
+console.log("Polymorphic:", total);
+
+function readName(o) {
+  return o.name;
+}
+const shapes = [{ name: "a" }, { id: 1, name: "b" }, { x: 0, y: 0, name: "c" }];
+let names = "";
+for (let i = 0; i < 9; i++) {
+  names += readName(shapes[i % 3]);
+}
+console.log("Shapes:", names);
+
+const proto = { greet() { return "hi"; } };
+const child = Object.create(proto);
+const seen = [];
+for (let i = 0; i < 3; i++) {
+  seen.push(child.greet());
+  proto.greet = function () { return "hey"; };
+}
+console.log("Proto update:", seen.join(","));
+
+const shadow = Object.create(proto);
+const calls = [];
+for (let i = 0; i < 2; i++) {
+  calls.push(shadow.greet());
+  shadow.greet = function () { return "own"; };
+}
+console.log("Shadowed:", calls.join(","));
+
+const counter = { n: 0 };
+for (let i = 0; i < 5; i++) {
+  counter.n = counter.n + i;
+}
+delete counter.n;
+counter.n = "reset";
+console.log("Counter:", counter.n);
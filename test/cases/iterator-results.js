@@ -0,0 +1,59 @@
+function* count(n) {
+    for (let i = 0; i < n; i++) yield i;
+    return "finished";
+}
+
+// Consumers that never see the result objects
+let total = 0;
+for (const v of count(4)) total += v;
+console.log("for-of:", total);
+console.log("spread:", [...count(3)]);
+console.log("Array.from:", Array.from(count(3), (v) => v * 2));
+console.log("Set:", new Set(count(3)).size);
+const [first, , third, missing = "default", ...others] = count(6);
+console.log("destructuring:", first, third, missing, others);
+const [[x, y], { length }] = [[1, 2], "abc"];
+console.log("nested:", x, y, length);
+
+function* delegate() {
+    yield "start";
+    yield* count(2);
+    yield* ["a", "b"];
+    yield "end";
+}
+console.log("yield*:", [...delegate()]);
+
+// Code that observes the results still gets real objects
+const gen = count(2);
+const step = gen.next();
+console.log(step, Object.keys(step), step.value, step.done);
+console.log(gen.next(), gen.next(), gen.next());
+const early = count(5);
+early.next();
+console.log(early.return(42), early.next());
+
+// Destructuring closes an unfinished iterator, but not a finished one
+function makeIterable(size) {
+    return {
+        [Symbol.iterator]() {
+            let i = 0;
+            return {
+                next: () => ({ value: i, done: i++ >= size }),
+                return: () => {
+                    console.log("return called");
+                    return { done: true };
+                },
+            };
+        },
+    };
+}
+const [a1] = makeIterable(3);
+console.log("closed early:", a1);
+const [b1, b2, b3] = makeIterable(1);
+console.log("ran out:", b1, b2, b3);
+
+// A generator whose next() is replaced is still called through the protocol
+const patched = count(3);
+patched.next = () => ({ value: "patched", done: patched.calls++ > 0 });
+patched.calls = 0;
+console.log("patched:", [...patched]);
@@ -0,0 +1,71 @@
+// JSON.parse builds plain objects and arrays; duplicate keys keep the last value
+const data = JSON.parse('{"id": 7, "tags": ["a", "b"], "nested": {"ok": true, "none": null}, "id": 8}');
+console.log(data.id, data.tags.length, data.tags[1], data.nested.ok, data.nested.none);
+console.log(Object.keys(data).join(","));
+
+// Escapes and numbers
+const text = JSON.parse('"tab\\there \\"quoted\\" \\u00e9 \\ud83d\\ude00"');
+console.log(text);
+console.log(JSON.stringify(JSON.parse("[-0.5e-3, 1e21, 12345678901234567890, 0, -0]")));
+
+// Records with the same keys
+const rows = JSON.parse('[{"x": 1, "y": 2}, {"x": 3, "y": 4}, {"y": 5, "x": 6}]');
+console.log(rows.map((r) => r.x + r.y).join(","), Object.keys(rows[2]).join(","));
+
+// Reviver runs bottom-up and can drop properties
+const revived = JSON.parse('{"a": 1, "b": {"c": 2, "secret": 3}}', function (key, value) {
+    if (key === "secret") return undefined;
+    return typeof value === "number" ? value * 100 : value;
+});
+console.log(JSON.stringify(revived));
+
+// Syntax errors
+for (const bad of ['{"a": 1,}', "[1 2]", "tru", '"open', "01", ""]) {
+    try {
+        JSON.parse(bad);
+        console.log("parsed", bad);
+    } catch (e) {
+        console.log(e.name);
+    }
+}
+
+// Nesting deeper than the limit is a RangeError both ways
+try {
+    JSON.parse("[".repeat(200000) + "]".repeat(200000));
+} catch (e) {
+    console.log(e.name);
+}
+let deep = [];
+for (let i = 0; i < 200000; i++) deep = [deep];
+try {
+    JSON.stringify(deep);
+} catch (e) {
+    console.log(e.name);
+}
+
+// stringify: numbers, strings, skipped values
+console.log(JSON.stringify({ n: 0.1 + 0.2, big: 1e21, small: 1e-7, neg: -0, inf: Infinity }));
+console.log(JSON.stringify("line\nbreak \"q\" \u0001"));
+console.log(JSON.stringify({ f() {}, u: undefined, keep: 1 }), JSON.stringify([undefined, () => 1]));
+console.log(JSON.stringify(undefined), JSON.stringify(null), JSON.stringify(true));
+
+// toJSON, replacer function, replacer array and indentation
+const withToJSON = { when: { toJSON(key) { return "at:" + key; } } };
+console.log(JSON.stringify(withToJSON));
+console.log(JSON.stringify({ a: 1, b: "two", c: [3] }, (key, value) => (typeof value === "number" ? value * 2 : value)));
+console.log(JSON.stringify({ a: 1, b: 2, c: { a: 3, d: 4 } }, ["a", "c"]));
+console.log(JSON.stringify({ a: [1, { b: 2 }], e: {}, f: [] }, null, 2));
+console.log(JSON.stringify([1, [2]], null, "--"));
+
+// Cycles are rejected
+const cyclic = { name: "loop" };
+cyclic.self = cyclic;
+try {
+    JSON.stringify(cyclic);
+} catch (e) {
+    console.log(e.name);
+}
+
+// Round trip
+const doc = { list: [1, 2.5, "x", false, null], map: { "key with space": "v" } };
+console.log(JSON.stringify(JSON.parse(JSON.stringify(doc))) === JSON.stringify(doc));
@@ -0,0 +1,78 @@
+// Map: SameValueZero keys, insertion order, overwrite keeps position
+const m = new Map([["a", 1], [2, "two"]]);
+m.set(NaN, "nan").set(-0, "zero").set("a", 10);
+console.log(m.size, m.get("a"), m.get(NaN), m.get(0), m.get("2"), m.has(2));
+console.log([...m.keys()].join(","));
+
+// Objects are keys by identity
+const k1 = {};
+const k2 = {};
+m.set(k1, "first");
+console.log(m.get(k1), m.get(k2), m.delete(k1), m.delete(k1), m.size);
+
+// Entries added during iteration are visited, deleted ones are skipped
+const seen = [];
+for (const [key, value] of m) {
+    seen.push(String(key));
+    if (key === "a") {
+        m.delete(2);
+        m.set("late", 1);
+    }
+}
+console.log(seen.join(","));
+
+let sum = 0;
+m.forEach(function (value, key, map) {
+    if (typeof value === "number") sum += value;
+    if (map !== m) throw new Error("wrong map");
+});
+console.log("sum", sum);
+m.clear();
+console.log("cleared", m.size, m.get("a"));
+
+// Set
+const s = new Set([3, 1, 3, 2, 1]);
+s.add(4).add(1);
+console.log(s.size, [...s].join(","), s.has(4), s.has("4"));
+console.log([...s.entries()].map(([a, b]) => a + ":" + b).join(","));
+s.delete(3);
+console.log(Array.from(s).join(","));
+
+// Churn through many keys
+const big = new Map();
+for (let i = 0; i < 20000; i++) big.set("k" + (i % 1000), i);
+for (let i = 0; i < 990; i++) big.delete("k" + i);
+console.log(big.size, [...big.values()].slice(0, 3).join(","));
+
+console.log(m instanceof Map, s instanceof Set, typeof m, String(m));
+try {
+    Map.prototype.get.call({}, 1);
+} catch (e) {
+    console.log("incompatible receiver rejected");
+}
+
+// A NaN computed at runtime finds the entry keyed by the NaN literal
+let zero = 0;
+const nanMap = new Map([[NaN, 1]]);
+console.log(nanMap.get(zero / zero), nanMap.has(zero / zero), new Set([zero / zero, NaN]).size);
+
+// A replaced Symbol.iterator on a source array is honoured, as in for...of
+const patchedSource = [1, 2, 3];
+patchedSource[Symbol.iterator] = function* () {
+    yield "only";
+};
+console.log("patched source:", [...new Set(patchedSource)].join(","));
+
+// Patching Map.prototype / Set.prototype reaches every instance
+const originalGet = Map.prototype.get;
+const originalHas = Set.prototype.has;
+Map.prototype.get = function (key) {
+    return "patched:" + originalGet.call(this, key);
+};
+Set.prototype.has = function (value) {
+    return "patched:" + originalHas.call(this, value);
+};
+console.log(new Map([["k", 1]]).get("k"), new Set([1]).has(1), new Set([1]).has(2));
+Map.prototype.get = originalGet;
+Set.prototype.has = originalHas;
+console.log("restored:", new Map([["k", 1]]).get("k"), new Set([1]).has(1));
@@ -0,0 +1,59 @@
+console.log("--- Numeric Inference ---");
+
+let sum = 0;
+for (let i = 0; i < 10; i++) {
+  sum += i * 2;
+}
+console.log("Sum:", sum);
+
+let x = 7;
+x -= 2;
+x *= 3;
+x /= 2;
+x %= 4;
+x **= 2;
+console.log("Compound:", x);
+
+let bits = 0xff;
+bits <<= 4;
+bits >>= 2;
+bits |= 1;
+bits &= 0x3f;
+bits ^= 5;
+bits >>>= 1;
+console.log("Bitwise:", bits);
+
+const big = 4294967296 + 5;
+console.log("Wrap:", big | 0, (big + 2147483648) | 0, -1 >>> 0, ~big);
+
+const items = [10, 20, 30, 40];
+let total = 0;
+let idx = items.length - 1;
+while (idx >= 0) {
+  total = total + items[idx];
+  idx--;
+}
+console.log("Total:", total, "Index:", idx);
+
+function fib(n) {
+  if (n < 2) return n;
+  return fib(n - 1) + fib(n - 2);
+}
+console.log("Fib:", fib(20));
+
+function scale(value, factor) {
+  return value * factor;
+}
+console.log("Scale:", scale("3", 4), scale(2.5, 4));
+
+let avg = 0;
+avg = (1 + 2 + 3) / 3;
+const half = avg / 2;
+console.log("Average:", avg, "Half:", half, typeof half);
+console.log(`Template: ${half + 1}`);
+
+let counter = 0;
+do {
+  counter += 3;
+} while (counter < 10);
+console.log("Counter:", counter, counter > 5 ? "big" : "small");
@@ -0,0 +1,33 @@
+console.log("--- Object Dictionary Mode ---");
+
+const counts = {};
+const words = [];
+for (let i = 0; i < 500; i++) {
+  words.push("w" + (i % 200));
+}
+for (const word of words) {
+  counts[word] = (counts[word] || 0) + 1;
+}
+console.log("Keys:", Object.keys(counts).length);
+console.log("w0:", counts.w0, "w199:", counts["w199"]);
+
+for (let i = 0; i < 200; i += 2) {
+  delete counts["w" + i];
+}
+console.log("After delete:", Object.keys(counts).length);
+console.log("Deleted:", counts.w0, "w0" in counts, Object.hasOwn(counts, "w0"));
+console.log("Kept:", counts.w1, "w1" in counts);
+
+counts.w0 = "back";
+const keys = Object.keys(counts);
+console.log("Re-added last:", keys[keys.length - 1], counts.w0);
+
+const small = { a: 1, b: 2, c: 3 };
+delete small.b;
+small.d = 4;
+small.b = 5;
+let order = "";
+for (const k in small) {
+  order += k;
+}
+console.log("Order:", order, small.b);
@@ -0,0 +1,46 @@
+// Named access sites share interned keys with computed and dynamic access
+const wide = {};
+const names = ["a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l"];
+for (let n = 0; n < names.length; n++) {
+    wide[names[n]] = n;
+}
+console.log(wide.a, wide.h, wide.i, wide.l);
+
+wide.k = 100;
+console.log(wide["k"], wide.k);
+
+// A name that only ever appears as a computed key
+const dynamic = "dyn" + "amic";
+wide[dynamic] = "yes";
+console.log(wide.dynamic, wide["dyn" + "amic"]);
+console.log(wide.missing);
+
+// The same key on differently shaped objects
+const first = { x: 1, y: 2 };
+const second = { y: 3, x: 4 };
+let total = 0;
+for (const o of [first, second, first, second]) {
+    total += o.x * 10 + o.y;
+}
+console.log(total);
+
+const methods = {
+    count: 0,
+    bump() {
+        this.count++;
+        return this.count;
+    },
+};
+methods.bump();
+console.log(methods.bump(), methods.count);
+
+// Many computed keys turn the object into a dictionary without losing order
+const table = {};
+for (let n = 0; n < 40; n++) {
+    table["entry" + n] = n * 2;
+}
+console.log(table.entry3, table["entry" + 39], Object.keys(table).length);
+delete table.entry10;
+table.extra = "last";
+const tableKeys = Object.keys(table);
+console.log(tableKeys[9], tableKeys[10], tableKeys[tableKeys.length - 1], table.entry10);
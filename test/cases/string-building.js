@@ -0,0 +1,38 @@
+// Appending in a loop builds the string lazily; reading it flattens once
+let csv = "id,name\n";
+for (let i = 0; i < 2000; i++) {
+    csv += i + ",row" + i + "\n";
+}
+console.log(csv.length);
+console.log(csv.slice(0, 20));
+console.log(csv[csv.length - 2], csv.endsWith("1999,row1999\n"));
+
+// Reads interleaved with appends
+let log = "";
+for (let i = 0; i < 300; i++) {
+    log += "entry " + i + ";";
+    if (log.length % 7 === 0) log.charAt(log.length - 1);
+}
+console.log(log.length, log.indexOf("entry 299;"));
+
+// Concatenated strings compare by content
+const left = "x".repeat(50);
+const a = left + left;
+const b = "x".repeat(100);
+console.log(a === b, a.length, a + "" === b + "");
+
+const counts = new Map();
+counts.set(a, 1);
+console.log(counts.get(b));
+
+// Template literals with mixed substitutions
+const user = { name: "Ada" };
+const n = 3;
+console.log(`${user.name} has ${n} items, ${n > 2 ? "many" : "few"}; ${null} ${undefined} ${true}`);
+console.log(`${n}`, `${""}${"only"}`, `start-${n}-end`);
+
+let report = "";
+for (let row = 0; row < 3; row++) {
+    report += `| ${row} | ${"#".repeat(row + 1)} |\n`;
+}
+console.log(report.trimEnd());
@@ -0,0 +1,29 @@
+// A character-at-a-time tokenizer: every character read is a one-byte string
+const source = "let x = 42 + y1;";
+const tokens = [];
+let current = "";
+for (let i = 0; i < source.length; i++) {
+    const ch = source[i];
+    if (ch === " " || ch === ";" || ch === "+" || ch === "=") {
+        if (current !== "") tokens.push(current);
+        if (ch !== " ") tokens.push(ch);
+        current = "";
+    } else {
+        current += ch;
+    }
+}
+console.log(tokens.join("|"));
+
+// charAt, indexing past the end, split("") and for...of agree
+const word = "héllo";
+console.log(word.charAt(0), word.charAt(99) === "", word[99]);
+console.log("abc".split("").join(","), [..."abc"].length);
+const seen = [];
+for (const c of "añb") seen.push(c);
+console.log(seen.join(" "), seen.length);
+
+// Equal one-character and empty strings are interchangeable
+console.log("a" === "abc"[0], "".length, "x".slice(1) === "", "z".concat("") === "z");
+const counts = {};
+for (const c of "mississippi") counts[c] = (counts[c] || 0) + 1;
+console.log(JSON.stringify(counts));
@@ -0,0 +1,25 @@
+console.log("--- String Literals ---");
+
+const tags = [];
+for (let i = 0; i < 3; i++) {
+  tags.push("tag");
+}
+console.log("Same literal:", tags[0] === tags[1], tags[1] === "tag");
+
+const built = "ta" + "g";
+console.log("Built equals literal:", built === "tag", built == "tag");
+
+let line = "";
+for (let i = 0; i < 3; i++) {
+  line += `[${i}]` + "-";
+}
+console.log("Template:", line);
+
+const key = "name";
+const obj = { name: "x" };
+delete obj.name;
+console.log("Deleted:", obj[key], "name" in obj);
+
+let s = "abc";
+s += "def";
+console.log("Unchanged literal:", "abc", s);
@@ -0,0 +1,82 @@
+// Hoisted functions that only run after the binding is initialized
+function describe() {
+    return `${label}: ${limit}`;
+}
+const label = "limit";
+let limit = 3;
+console.log(describe());
+
+function outer() {
+    return inner() * 2;
+}
+function inner() {
+    return base + 1;
+}
+const base = 20;
+console.log(outer());
+
+// Closures created before the declaration but called after it
+const readLater = () => late;
+let late = "late value";
+console.log(readLater());
+
+// A hoisted function called too early still throws
+function early() {
+    return tooSoon;
+}
+try {
+    early();
+} catch (e) {
+    console.log(e.name, e.message);
+}
+let tooSoon = 1;
+console.log(early());
+
+// Each loop iteration has a fresh binding that is initialized before use
+for (let i = 0; i < 2; i++) {
+    const show = () => `${i}:${step}`;
+    const step = i * 5;
+    console.log(show());
+}
+
+// A block-scoped name of the same spelling proves nothing about the outer binding
+function shadowed() {
+    {
+        let x = 1;
+        console.log("inner", x);
+    }
+    read();
+    let x = 2;
+    function read() {
+        return x;
+    }
+}
+try {
+    shadowed();
+} catch (e) {
+    console.log(e.name, e.message);
+}
+
+// A closure created inside a hoisted function runs as early as that function is called
+try {
+    viaClosure();
+} catch (e) {
+    console.log(e.name, e.message);
+}
+let captured = "captured";
+function viaClosure() {
+    return (() => captured)();
+}
+console.log(viaClosure());
+
+// So does a method defined inside one
+try {
+    viaMethod();
+} catch (e) {
+    console.log(e.name, e.message);
+}
+let fromMethod = "from method";
+function viaMethod() {
+    return { read() { return fromMethod; } }.read();
+}
+console.log(viaMethod());
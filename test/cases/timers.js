@@ -14,4 +14,19 @@ const id = setInterval(() => {
     clearInterval(id);
 }, 75);
 
+// Delays above 2^31 - 1, negative or NaN run after 1 ms
+setTimeout(() => {
+    console.log("timeout 1e11ms");
+}, 1e11);
+
+setTimeout(() => {
+    console.log("timeout -5ms");
+}, -5);
+
+// A timer never fires before its full delay has elapsed
+const scheduledAt = performance.now();
+setTimeout(() => {
+    console.log("waited 30ms:", performance.now() - scheduledAt >= 30);
+}, 30);
+
 console.log("end");